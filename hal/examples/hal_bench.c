@@ -0,0 +1,609 @@
+/**
+ * @file hal_bench.c
+ * @brief HAL micro-benchmarks with machine-readable output
+ *
+ * Times the hot paths of the HAL and prints one JSON document on stdout,
+ * so runs on the board can be archived and compared between builds:
+ *
+ * - LCD clear, fill-rect, set_pixel, blit and blend, with the scalar and
+ *   the NEON kernels
+ * - LCD swap latency, with the frame statistics collected meanwhile
+ * - Touch decode throughput over an evdev stream, either a capture
+ *   recorded on the target (`input_capture record touch.cap`) or a
+ *   synthetic two-finger drag
+ * - LED set cost through the cached sysfs brightness descriptor
+ *
+ * Each benchmark is calibrated to batches of at least BENCH_SAMPLE_NS,
+ * then sampled until the minimum time is reached. Times come from
+ * CLOCK_MONOTONIC_RAW, cycles from a perf_event_open() counter when the
+ * kernel allows one (null otherwise). HAL messages are kept off stdout.
+ *
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "../include/hal.h"
+#include "../src/hal/touch_capture.h"
+#include "../src/hal/touch_decoder.h"
+#include <fnmatch.h>
+#include <getopt.h>
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Sampling */
+#define BENCH_SAMPLE_NS         1000000     /* Shortest batch, keeps clock and counter reads negligible */
+#define BENCH_MIN_SAMPLES       5
+#define BENCH_MAX_SAMPLES       1024
+#define BENCH_MAX_BATCH         (1u << 24)
+#define BENCH_DEFAULT_MIN_MS    200
+
+/* Workloads */
+#define BENCH_SPRITE_SIZE       64
+#define BENCH_STREAM_REPORTS    4096        /* Synthetic touch stream length */
+#define BENCH_STREAM_STROKE     256         /* Reports per synthetic press-drag-release */
+#define BENCH_MAX_STREAM_EVENTS (1u << 20)
+#define BENCH_LCD_OPS           6
+
+typedef struct {
+    const char *name;
+    void (*op)(uint32_t i);     /* One operation, i counts up within a run */
+    double bytes;               /* Bytes written per operation, 0 for none */
+    double items;               /* Items per operation for items_per_second, 0 for none */
+    void (*extra)(char *buf, size_t len);   /* Extra JSON members after the run, or NULL */
+} bench_t;
+
+typedef struct {
+    uint64_t iterations;
+    uint32_t samples;
+    double min_ns, median_ns, mean_ns, max_ns;
+    double cycles;              /* Per operation, < 0 without a counter */
+} bench_result_t;
+
+static void usage(const char *prog);
+static void cycles_open(void);
+static bool cycles_read(uint64_t *value);
+static void bench_run(const bench_t *b, bench_result_t *r);
+static bool bench_report(const bench_t *b);
+static void json_skip(const char *name, const char *reason);
+static void bench_lcd(bool available);
+static bool load_stream(const char *path);
+static void make_stream(void);
+static void setup_decoder(void);
+static void bench_touch(void);
+static void bench_led(void);
+
+/* Options */
+static const char *filter = "*";
+static uint32_t min_time_ms = BENCH_DEFAULT_MIN_MS;
+
+/* Shared state of the operations */
+static int cycles_fd = -1;
+static const char *cycles_scope = NULL;     /* "user+kernel", "user" or NULL */
+static hal_lcd_fb_t fb;
+static uint32_t sprite[BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE];
+static touch_decoder_t decoder;
+static struct input_event *stream;
+static uint32_t stream_len;
+static uint32_t stream_reports;
+static struct input_absinfo stream_abs[ABS_CNT];
+static bool first_result = true;
+
+static const char *lcd_ops[BENCH_LCD_OPS] = {
+    "lcd_clear", "lcd_fill_rect_100x100", "lcd_fill_rect_400x600",
+    "lcd_set_pixel", "lcd_blit_64x64", "lcd_blend_64x64"
+};
+static const char *lcd_kernels[] = { "scalar", "neon" };
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/*=============================================================================
+ * Cycle counter
+ *============================================================================*/
+
+/* User and kernel cycles if allowed (swap and LED costs are mostly kernel), else user only */
+static void cycles_open(void)
+{
+    struct perf_event_attr attr;
+
+    for (int user_only = 0; user_only < 2 && cycles_fd < 0; user_only++) {
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        attr.exclude_kernel = (uint64_t)user_only;
+        attr.exclude_hv = 1;
+        cycles_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+        if (cycles_fd >= 0) {
+            cycles_scope = user_only ? "user" : "user+kernel";
+        }
+    }
+}
+
+static bool cycles_read(uint64_t *value)
+{
+    return cycles_fd >= 0 && read(cycles_fd, value, sizeof(*value)) == (ssize_t)sizeof(*value);
+}
+
+/*=============================================================================
+ * Harness
+ *============================================================================*/
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t run_batch(const bench_t *b, uint32_t batch, uint32_t *counter)
+{
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < batch; i++) {
+        b->op((*counter)++);
+    }
+    return now_ns() - start;
+}
+
+static void bench_run(const bench_t *b, bench_result_t *r)
+{
+    static double per_op[BENCH_MAX_SAMPLES];
+    uint64_t budget = (uint64_t)min_time_ms * 1000000ull;
+    uint64_t elapsed = 0, cycles_total = 0;
+    uint32_t counter = 0, batch = 1;
+    bool cycles_valid = cycles_fd >= 0;
+    double sum = 0;
+
+    /* Calibrate, which also warms the caches and the kernel paths */
+    while (run_batch(b, batch, &counter) < BENCH_SAMPLE_NS && batch < BENCH_MAX_BATCH) {
+        batch *= 2;
+    }
+
+    memset(r, 0, sizeof(*r));
+    while (r->samples < BENCH_MAX_SAMPLES &&
+           (elapsed < budget || r->samples < BENCH_MIN_SAMPLES)) {
+        uint64_t c0 = 0, c1 = 0;
+
+        cycles_valid = cycles_read(&c0) && cycles_valid;
+        uint64_t ns = run_batch(b, batch, &counter);
+        cycles_valid = cycles_read(&c1) && cycles_valid;
+
+        cycles_total += c1 - c0;
+        elapsed += ns;
+        per_op[r->samples] = (double)ns / batch;
+        sum += per_op[r->samples];
+        r->samples++;
+    }
+
+    r->iterations = (uint64_t)r->samples * batch;
+    r->mean_ns = sum / r->samples;
+    r->cycles = cycles_valid ? (double)cycles_total / r->iterations : -1.0;
+
+    qsort(per_op, r->samples, sizeof(per_op[0]), compare_double);
+    r->min_ns = per_op[0];
+    r->max_ns = per_op[r->samples - 1];
+    r->median_ns = (r->samples & 1) ? per_op[r->samples / 2] :
+                   (per_op[r->samples / 2 - 1] + per_op[r->samples / 2]) / 2;
+}
+
+static bool selected(const char *name)
+{
+    return fnmatch(filter, name, 0) == 0;
+}
+
+static void json_begin(const char *name)
+{
+    printf("%s\n    { \"name\": \"%s\"", first_result ? "" : ",", name);
+    first_result = false;
+}
+
+static void json_skip(const char *name, const char *reason)
+{
+    if (selected(name)) {
+        json_begin(name);
+        printf(", \"skipped\": \"%s\" }", reason);
+    }
+}
+
+/* Run a benchmark if it passes the filter and print its JSON object */
+static bool bench_report(const bench_t *b)
+{
+    bench_result_t r;
+    char extra[256] = "";
+
+    if (!selected(b->name)) {
+        return false;
+    }
+    bench_run(b, &r);
+    if (b->extra != NULL) {
+        b->extra(extra, sizeof(extra));
+    }
+
+    json_begin(b->name);
+    printf(", \"iterations\": %llu, \"samples\": %u,\n"
+           "      \"ns_per_op\": { \"min\": %.1f, \"median\": %.1f, \"mean\": %.1f, \"max\": %.1f },\n"
+           "      \"cycles_per_op\": ",
+           (unsigned long long)r.iterations, r.samples, r.min_ns, r.median_ns, r.mean_ns, r.max_ns);
+    if (r.cycles >= 0) {
+        printf("%.1f", r.cycles);
+    } else {
+        printf("null");
+    }
+    if (b->bytes > 0) {
+        printf(", \"bytes_per_second\": %.0f", b->bytes * 1e9 / r.median_ns);
+    }
+    if (b->items > 0) {
+        printf(", \"items_per_second\": %.0f", b->items * 1e9 / r.median_ns);
+    }
+    printf("%s }", extra);
+    fflush(stdout);
+    return true;
+}
+
+/*=============================================================================
+ * LCD
+ *============================================================================*/
+
+static const hal_lcd_rect_t small_rect = {40, 100, 100, 100};
+static const hal_lcd_rect_t large_rect = {40, 100, 400, 600};
+
+static void op_clear(uint32_t i)
+{
+    hal_lcd_clear((i & 1) ? LCD_COLOR_RED : LCD_COLOR_BLUE);
+}
+
+static void op_fill_small(uint32_t i)
+{
+    hal_lcd_draw_rectangle(small_rect, (i & 1) ? LCD_COLOR_GREEN : LCD_COLOR_YELLOW, true);
+}
+
+static void op_fill_large(uint32_t i)
+{
+    hal_lcd_draw_rectangle(large_rect, (i & 1) ? LCD_COLOR_GREEN : LCD_COLOR_YELLOW, true);
+}
+
+/* Scattered over the screen, consecutive pixels rarely share a cache line */
+static void op_set_pixel(uint32_t i)
+{
+    uint32_t n = i * 2654435761u;
+    hal_lcd_set_pixel((uint16_t)((n >> 8) % fb.width), (uint16_t)((n >> 20) % fb.height), n | 0xFF000000);
+}
+
+static hal_lcd_rect_t sprite_rect(uint32_t i)
+{
+    hal_lcd_rect_t rect = {
+        (uint16_t)((i * 37) % (fb.width - BENCH_SPRITE_SIZE)),
+        (uint16_t)((i * 53) % (fb.height - BENCH_SPRITE_SIZE)),
+        BENCH_SPRITE_SIZE, BENCH_SPRITE_SIZE
+    };
+    return rect;
+}
+
+static void op_blit(uint32_t i)
+{
+    hal_lcd_blit(sprite_rect(i), sprite, BENCH_SPRITE_SIZE * sizeof(uint32_t));
+}
+
+static void op_blend(uint32_t i)
+{
+    hal_lcd_blend_rect(sprite_rect(i), sprite, BENCH_SPRITE_SIZE * sizeof(uint32_t));
+}
+
+/* A small damaged area and the swap, as an animated UI does per frame */
+static void op_swap(uint32_t i)
+{
+    op_fill_small(i);
+    hal_lcd_swap();
+}
+
+static void swap_extra(char *buf, size_t len)
+{
+    hal_lcd_stats_t stats;
+
+    if (hal_lcd_get_stats(&stats) != HAL_LCD_OK) {
+        return;
+    }
+    snprintf(buf, len,
+             ",\n      \"frames\": %u, \"missed_vblanks\": %u, \"swap_us_avg\": %u, "
+             "\"latency_us_avg\": %u, \"latency_us_max\": %u",
+             stats.frames, stats.missed_vblanks, stats.swap_us.avg,
+             stats.latency_us.avg, stats.latency_us.max);
+}
+
+static void make_sprite(void)
+{
+    for (int y = 0; y < BENCH_SPRITE_SIZE; y++) {
+        for (int x = 0; x < BENCH_SPRITE_SIZE; x++) {
+            /* Alpha ramps across, so blending sees clear, partial and opaque pixels */
+            uint32_t alpha = (uint32_t)(x * 255 / (BENCH_SPRITE_SIZE - 1));
+            sprite[y * BENCH_SPRITE_SIZE + x] = (alpha << 24) | ((uint32_t)(y * 4) << 16) | 0x8040;
+        }
+    }
+}
+
+static void bench_lcd(bool available)
+{
+    void (*const ops[BENCH_LCD_OPS])(uint32_t) = {
+        op_clear, op_fill_small, op_fill_large, op_set_pixel, op_blit, op_blend
+    };
+    double bpp = fb.bpp / 8.0;
+    const double bytes[BENCH_LCD_OPS] = {
+        (double)fb.pitch * fb.height,
+        small_rect.width * small_rect.height * bpp,
+        large_rect.width * large_rect.height * bpp,
+        0,
+        BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE * bpp,
+        BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE * bpp
+    };
+
+    for (int k = 0; k < (int)(sizeof(lcd_kernels) / sizeof(lcd_kernels[0])); k++) {
+        bool usable = available && hal_lcd_set_neon(k == 1) == HAL_LCD_OK;
+
+        for (int n = 0; n < BENCH_LCD_OPS; n++) {
+            char name[48];
+            snprintf(name, sizeof(name), "%s/%s", lcd_ops[n], lcd_kernels[k]);
+
+            if (!usable) {
+                json_skip(name, available ? "kernel not available on this CPU" : "no display");
+                continue;
+            }
+            bench_t b = { name, ops[n], bytes[n], bytes[n] > 0 ? 0 : 1, NULL };
+            bench_report(&b);
+        }
+    }
+
+    if (!available) {
+        json_skip("lcd_swap", "no display");
+        return;
+    }
+
+    /* Back to the automatic selection, statistics cover only the swap run */
+    hal_lcd_set_neon(true);
+    hal_lcd_reset_stats();
+
+    const bench_t swap = { "lcd_swap", op_swap, 0, 0, swap_extra };
+    bench_report(&swap);
+}
+
+/*=============================================================================
+ * Touch decode
+ *============================================================================*/
+
+static void op_decode(uint32_t i)
+{
+    touch_decoder_feed(&decoder, &stream[i % stream_len]);
+}
+
+static void decode_extra(char *buf, size_t len)
+{
+    snprintf(buf, len, ",\n      \"stream_events\": %u, \"stream_reports\": %u, \"reports_per_event\": %.3f",
+             stream_len, stream_reports, (double)stream_reports / stream_len);
+}
+
+/* A touch capture from input_capture or hal_touch_set_record(), axis ranges included */
+static bool load_stream(const char *path)
+{
+    touch_capture_header_t header;
+    touch_capture_event_t records[64];
+    uint32_t capacity = 0;
+    int fd = touch_capture_open(path, &header);
+    int count;
+
+    if (fd < 0) {
+        fprintf(stderr, "Error: %s is not a touch capture\n", path);
+        return false;
+    }
+
+    while ((count = touch_capture_read(fd, records, 64)) > 0 && stream_len < BENCH_MAX_STREAM_EVENTS) {
+        if (stream_len + (uint32_t)count > capacity) {
+            capacity = capacity ? capacity * 2 : 4096;
+            struct input_event *grown = realloc(stream, capacity * sizeof(*stream));
+            if (grown == NULL) {
+                break;
+            }
+            stream = grown;
+        }
+        for (int i = 0; i < count; i++) {
+            touch_capture_to_event(header.start_us, &records[i], &stream[stream_len++]);
+        }
+    }
+    close(fd);
+
+    if (stream_len == 0) {
+        fprintf(stderr, "Error: %s holds no input events\n", path);
+        return false;
+    }
+    memcpy(stream_abs, header.abs, sizeof(stream_abs));
+    return true;
+}
+
+static void push_event(uint16_t type, uint16_t code, int32_t value)
+{
+    struct input_event *ev = &stream[stream_len++];
+    memset(ev, 0, sizeof(*ev));
+    ev->type = type;
+    ev->code = code;
+    ev->value = value;
+}
+
+/* Two contacts dragging in opposite directions, lifted every BENCH_STREAM_STROKE reports */
+static void make_stream(void)
+{
+    /* A two-slot 12-bit panel, like the FT6236 */
+    stream_abs[ABS_MT_SLOT].maximum = 1;
+    stream_abs[ABS_MT_POSITION_X].maximum = 4095;
+    stream_abs[ABS_MT_POSITION_Y].maximum = 4095;
+    stream_abs[ABS_MT_PRESSURE].maximum = 255;
+
+    stream = calloc(BENCH_STREAM_REPORTS * 12, sizeof(struct input_event));
+    if (stream == NULL) {
+        return;
+    }
+
+    for (int r = 0; r < BENCH_STREAM_REPORTS; r++) {
+        int step = r % BENCH_STREAM_STROKE;
+        int stroke = r / BENCH_STREAM_STROKE;
+
+        for (int slot = 0; slot < 2; slot++) {
+            int32_t x = slot ? 4000 - step * 15 : 100 + step * 15;
+            int32_t y = 1000 + slot * 2000 + step * 3;
+
+            push_event(EV_ABS, ABS_MT_SLOT, slot);
+            if (step == 0) {
+                push_event(EV_ABS, ABS_MT_TRACKING_ID, stroke * 2 + slot);
+            } else if (step == BENCH_STREAM_STROKE - 1) {
+                push_event(EV_ABS, ABS_MT_TRACKING_ID, -1);
+                continue;
+            }
+            push_event(EV_ABS, ABS_MT_POSITION_X, x);
+            push_event(EV_ABS, ABS_MT_POSITION_Y, y);
+            push_event(EV_ABS, ABS_MT_PRESSURE, 40 + step % 16);
+        }
+        push_event(EV_SYN, SYN_REPORT, 0);
+    }
+}
+
+/* Replay never resyncs from a device, the ranges come with the stream */
+static void setup_decoder(void)
+{
+    touch_decoder_init_axes(&decoder, -1, stream_abs,
+                            fb.width ? fb.width : LCD_WIDTH, fb.height ? fb.height : LCD_HEIGHT);
+
+    for (uint32_t i = 0; i < stream_len; i++) {
+        if (stream[i].type == EV_SYN && stream[i].code == SYN_REPORT) {
+            stream_reports++;
+        }
+    }
+}
+
+static void bench_touch(void)
+{
+    if (stream_len == 0) {
+        json_skip("touch_decode", "no input stream");
+        return;
+    }
+    const bench_t b = { "touch_decode", op_decode, 0, 1, decode_extra };
+    bench_report(&b);
+}
+
+/*=============================================================================
+ * LED
+ *============================================================================*/
+
+static void op_led(uint32_t i)
+{
+    hal_led_set_state(HAL_LED_GREEN, (i & 1) ? HAL_LED_ON : HAL_LED_OFF);
+}
+
+static void bench_led(void)
+{
+    if (!selected("led_set")) {
+        return;
+    }
+    if (hal_led_init() != HAL_OK || hal_led_set_state(HAL_LED_GREEN, HAL_LED_OFF) != HAL_OK) {
+        json_skip("led_set", "LED not available");
+        return;
+    }
+
+    const bench_t b = { "led_set", op_led, 0, 0, NULL };
+    bench_report(&b);
+    hal_led_set_state(HAL_LED_GREEN, HAL_LED_OFF);
+    hal_led_deinit();
+}
+
+/*=============================================================================
+ * Main
+ *============================================================================*/
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-f pattern] [-t min_ms] [-s capture]\n", prog);
+    fprintf(stderr, "  -f pattern  Only run benchmarks matching the glob, e.g. 'lcd_*/neon'\n");
+    fprintf(stderr, "  -t min_ms   Minimum sampling time per benchmark (default %d)\n", BENCH_DEFAULT_MIN_MS);
+    fprintf(stderr, "  -s capture  Touch capture for touch_decode (default synthetic)\n");
+    fprintf(stderr, "JSON goes to stdout, e.g. %s > bench.json\n", prog);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *stream_path = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:t:s:h")) != -1) {
+        switch (opt) {
+        case 'f':
+            filter = optarg;
+            break;
+        case 't':
+            min_time_ms = (uint32_t)strtoul(optarg, NULL, 10);
+            break;
+        case 's':
+            stream_path = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    /* stdout carries only the JSON document */
+    hal_log_set_stdout(false);
+
+    bool lcd = hal_lcd_init() == HAL_LCD_OK && hal_lcd_get_framebuffer(&fb) == HAL_LCD_OK;
+    if (stream_path != NULL) {
+        if (!load_stream(stream_path)) {
+            return EXIT_FAILURE;
+        }
+    } else {
+        make_stream();
+    }
+    setup_decoder();
+    make_sprite();
+    cycles_open();
+
+    char date[32];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    printf("{\n  \"context\": {\n");
+    printf("    \"date\": \"%s\", \"hal_version\": \"%s\",\n", date, hal_get_version());
+    printf("    \"clock\": \"CLOCK_MONOTONIC_RAW\", \"cycle_counter\": ");
+    if (cycles_scope != NULL) {
+        printf("\"%s\"", cycles_scope);
+    } else {
+        printf("null");
+    }
+    printf(", \"min_time_ms\": %u,\n", min_time_ms);
+    if (lcd) {
+        printf("    \"display\": { \"width\": %u, \"height\": %u, \"bpp\": %u, \"pitch\": %u },\n",
+               fb.width, fb.height, fb.bpp, fb.pitch);
+    } else {
+        printf("    \"display\": null,\n");
+    }
+    printf("    \"touch_stream\": \"%s\"\n  },\n", stream_path ? stream_path : "synthetic");
+    printf("  \"benchmarks\": [");
+
+    bench_lcd(lcd);
+    bench_touch();
+    bench_led();
+
+    printf("\n  ]\n}\n");
+
+    if (lcd) {
+        hal_lcd_deinit();
+    }
+    if (cycles_fd >= 0) {
+        close(cycles_fd);
+    }
+    free(stream);
+    return EXIT_SUCCESS;
+}
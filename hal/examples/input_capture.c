@@ -0,0 +1,158 @@
+/**
+ * @file input_capture.c
+ * @brief Record touch input on the board, replay it anywhere
+ *
+ * record: decodes the live touchscreen through the HAL and writes every
+ * raw event to a capture file (hal_touch_set_record()).
+ *
+ * replay: feeds a capture back through the HAL (hal_touch_set_replay())
+ * and prints each decoded frame and gesture, one line each, so two builds
+ * can be compared with diff. Events keep their recorded timestamps, so
+ * the output is the same at any speed as long as no frame overflows the
+ * queue (reported at the end).
+ *
+ * Sensor samples are recorded by the sensor demo with SENSOR_LOG_DIR and
+ * replayed with SENSOR_REPLAY, see qt-sensor-demo/data-provider.h.
+ *
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "../include/hal.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static const char *gesture_names[] = {
+    "none", "tap", "long-press", "drag", "drag-end", "swipe", "pinch", "pinch-end"
+};
+
+static void handle_signal(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void print_frame(const hal_touch_data_t *frame)
+{
+    static const char events[] = "-prm";
+
+    printf("%10u frame %u", frame->timestamp, frame->count);
+    for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
+        const hal_touch_point_t *p = &frame->points[i];
+        if (p->valid || p->event == HAL_TOUCH_EVENT_RELEASE) {
+            printf(" %u%c%u,%u", p->id, events[p->event], p->x, p->y);
+        }
+    }
+    printf("\n");
+}
+
+static void print_gestures(void)
+{
+    hal_gesture_t gestures[16];
+    int count;
+
+    while ((count = hal_touch_pop_gestures(gestures, 16)) > 0) {
+        for (int i = 0; i < count; i++) {
+            const hal_gesture_t *g = &gestures[i];
+            printf("%10u gesture %s %u,%u d=%d,%d v=%.0f,%.0f s=%.2f\n", g->timestamp,
+                   gesture_names[g->type], g->x, g->y, g->dx, g->dy, g->vx, g->vy, g->scale);
+        }
+    }
+}
+
+/* Drain queued frames until input ends, Ctrl+C or the time limit */
+static int run(bool replay, double seconds)
+{
+    hal_touch_data_t frames[32];
+    uint32_t total = 0;
+    double start = now_s();
+
+    while (!stop_requested && (seconds <= 0 || now_s() - start < seconds)) {
+        hal_touch_status_t status = hal_touch_wait(200);
+
+        /*
+         * Frames still queued when input ends are printed before stopping.
+         * A replay takes one frame at a time so each is followed by its
+         * gestures, whatever the batching.
+         */
+        int count;
+        while ((count = hal_touch_pop_events(frames, replay ? 1 : 32)) > 0) {
+            if (replay) {
+                print_frame(&frames[0]);
+                print_gestures();
+            }
+            total += (uint32_t)count;
+        }
+        if (status == HAL_TOUCH_ERROR) {
+            break;
+        }
+    }
+
+    fprintf(stderr, "%u frames in %.1f s, %u dropped\n", total, now_s() - start,
+            hal_touch_get_overflow_count());
+    return EXIT_SUCCESS;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s record <file> [seconds]\n", prog);
+    fprintf(stderr, "       %s replay <file> [speed]\n", prog);
+    fprintf(stderr, "  record  Capture the touchscreen until Ctrl+C or the time limit\n");
+    fprintf(stderr, "  replay  Print decoded frames and gestures, speed 1 = as recorded, 0 = no delays\n");
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bool replay = strcmp(argv[1], "replay") == 0;
+    if (!replay && strcmp(argv[1], "record") != 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    hal_touch_status_t status;
+    if (replay) {
+        /* stdout carries only frames and gestures */
+        hal_log_set_stdout(false);
+        status = hal_touch_set_replay(argv[2], argc > 3 ? (float)atof(argv[3]) : 1.0f);
+    } else {
+        status = hal_touch_set_record(argv[2]);
+    }
+    if (status != HAL_TOUCH_OK || hal_touch_set_threaded(true) != HAL_TOUCH_OK) {
+        fprintf(stderr, "Error: invalid capture path or speed\n");
+        return EXIT_FAILURE;
+    }
+
+    if (hal_touch_init() != HAL_TOUCH_OK) {
+        fprintf(stderr, "Error: failed to initialize touch input\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!replay) {
+        fprintf(stderr, "Recording to %s, Ctrl+C to stop\n", argv[2]);
+    }
+    int ret = run(replay, !replay && argc > 3 ? atof(argv[3]) : 0);
+
+    hal_touch_deinit();
+    return ret;
+}
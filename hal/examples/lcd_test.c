@@ -1,3 +1,4 @@
+#define _GNU_SOURCE
 #include "../include/hal.h"
 #include <stdio.h>
 #include <unistd.h>
@@ -27,6 +28,9 @@ static void test_rectangles(void);
 static void test_gradients(void);
 static void test_patterns(void);
 static void test_performance(void);
+static void test_benchmark(void);
+static void test_layers(void);
+static void test_coldstart(void);
 static void draw_gradient_horizontal(uint32_t color1, uint32_t color2);
 static void draw_gradient_vertical(uint32_t color1, uint32_t color2);
 static void draw_checkerboard(uint32_t color1, uint32_t color2, int size);
@@ -60,6 +64,7 @@ static void test_basic_colors(void)
     for (int i = 0; i < sizeof(colors)/sizeof(colors[0]); i++) {
         printf("Displaying %s (0x%08X)...\n", colors[i].name, colors[i].color);
         hal_lcd_clear(colors[i].color);
+        hal_lcd_swap();
         sleep(1);
     }
 }
@@ -95,6 +100,7 @@ static void test_pixel_drawing(void)
     }
     
     printf("Pixel test complete. Press any key to continue...\n");
+    hal_lcd_swap();
     sleep(3);
 }
 
@@ -117,6 +123,7 @@ static void test_rectangles(void)
     hal_lcd_rect_t rect3 = {100, 250, 80, 60};
     hal_lcd_draw_rectangle(rect3, TEST_BLUE, true);
     
+    hal_lcd_swap();
     sleep(2);
     
     /* Test outlined rectangles */
@@ -144,6 +151,7 @@ static void test_rectangles(void)
         hal_lcd_draw_rectangle(nested, color, false);
     }
     
+    hal_lcd_swap();
     sleep(3);
 }
 
@@ -154,14 +162,17 @@ static void test_gradients(void)
     
     printf("Horizontal red to blue gradient...\n");
     draw_gradient_horizontal(TEST_RED, TEST_BLUE);
+    hal_lcd_swap();
     sleep(2);
     
     printf("Vertical green to yellow gradient...\n");
     draw_gradient_vertical(TEST_GREEN, TEST_YELLOW);
+    hal_lcd_swap();
     sleep(2);
     
     printf("Horizontal black to white gradient...\n");
     draw_gradient_horizontal(TEST_BLACK, TEST_WHITE);
+    hal_lcd_swap();
     sleep(2);
 }
 
@@ -172,18 +183,22 @@ static void test_patterns(void)
     
     printf("Drawing checkerboard pattern...\n");
     draw_checkerboard(TEST_RED, TEST_BLUE, 20);
+    hal_lcd_swap();
     sleep(2);
     
     printf("Drawing small checkerboard...\n");
     draw_checkerboard(TEST_GREEN, TEST_MAGENTA, 10);
+    hal_lcd_swap();
     sleep(2);
     
     printf("Drawing color bars...\n");
     draw_color_bars();
+    hal_lcd_swap();
     sleep(2);
     
     printf("Drawing test pattern...\n");
     draw_test_pattern();
+    hal_lcd_swap();
     sleep(3);
 }
 
@@ -219,9 +234,128 @@ static void test_performance(void)
     cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
     printf("Pixel grid drawing took %f seconds\n", cpu_time_used);
     
+    hal_lcd_swap();
     sleep(2);
 }
 
+/* Seconds elapsed since start (monotonic clock) */
+static double elapsed_since(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/* Benchmark clear and fill-rect throughput with scalar and NEON kernels */
+static void test_benchmark(void)
+{
+    printf("\n=== Pixel Kernel Benchmark ===\n");
+
+    const int clear_iterations = 100;
+    const int fill_iterations = 400;
+    const hal_lcd_rect_t fill_rect = {40, 100, 400, 600};
+    const double clear_mb = LCD_BUFFER_SIZE / 1e6;
+    const double fill_mb = fill_rect.width * fill_rect.height * (LCD_BPP / 8) / 1e6;
+    const struct {
+        const char *name;
+        bool neon;
+    } kernels[] = {
+        {"scalar", false},
+        {"neon",   true}
+    };
+
+    for (int k = 0; k < (int)(sizeof(kernels) / sizeof(kernels[0])); k++) {
+        if (hal_lcd_set_neon(kernels[k].neon) != HAL_LCD_OK) {
+            printf("%-6s: not available on this CPU\n", kernels[k].name);
+            continue;
+        }
+
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < clear_iterations; i++) {
+            hal_lcd_clear((i & 1) ? TEST_RED : TEST_BLUE);
+        }
+        double clear_s = elapsed_since(&start);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < fill_iterations; i++) {
+            hal_lcd_draw_rectangle(fill_rect, (i & 1) ? TEST_GREEN : TEST_YELLOW, true);
+        }
+        double fill_s = elapsed_since(&start);
+
+        printf("%-6s: clear %8.1f MB/s (%.3f ms/frame), fill-rect %8.1f MB/s\n",
+               kernels[k].name,
+               clear_mb * clear_iterations / clear_s, clear_s * 1000.0 / clear_iterations,
+               fill_mb * fill_iterations / fill_s);
+    }
+
+    /* Back to the automatic selection */
+    hal_lcd_set_neon(true);
+
+    /* Full frames through the swap chain, timed by the LCD statistics */
+    hal_lcd_reset_stats();
+    for (int i = 0; i < 120; i++) {
+        hal_lcd_clear((i & 1) ? TEST_RED : TEST_BLUE);
+        hal_lcd_swap();
+    }
+
+    hal_lcd_stats_t stats;
+    if (hal_lcd_get_stats(&stats) == HAL_LCD_OK) {
+        printf("frames: %u, missed vblanks: %u\n", stats.frames, stats.missed_vblanks);
+        printf("draw    avg %5u us, max %5u us (CPU)\n", stats.draw_us.avg, stats.draw_us.max);
+        printf("        avg %5u us, max %5u us (wall)\n", stats.draw_wall_us.avg, stats.draw_wall_us.max);
+        printf("swap    avg %5u us, max %5u us\n", stats.swap_us.avg, stats.swap_us.max);
+        printf("latency avg %5u us, max %5u us\n", stats.latency_us.avg, stats.latency_us.max);
+    }
+    sleep(2);
+}
+
+/* Static background, a live bar layer and a cursor overlay on DRM planes */
+static void test_layers(void)
+{
+    printf("\n=== Overlay Layer Test ===\n");
+    printf("Overlay planes: %d\n", hal_lcd_get_layer_count());
+
+    draw_color_bars();
+    hal_lcd_swap();
+
+    hal_lcd_layer_t chart, cursor;
+    const hal_lcd_rect_t chart_rect = {40, 500, 400, 120};
+    if (hal_lcd_layer_create(chart_rect, HAL_LCD_FORMAT_RGB565, &chart) != HAL_LCD_OK) {
+        printf("No plane for the chart layer, skipping\n");
+        return;
+    }
+    bool have_cursor = hal_lcd_layer_create((hal_lcd_rect_t){0, 0, 32, 32},
+                                            HAL_LCD_FORMAT_ARGB8888, &cursor) == HAL_LCD_OK;
+    if (have_cursor) {
+        /* Translucent ring, redrawn once into both buffers, then only moved */
+        for (int b = 0; b < 2; b++) {
+            hal_lcd_layer_fill(cursor, (hal_lcd_rect_t){0, 0, 32, 32}, 0xC0FFFFFF);
+            hal_lcd_layer_fill(cursor, (hal_lcd_rect_t){6, 6, 20, 20}, 0x00000000);
+            hal_lcd_layer_commit(cursor);
+        }
+        hal_lcd_layer_set_zpos(cursor, 2);
+    }
+    hal_lcd_layer_set_zpos(chart, 1);
+
+    for (int frame = 0; frame < 200; frame++) {
+        int level = (frame * 3) % chart_rect.width;
+        hal_lcd_layer_fill(chart, (hal_lcd_rect_t){0, 0, chart_rect.width, chart_rect.height}, TEST_BLACK);
+        hal_lcd_layer_fill(chart, (hal_lcd_rect_t){0, 20, level, 80}, TEST_GREEN);
+        hal_lcd_layer_commit(chart);
+
+        if (have_cursor) {
+            hal_lcd_layer_move(cursor, (frame * 5) % LCD_WIDTH - 16, 200 + (frame % 40) * 5);
+        }
+    }
+
+    if (have_cursor) {
+        hal_lcd_layer_destroy(cursor);
+    }
+    hal_lcd_layer_destroy(chart);
+    sleep(1);
+}
+
 /* Helper function to draw horizontal gradient */
 static void draw_gradient_horizontal(uint32_t color1, uint32_t color2)
 {
@@ -287,6 +421,28 @@ static void draw_color_bars(void)
     }
 }
 
+/* First frame after a fast start, then the phase timings (run twice: cold, then cached) */
+static void test_coldstart(void)
+{
+    hal_lcd_clear(TEST_BLUE);
+    hal_lcd_swap();
+
+    hal_lcd_init_stats_t st;
+    if (hal_lcd_get_init_stats(&st) != HAL_LCD_OK) {
+        return;
+    }
+    printf("\n=== Cold Start (%s) ===\n", st.mode_cached ? "cached mode" : "full probe");
+    printf("open     %6u us\n", st.open_us);
+    printf("probe    %6u us\n", st.probe_us);
+    printf("buffers  %6u us\n", st.buffers_us);
+    printf("planes   %6u us\n", st.planes_us);
+    printf("clear    %6u us\n", st.clear_us);
+    printf("init     %6u us\n", st.total_us);
+    printf("modeset  %6u us (first swap)\n", st.modeset_us);
+    printf("first frame %u us after init entry\n", st.first_frame_us);
+    sleep(1);
+}
+
 /* Helper function to draw test pattern */
 static void draw_test_pattern(void)
 {
@@ -349,6 +505,7 @@ static void interactive_test_menu(void)
     
     while (1) {
         hal_lcd_clear(TEST_BLACK);
+        hal_lcd_swap();
         
         printf("\n=== Interactive LCD Test Menu ===\n");
         printf("1. Basic Colors\n");
@@ -417,8 +574,10 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    /* Initialize LCD */
-    if (hal_lcd_init() != HAL_LCD_OK) {
+    /* Initialize LCD, coldstart measures the fast start path */
+    bool coldstart = (argc > 1 && strcmp(argv[1], "coldstart") == 0);
+    hal_lcd_config_t config = { .fast_start = true };
+    if (hal_lcd_init_ex(coldstart ? &config : NULL) != HAL_LCD_OK) {
         printf("Error: Failed to initialize LCD\n");
         hal_deinit();
         return EXIT_FAILURE;
@@ -439,10 +598,19 @@ int main(int argc, char *argv[]) {
             test_performance();
         } else if (strcmp(argv[1], "interactive") == 0) {
             interactive_test_menu();
+        } else if (strcmp(argv[1], "bench") == 0) {
+            test_benchmark();
+        } else if (strcmp(argv[1], "layers") == 0) {
+            test_layers();
+        } else if (coldstart) {
+            test_coldstart();
         } else {
-            printf("Usage: %s [auto|interactive]\n", argv[0]);
+            printf("Usage: %s [auto|interactive|bench|layers|coldstart]\n", argv[0]);
             printf("  auto       - Run all tests automatically\n");
             printf("  interactive - Interactive test menu\n");
+            printf("  bench      - Clear/fill-rect throughput, scalar vs NEON\n");
+            printf("  layers     - Background, chart and cursor on overlay planes\n");
+            printf("  coldstart  - Fast start init phases and time to first frame\n");
             printf("  (no args)  - Run basic test sequence\n");
         }
     } else {
@@ -456,6 +624,7 @@ int main(int argc, char *argv[]) {
     /* Final cleanup screen */
     printf("\nTest sequence complete. Clearing screen...\n");
     hal_lcd_clear(TEST_BLACK);
+    hal_lcd_swap();
     sleep(1);
 
     /* Cleanup */
@@ -74,6 +74,44 @@ int main(void)
         sleep(1);
     }
     
+    printf("\nTesting kernel-driven animations (no userspace wakeups)...\n");
+
+    /* Heartbeat-style sequence on red, plain blink on green, one flash on blue */
+    const hal_led_step_t heartbeat[] = {
+        { HAL_LED_ON,  100 },
+        { HAL_LED_OFF, 100 },
+        { HAL_LED_ON,  100 },
+        { HAL_LED_OFF, 700 }
+    };
+    hal_led_blink(HAL_LED_GREEN, 250, 250);
+    hal_led_pattern_sequence(HAL_LED_RED, heartbeat, 4, -1);
+    hal_led_flash(HAL_LED_BLUE, 500);
+    sleep(5);
+
+    for (int i = 0; i < HAL_LED_COUNT; i++) {
+        hal_led_stop((hal_led_t)i);
+    }
+
+    printf("\nPress USER1/USER2 to light Green/Red (5 seconds)...\n");
+
+    /* Each button mirrors onto the LED next to it, driven by edge events */
+    for (int waited = 0; waited < 5 && hal_button_get_fd() >= 0; waited++) {
+        if (hal_button_wait(1000) != HAL_OK) {
+            continue;
+        }
+
+        hal_button_event_t events[8];
+        int count = hal_button_read_events(events, 8);
+        for (int i = 0; i < count; i++) {
+            printf("USER%d %s at %llu.%06llu s\n", events[i].button + 1,
+                   events[i].state == HAL_BUTTON_PRESSED ? "pressed" : "released",
+                   (unsigned long long)(events[i].timestamp_ns / 1000000000u),
+                   (unsigned long long)(events[i].timestamp_ns % 1000000000u / 1000u));
+            hal_led_set_state(events[i].button == HAL_BUTTON_USER1 ? HAL_LED_GREEN : HAL_LED_RED,
+                              events[i].state == HAL_BUTTON_PRESSED ? HAL_LED_ON : HAL_LED_OFF);
+        }
+    }
+
     printf("\nTest complete. Cleaning up...\n");
     
     /* Cleanup */
@@ -27,7 +27,7 @@
 #include <stdbool.h>
 
 /* Test configuration */
-#define TOUCH_POLL_INTERVAL_MS  20      /* 50 Hz polling rate */
+#define TOUCH_POLL_INTERVAL_MS  20      /* Longest sleep between checks for Ctrl+C */
 #define MAX_TOUCH_TRAIL_POINTS  100     /* Maximum points in touch trail */
 #define TOUCH_POINT_SIZE        8       /* Size of touch indicator on screen */
 
@@ -66,6 +66,9 @@ static void signal_handler(int sig);
 static void test_basic_touch(void);
 static void test_multitouch(void);
 static void test_touch_and_draw(void);
+static void test_event_queue(void);
+static void test_gestures(void);
+static void test_event_loop(void);
 static void draw_touch_point(uint16_t x, uint16_t y, uint32_t color);
 static void draw_touch_info(hal_touch_data_t *data);
 static void add_trail_point(uint16_t x, uint16_t y);
@@ -86,6 +89,7 @@ static void signal_handler(int sig)
     (void)sig;
     printf("\nReceived interrupt signal. Exiting...\n");
     running = false;
+    hal_loop_stop();
 }
 
 /* Test basic touch detection */
@@ -106,7 +110,7 @@ static void test_basic_touch(void)
         hal_touch_status_t status = hal_touch_read(&touch_data);
         
         if (status == HAL_TOUCH_OK && touch_data.count > 0) {
-            for (int i = 0; i < touch_data.count; i++) {
+            for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
                 if (touch_data.points[i].valid) {
                     /* --- add: clear gesture (hold top-left >= 2s) --- */
                     if (should_clear(1, touch_data.points[i].x, touch_data.points[i].y)) {
@@ -136,7 +140,8 @@ static void test_basic_touch(void)
             }
         }
         
-        usleep(TOUCH_POLL_INTERVAL_MS * 1000);
+        /* Sleep until the next report instead of polling */
+        hal_touch_wait(TOUCH_POLL_INTERVAL_MS);
     }
     
     printf("Basic touch test completed. Total touches detected: %d\n", touch_count);
@@ -175,7 +180,7 @@ static void test_multitouch(void)
                 }
                 
                 /* Draw current touch points */
-                for (int i = 0; i < touch_data.count; i++) {
+                for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
                     if (touch_data.points[i].valid) {
                         uint32_t color = (i == 0) ? COLOR_TOUCH_1 : COLOR_TOUCH_2;
                         draw_crosshair(touch_data.points[i].x, touch_data.points[i].y, color);
@@ -194,7 +199,8 @@ static void test_multitouch(void)
             }
         }
         
-        usleep(TOUCH_POLL_INTERVAL_MS * 1000);
+        /* Sleep until the next report instead of polling */
+        hal_touch_wait(TOUCH_POLL_INTERVAL_MS);
     }
     
     printf("Multi-touch test completed. Maximum simultaneous touches: %d\n", max_simultaneous);
@@ -229,11 +235,11 @@ static void test_touch_and_draw(void)
         /* --- add: frame pacing ~60 FPS --- */
         static uint32_t last = 0;
         uint32_t now = now_ms();
-        if (last && (now - last) < FRAME_BUDGET_MS) { usleep(1000); continue; }
+        if (last && (now - last) < FRAME_BUDGET_MS) { hal_touch_wait(FRAME_BUDGET_MS - (now - last)); continue; }
         last = now;
         
         if (status == HAL_TOUCH_OK && touch_data.count > 0) {
-            for (int i = 0; i < touch_data.count; i++) {
+            for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
                 if (touch_data.points[i].valid) {
                     /* Add point to trail */
                     add_trail_point(touch_data.points[i].x, touch_data.points[i].y);
@@ -259,6 +265,157 @@ static void test_touch_and_draw(void)
     printf("Touch and draw test completed.\n");
 }
 
+/* Gesture recognizer output, with the Kalman-predicted drag position in green */
+static void test_gestures(void)
+{
+    static const char *names[] = {
+        "none", "tap", "long-press", "drag", "drag-end", "swipe", "pinch", "pinch-end"
+    };
+
+    printf("\n=== Gesture Test ===\n");
+    printf("Tap, hold, drag, swipe or pinch.\n");
+    printf("Press Ctrl+C to exit this test.\n\n");
+
+    clear_screen_with_border();
+    draw_grid();
+    hal_touch_set_prediction(HAL_TOUCH_PREDICT_KALMAN, 2 * FRAME_BUDGET_MS);
+
+    time_t start_time = time(NULL);
+    while (running && (time(NULL) - start_time) < 30) {
+        hal_touch_wait(TOUCH_POLL_INTERVAL_MS);
+
+        hal_touch_data_t touch_data;
+        hal_touch_read(&touch_data);
+
+        hal_gesture_t events[16];
+        int count = hal_touch_pop_gestures(events, 16);
+        for (int i = 0; i < count; i++) {
+            const hal_gesture_t *g = &events[i];
+            if (g->type == HAL_GESTURE_DRAG) {
+                draw_touch_point(g->x, g->y, COLOR_TOUCH_1);
+                draw_touch_point(g->px, g->py, COLOR_TOUCH_2);
+                continue;
+            }
+            printf("%s at (%d, %d) moved (%d, %d) velocity (%.0f, %.0f) px/s scale %.2f\n",
+                   names[g->type], g->x, g->y, g->dx, g->dy, g->vx, g->vy, g->scale);
+        }
+    }
+
+    hal_touch_set_prediction(HAL_TOUCH_PREDICT_NONE, 0);
+    printf("Gesture test completed.\n");
+}
+
+/* Event loop callbacks: no polling interval, each runs when its source is ready */
+static void loop_on_touch(const hal_touch_data_t *frame, void *user)
+{
+    int *reports = user;
+    (*reports)++;
+
+    for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
+        if (frame->points[i].valid) {
+            draw_touch_point(frame->points[i].x, frame->points[i].y, slot_color(i));
+        }
+    }
+}
+
+static void loop_on_button(const hal_button_event_t *event, void *user)
+{
+    (void)user;
+    if (event->state != HAL_BUTTON_PRESSED) {
+        return;
+    }
+
+    /* USER1 clears the canvas, USER2 ends the test */
+    if (event->button == HAL_BUTTON_USER1) {
+        clear_screen_with_border();
+        draw_grid();
+    } else {
+        hal_loop_stop();
+    }
+}
+
+static void loop_on_second(void *user)
+{
+    int *reports = user;
+    printf("Touch reports in the last second: %d\n", *reports);
+    *reports = 0;
+}
+
+static void loop_on_timeout(void *user)
+{
+    (void)user;
+    hal_loop_stop();
+}
+
+/* Everything on one epoll loop: touch, buttons and timers, no usleep() */
+static void test_event_loop(void)
+{
+    printf("\n=== Event Loop Test ===\n");
+    printf("Draw with a finger. USER1 clears, USER2 or Ctrl+C exits.\n\n");
+
+    clear_screen_with_border();
+    draw_grid();
+
+    int reports = 0;
+    if (hal_loop_init() != HAL_OK || hal_loop_add_touch(loop_on_touch, &reports) < 0) {
+        printf("Error: Cannot set up the event loop\n");
+        hal_loop_deinit();
+        return;
+    }
+
+    if (hal_loop_add_buttons(loop_on_button, NULL) < 0) {
+        printf("Buttons unavailable, use Ctrl+C to exit\n");
+    }
+    hal_loop_add_timer(1000, true, loop_on_second, &reports);
+    hal_loop_add_timer(30000, false, loop_on_timeout, NULL);
+
+    if (running) {
+        hal_loop_run();
+    }
+
+    hal_loop_deinit();
+    printf("Event loop test completed.\n");
+}
+
+/* Threaded capture: every report is drawn even though each frame renders slowly */
+static void test_event_queue(void)
+{
+    printf("\n=== Touch Event Queue Test ===\n");
+    printf("Drag a finger quickly, rendering is slowed to 10 FPS on purpose.\n");
+    printf("Press Ctrl+C to exit this test.\n\n");
+
+    clear_screen_with_border();
+    draw_grid();
+
+    hal_touch_data_t frames[64];
+    uint32_t total = 0;
+    time_t start_time = time(NULL);
+
+    while (running && (time(NULL) - start_time) < 30) {
+        if (hal_touch_wait(TOUCH_POLL_INTERVAL_MS) != HAL_TOUCH_OK) {
+            continue;
+        }
+
+        int count;
+        while ((count = hal_touch_pop_events(frames, 64)) > 0) {
+            for (int f = 0; f < count; f++) {
+                for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
+                    if (frames[f].points[i].valid) {
+                        draw_touch_point(frames[f].points[i].x, frames[f].points[i].y, slot_color(i));
+                    }
+                }
+            }
+            total += count;
+        }
+
+        /* Simulated heavy frame, the reader thread keeps queueing meanwhile */
+        usleep(100 * 1000);
+    }
+
+    printf("Event queue test completed. Frames: %u, dropped: %u\n",
+           total, hal_touch_get_overflow_count());
+}
+
 /* Helper function to draw touch point */
 static void draw_touch_point(uint16_t x, uint16_t y, uint32_t color)
 {
@@ -434,14 +591,17 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    /* Initialize LCD */
+    /* Initialize LCD - single buffer, the tests draw onto the previous frame */
+    hal_lcd_set_buffer_count(1);
     if (hal_lcd_init() != HAL_LCD_OK) {
         printf("Error: Failed to initialize LCD\n");
         hal_deinit();
         return EXIT_FAILURE;
     }
 
-    /* Initialize touch */
+    /* Initialize touch, the queue test captures on a reader thread */
+    bool queue_test = (argc > 1 && strcmp(argv[1], "queue") == 0);
+    hal_touch_set_threaded(queue_test);
     if (hal_touch_init() != HAL_TOUCH_OK) {
         printf("Error: Failed to initialize touch interface\n");
         hal_lcd_deinit();
@@ -459,11 +619,20 @@ int main(int argc, char *argv[])
             test_multitouch();
         } else if (strcmp(argv[1], "draw") == 0) {
             test_touch_and_draw();
+        } else if (strcmp(argv[1], "gesture") == 0) {
+            test_gestures();
+        } else if (strcmp(argv[1], "loop") == 0) {
+            test_event_loop();
+        } else if (queue_test) {
+            test_event_queue();
         } else {
-            printf("Usage: %s [basic|multi|draw]\n", argv[0]);
+            printf("Usage: %s [basic|multi|draw|queue|gesture|loop]\n", argv[0]);
             printf("  basic - Test basic touch detection\n");
             printf("  multi - Test multi-touch functionality\n");
             printf("  draw  - Test touch and draw\n");
+            printf("  queue - Test threaded capture with the event queue\n");
+            printf("  gesture - Print recognized gestures, draw the predicted drag\n");
+            printf("  loop  - Touch, buttons and timers on the HAL event loop\n");
             printf("  (no args) - Run all tests\n");
         }
     } else {
@@ -9,6 +9,22 @@
  * - 4 LED control (Green LD5, Red LD6, Orange LD7, Blue LD8)
  * - 2 Button input (USER1, USER2)
  * 
+ * Threading model (render on one thread, input on another, telemetry on a third):
+ * - Init/deinit and the set-before-init configuration calls run while no
+ *   other thread is using that subsystem. hal_init()/hal_deinit() are
+ *   serialized against each other.
+ * - LCD drawing, swaps, layers and hal_lcd_handle_events() belong to one
+ *   render thread and take no locks. hal_lcd_get_stats(),
+ *   hal_lcd_reset_stats() and hal_lcd_get_flush_bytes() are lock-free and
+ *   safe from any thread.
+ * - Touch input calls (read, wait, pop_events, handle_hotplug) may come from
+ *   any thread and are serialized internally. hal_touch_get_snapshot(),
+ *   hal_touch_is_touched() and hal_touch_get_point() never block on them.
+ *   Gesture and prediction calls are safe from any thread.
+ * - LED and button calls are safe from any thread.
+ * - hal_loop_*() belongs to the thread running the loop, except
+ *   hal_loop_stop().
+ * 
  * @author Huy Nguyen
  * @date August 2025
  */
@@ -18,6 +34,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /* HAL Return Codes */
 typedef enum {
@@ -30,6 +51,19 @@ typedef enum {
     HAL_NOT_INITIALIZED = -6
 } hal_status_t;
 
+/* Log levels, see hal_log_set_level() */
+typedef enum {
+    HAL_LOG_ERROR = 0,
+    HAL_LOG_WARN,
+    HAL_LOG_INFO,
+    HAL_LOG_DEBUG,              /* Per-call detail, compiled out of default builds */
+    HAL_LOG_TRACE
+} hal_log_level_t;
+
+/* In-memory log: the last HAL_LOG_RING_ENTRIES messages, truncated to HAL_LOG_MSG_MAX - 1 chars */
+#define HAL_LOG_RING_ENTRIES    128
+#define HAL_LOG_MSG_MAX         120
+
 /* LED Definitions - Based on actual STM32MP157F-DK2 configuration */
 typedef enum {
     HAL_LED_GREEN = 0,      /* Green LD5 (PA14) */
@@ -44,6 +78,14 @@ typedef enum {
     HAL_LED_ON = 1
 } hal_led_state_t;
 
+/* One step of an LED animation, see hal_led_pattern_sequence() */
+#define HAL_LED_MAX_STEPS       16
+
+typedef struct {
+    hal_led_state_t state;
+    uint32_t duration_ms;
+} hal_led_step_t;
+
 /* Button Definitions - Based on actual STM32MP157F-DK2 configuration */
 typedef enum {
     HAL_BUTTON_USER1 = 0,   /* USER1 button (with Green LED LD5) */
@@ -56,13 +98,27 @@ typedef enum {
     HAL_BUTTON_PRESSED = 1
 } hal_button_state_t;
 
+/* Button edge event, timestamped by the kernel on CLOCK_MONOTONIC */
+typedef struct {
+    hal_button_t button;
+    hal_button_state_t state;
+    uint64_t timestamp_ns;
+} hal_button_event_t;
+
 /* LCD Definitions - LCD Display Specifications for STM32MP157F-DK2 */
 #define LCD_WIDTH           480
 #define LCD_HEIGHT          800
-#define LCD_BPP             32      /* 32 bits per pixel (ARGB8888) */
+#define LCD_BPP             32      /* Default 32 bits per pixel, see hal_lcd_config_t */
 #define LCD_BUFFER_SIZE     (LCD_WIDTH * LCD_HEIGHT * (LCD_BPP / 8))
 
-/* Color definitions for ARGB8888 format (32-bit) - Fixed format */
+/* Swap chain - number of dumb buffers cycled by hal_lcd_swap() */
+#define HAL_LCD_MAX_BUFFERS     3       /* Triple buffering */
+#define HAL_LCD_DEFAULT_BUFFERS 2       /* Double buffering */
+
+/* Overlay layers, each backed by one DRM plane */
+#define HAL_LCD_MAX_LAYERS      4
+
+/* Color definitions for ARGB8888 format (32-bit), packed on the fly for RGB565 */
 #define LCD_COLOR_BLACK     0xFF000000
 #define LCD_COLOR_WHITE     0xFFFFFFFF
 #define LCD_COLOR_RED       0xFFFF0000
@@ -76,9 +132,15 @@ typedef enum {
     HAL_LCD_OK = 0,
     HAL_LCD_ERROR,
     HAL_LCD_INVALID_PARAM,
-    HAL_LCD_NOT_INITIALIZED
+    HAL_LCD_NOT_INITIALIZED,
+    HAL_LCD_BUSY                /* Swap not accepted yet, a flip is still pending */
 } hal_lcd_status_t;
 
+typedef enum {
+    HAL_LCD_SWAP_BLOCKING = 0,  /* hal_lcd_swap() waits for the flip when needed */
+    HAL_LCD_SWAP_NONBLOCKING    /* hal_lcd_swap() never waits, poll hal_lcd_get_fd() */
+} hal_lcd_swap_mode_t;
+
 typedef struct {
     uint16_t x;
     uint16_t y;
@@ -91,6 +153,77 @@ typedef struct {
     uint16_t height;
 } hal_lcd_rect_t;
 
+typedef enum {
+    HAL_LCD_FORMAT_XRGB8888 = 0,
+    HAL_LCD_FORMAT_RGB565,
+    HAL_LCD_FORMAT_ARGB8888     /* Layers only, alpha blended over the layers below */
+} hal_lcd_format_t;
+
+/* Overlay layer handle from hal_lcd_layer_create() */
+typedef int hal_lcd_layer_t;
+
+/* Requested display configuration for hal_lcd_init_ex() */
+typedef struct {
+    uint16_t width;             /* 0 = connector's preferred mode */
+    uint16_t height;
+    uint32_t refresh;           /* Hz, 0 = any */
+    hal_lcd_format_t format;
+    int buffer_count;           /* 0 = HAL_LCD_DEFAULT_BUFFERS */
+    bool shadow;                /* Draw into a cached shadow buffer */
+    bool legacy;                /* Skip atomic KMS even if the driver supports it */
+    bool fast_start;            /* Quiet, cached mode, no test clear, mode set on the first swap */
+    const char *mode_cache;     /* Fast start cache file, NULL = HAL_LCD_MODE_CACHE, "" = none */
+} hal_lcd_config_t;
+
+/* Where fast start keeps the connector, CRTC and mode of the last full probe */
+#define HAL_LCD_MODE_CACHE      "/var/cache/hal-lcd.mode"
+
+/* Phases of the last hal_lcd_init_ex(), in microseconds */
+typedef struct {
+    uint32_t open_us;           /* Pixel kernels, device open, client caps */
+    uint32_t probe_us;          /* Connector and mode: full probe or cache check */
+    uint32_t buffers_us;        /* Dumb buffers, framebuffer objects, mappings */
+    uint32_t planes_us;         /* Plane discovery and atomic property lookup */
+    uint32_t modeset_us;        /* Fast start: done by the first swap, 0 until then */
+    uint32_t clear_us;          /* Shadow allocation and the test clear */
+    uint32_t total_us;          /* Whole hal_lcd_init_ex() call */
+    uint32_t first_frame_us;    /* Init entry to the first successful swap, 0 until then */
+    bool mode_cached;           /* Probe skipped, the cached setup validated */
+} hal_lcd_init_stats_t;
+
+/* Current draw target as negotiated with the display */
+typedef struct {
+    void *base;                 /* First pixel of the draw target */
+    uint32_t pitch;             /* Bytes per row, may exceed width * bpp / 8 */
+    uint16_t width;
+    uint16_t height;
+    hal_lcd_format_t format;
+    uint8_t bpp;
+} hal_lcd_fb_t;
+
+/* Frame timing histograms: 1 ms buckets, the last one collects everything slower */
+#define HAL_LCD_STATS_BUCKETS   32
+#define HAL_LCD_STATS_BUCKET_US 1000
+
+typedef struct {
+    uint32_t last;              /* Most recent frame, microseconds */
+    uint32_t avg;               /* Mean over the window */
+    uint32_t max;               /* Worst frame in the window */
+    uint32_t hist[HAL_LCD_STATS_BUCKETS];
+} hal_lcd_timing_t;
+
+/* Frame statistics from hal_lcd_get_stats(), over the last `window` frames */
+typedef struct {
+    uint32_t frames;            /* Swaps since init or hal_lcd_reset_stats() */
+    uint32_t window;            /* Frames covered by the timings below */
+    uint32_t missed_vblanks;    /* Vblanks a flip landed after its first chance */
+    size_t flush_bytes;         /* Bytes copied by the last shadow flush */
+    hal_lcd_timing_t draw_us;   /* Render thread CPU time from one swap returning to the next call */
+    hal_lcd_timing_t draw_wall_us;  /* Wall time over the same span, sleeps and waits included */
+    hal_lcd_timing_t swap_us;   /* Time spent inside hal_lcd_swap() */
+    hal_lcd_timing_t latency_us;/* Flip submission to the vblank it landed on */
+} hal_lcd_stats_t;
+
 /*=============================================================================
  * LED Control Functions
  *============================================================================*/
@@ -137,6 +270,51 @@ hal_status_t hal_led_toggle(hal_led_t led);
  */
 hal_status_t hal_led_set_pattern(uint8_t pattern);
 
+/**
+ * @brief Blink an LED until it is set, toggled or stopped
+ *
+ * Runs on the kernel timer trigger, so no userspace wakeups are needed.
+ * Falls back to a HAL thread if the trigger is not available.
+ *
+ * @param led LED identifier
+ * @param on_ms Time on per period
+ * @param off_ms Time off per period
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_led_blink(hal_led_t led, uint32_t on_ms, uint32_t off_ms);
+
+/**
+ * @brief Play a sequence of on/off steps on an LED
+ *
+ * Runs on the kernel pattern trigger, with a HAL thread as fallback.
+ *
+ * @param led LED identifier
+ * @param steps Steps to play in order, copied
+ * @param count Number of steps (1..HAL_LED_MAX_STEPS)
+ * @param repeat Passes through the sequence, -1 = forever
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_led_pattern_sequence(hal_led_t led, const hal_led_step_t *steps, int count, int repeat);
+
+/**
+ * @brief Turn an LED on once for a fixed time (e.g. activity indication)
+ *
+ * Uses the kernel oneshot trigger. Repeated calls re-arm it, with the
+ * new on time if it changed.
+ *
+ * @param led LED identifier
+ * @param on_ms Time on
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_led_flash(hal_led_t led, uint32_t on_ms);
+
+/**
+ * @brief Stop any blink, sequence or flash and turn the LED off
+ * @param led LED identifier
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_led_stop(hal_led_t led);
+
 /*=============================================================================
  * Button Control Functions
  *============================================================================*/
@@ -161,6 +339,28 @@ hal_status_t hal_button_deinit(void);
  */
 hal_status_t hal_button_get_state(hal_button_t button, hal_button_state_t *state);
 
+/**
+ * @brief Get the button event file descriptor
+ * @return Descriptor that becomes readable when button edges are queued, or -1
+ * @note Add it to poll()/epoll and call hal_button_read_events() when readable
+ */
+int hal_button_get_fd(void);
+
+/**
+ * @brief Drain queued, debounced button edges without blocking
+ * @param events Array to store events
+ * @param max Maximum number of events to store
+ * @return Number of events stored (0 if none pending), or -1 if not initialized
+ */
+int hal_button_read_events(hal_button_event_t *events, int max);
+
+/**
+ * @brief Wait for a button edge
+ * @param timeout_ms Timeout in milliseconds (-1 waits forever)
+ * @return HAL_OK if events are pending, HAL_TIMEOUT on timeout, error code otherwise
+ */
+hal_status_t hal_button_wait(int timeout_ms);
+
 /*=============================================================================
  * LCD Control Functions
  *============================================================================*/
@@ -171,6 +371,31 @@ hal_status_t hal_button_get_state(hal_button_t button, hal_button_state_t *state
  */
 hal_lcd_status_t hal_lcd_init(void);
 
+/**
+ * @brief Initialize the LCD subsystem with an explicit mode and format
+ * @param config Requested configuration, NULL behaves like hal_lcd_init()
+ * @return HAL_LCD_OK on success, HAL_LCD_INVALID_PARAM for an unsupported format
+ *
+ * With HAL_LCD_FORMAT_RGB565 the API keeps taking ARGB8888 colors and
+ * images; scanout bandwidth and flush copies are halved.
+ * A size the connector does not offer falls back to its preferred mode;
+ * query the result with hal_lcd_get_framebuffer().
+ *
+ * fast_start is meant for boot-to-first-frame: informational output is
+ * dropped, the setup from mode_cache is reused after a single ioctl check,
+ * buffers start black instead of test red, and the current picture (boot
+ * splash) stays on screen until the first hal_lcd_swap() sets the mode.
+ */
+hal_lcd_status_t hal_lcd_init_ex(const hal_lcd_config_t *config);
+
+/**
+ * @brief Get the phase timings of the last hal_lcd_init_ex()
+ * @param stats Output timings, first_frame_us and a deferred modeset_us
+ *              fill in once the first swap has been done
+ * @return HAL_LCD_OK on success, HAL_LCD_NOT_INITIALIZED before any init
+ */
+hal_lcd_status_t hal_lcd_get_init_stats(hal_lcd_init_stats_t *stats);
+
 /**
  * @brief Deinitialize the LCD subsystem
  * @return HAL_LCD_OK on success, error code otherwise
@@ -202,6 +427,168 @@ hal_lcd_status_t hal_lcd_set_pixel(uint16_t x, uint16_t y, uint32_t color);
  */
 hal_lcd_status_t hal_lcd_draw_rectangle(hal_lcd_rect_t rect, uint32_t color, bool filled);
 
+/**
+ * @brief Copy an ARGB8888 image onto the LCD (converted for RGB565 framebuffers)
+ * @param rect Destination position and size (clipped to the screen)
+ * @param src Source pixels, top-left of the image
+ * @param src_pitch Bytes between source rows
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_blit(hal_lcd_rect_t rect, const uint32_t *src, uint32_t src_pitch);
+
+/**
+ * @brief Alpha-blend an ARGB8888 image onto the LCD (source-over, straight alpha)
+ * @param rect Destination position and size (clipped to the screen)
+ * @param src Source pixels, top-left of the image
+ * @param src_pitch Bytes between source rows
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_blend_rect(hal_lcd_rect_t rect, const uint32_t *src, uint32_t src_pitch);
+
+/**
+ * @brief Enable or disable the NEON pixel kernels (selected automatically at init)
+ * @param enable true to use NEON, false to force the scalar kernels
+ * @return HAL_LCD_OK on success, HAL_LCD_ERROR if NEON is not available
+ */
+hal_lcd_status_t hal_lcd_set_neon(bool enable);
+
+/**
+ * @brief Get the current draw target (changes after every hal_lcd_swap)
+ * @param out Receives base address, pitch, size and format
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_get_framebuffer(hal_lcd_fb_t *out);
+
+/**
+ * @brief Report pixels written directly through hal_lcd_get_framebuffer()
+ * @param rect Area that changed, needed for the shadow buffer flush
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_mark_dirty(hal_lcd_rect_t rect);
+
+/**
+ * @brief Get the number of overlay planes usable as layers
+ * @return Plane count, 0 if the display has no overlays
+ */
+int hal_lcd_get_layer_count(void);
+
+/**
+ * @brief Create an overlay layer with its own double buffer on a free DRM plane
+ * @param rect Initial position on screen and layer size
+ * @param format Pixel format, HAL_LCD_FORMAT_ARGB8888 for a transparent overlay
+ * @param layer Receives the layer handle
+ * @return HAL_LCD_OK on success, HAL_LCD_BUSY if no plane supporting the format is free
+ *
+ * The layer starts cleared (transparent for ARGB8888) and hidden until the
+ * first hal_lcd_layer_commit(). Layers are composed by the display
+ * controller, so updating one never touches the primary buffers.
+ */
+hal_lcd_status_t hal_lcd_layer_create(hal_lcd_rect_t rect, hal_lcd_format_t format, hal_lcd_layer_t *layer);
+
+/**
+ * @brief Hide a layer and release its plane and buffers
+ * @param layer Layer handle
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_layer_destroy(hal_lcd_layer_t layer);
+
+/**
+ * @brief Get the layer's back buffer for direct drawing
+ * @param layer Layer handle
+ * @param out Receives base address, pitch, size and format
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_layer_get_framebuffer(hal_lcd_layer_t layer, hal_lcd_fb_t *out);
+
+/**
+ * @brief Fill a rectangle of the layer's back buffer (alpha is stored, not blended)
+ * @param layer Layer handle
+ * @param rect Area in layer coordinates (clipped to the layer)
+ * @param color ARGB8888 color
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_layer_fill(hal_lcd_layer_t layer, hal_lcd_rect_t rect, uint32_t color);
+
+/**
+ * @brief Copy an ARGB8888 image into the layer's back buffer
+ * @param layer Layer handle
+ * @param rect Area in layer coordinates (clipped to the layer)
+ * @param src Source pixels, top-left of the image
+ * @param src_pitch Bytes between source rows
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_layer_blit(hal_lcd_layer_t layer, hal_lcd_rect_t rect,
+                                    const uint32_t *src, uint32_t src_pitch);
+
+/**
+ * @brief Show the layer's back buffer and swap to the other one
+ * @param layer Layer handle
+ * @return HAL_LCD_OK on success, error code otherwise
+ *
+ * The new back buffer holds an older frame; redraw it fully before the
+ * next commit. With atomic KMS the change is staged, see
+ * hal_lcd_commit_layers().
+ */
+hal_lcd_status_t hal_lcd_layer_commit(hal_lcd_layer_t layer);
+
+/**
+ * @brief Move a layer without redrawing it
+ * @param layer Layer handle
+ * @param x CRTC x of the layer's top-left corner, may be partly off screen
+ * @param y CRTC y of the layer's top-left corner
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_layer_move(hal_lcd_layer_t layer, int x, int y);
+
+/**
+ * @brief Set the stacking order of a layer
+ * @param layer Layer handle
+ * @param zpos Position in the stack, higher is on top
+ * @return HAL_LCD_OK on success, HAL_LCD_ERROR if the plane has a fixed z-order
+ *         or the driver rejects the position
+ */
+hal_lcd_status_t hal_lcd_layer_set_zpos(hal_lcd_layer_t layer, int zpos);
+
+/**
+ * @brief Hide a layer until its next commit
+ * @param layer Layer handle
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_layer_hide(hal_lcd_layer_t layer);
+
+/**
+ * @brief Commit staged layer changes without a new primary frame
+ * @return HAL_LCD_OK on success, HAL_LCD_BUSY in non-blocking mode while a flip is pending
+ *
+ * With atomic KMS, layer commit/move/hide/zpos are staged and go out with
+ * the next hal_lcd_swap() in one commit, or with this call when the
+ * primary buffer did not change. With legacy KMS they apply immediately
+ * and this is a no-op. Each change is checked with a test-only commit
+ * when staged, and a commit that still fails keeps them staged for the
+ * next one.
+ */
+hal_lcd_status_t hal_lcd_commit_layers(void);
+
+/**
+ * @brief Check if frames are presented with atomic commits
+ * @return true for atomic KMS, false for the legacy SETCRTC/PAGE_FLIP path
+ */
+bool hal_lcd_is_atomic(void);
+
+/**
+ * @brief Request an out-fence for each non-blocking atomic commit
+ * @param enable true to request fences
+ * @return HAL_LCD_OK on success, HAL_LCD_ERROR if initialized without atomic KMS
+ */
+hal_lcd_status_t hal_lcd_set_out_fence(bool enable);
+
+/**
+ * @brief Take the fence of the last submitted frame
+ * @return sync_file fd that becomes readable once the frame is on screen
+ *         (the caller closes it), or -1 if none is available
+ */
+int hal_lcd_take_out_fence(void);
+
 /**
  * @brief Shutdown the LCD subsystem
  * @return HAL_LCD_OK on success, error code otherwise
@@ -217,16 +604,114 @@ hal_lcd_status_t hal_lcd_get_info(void *info);
 
 /**
  * @brief Swap/refresh the LCD display buffer
- * @return HAL_LCD_OK on success, error code otherwise
+ *
+ * Queues the back buffer for display with a vblank-synced page flip and
+ * moves drawing to the next free buffer. In blocking mode this waits for
+ * at most one vblank; with three buffers the next frame is drawn while
+ * the flip is pending and only the swap after it waits. In non-blocking
+ * mode it returns HAL_LCD_BUSY whenever a flip is still pending, whatever
+ * the buffer count (a flip cannot be queued behind another), and the
+ * frame stays in the back buffer until a retry succeeds.
+ *
+ * @return HAL_LCD_OK on success, HAL_LCD_BUSY if the swap must be retried
  */
 hal_lcd_status_t hal_lcd_swap(void);
 
+/**
+ * @brief Set the number of buffers in the swap chain (call before hal_lcd_init)
+ *
+ * A third buffer only helps HAL_LCD_SWAP_BLOCKING callers. Non-blocking
+ * swaps return HAL_LCD_BUSY while a flip is pending either way, so it
+ * gives them nothing but the extra memory.
+ *
+ * @param count 1 (draw to the scanout buffer), 2 (double) or 3 (triple buffering)
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_set_buffer_count(int count);
+
+/**
+ * @brief Draw into a cached shadow buffer instead of scanout memory (call before hal_lcd_init)
+ *
+ * Drawing calls then record damage rectangles. hal_lcd_swap() copies only
+ * the pixels that changed since the last frame into the back buffer and
+ * reports them with DRM_IOCTL_MODE_DIRTYFB. If the shadow cannot be
+ * allocated, hal_lcd_init() keeps a single buffer instead, so partial
+ * redraws still land on the frame being shown.
+ *
+ * @param enable true to use a shadow buffer
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_set_shadow(bool enable);
+
+/**
+ * @brief Get the number of bytes the last shadow flush copied to scanout memory
+ * @return Bytes written to the back buffer by the last hal_lcd_swap()
+ */
+size_t hal_lcd_get_flush_bytes(void);
+
+/**
+ * @brief Get frame timing statistics
+ *
+ * Only available when the HAL is built with HAL_LCD_STATS=1 (the default).
+ *
+ * @param stats Output statistics
+ * @return HAL_LCD_OK on success, HAL_LCD_ERROR if statistics are compiled out
+ */
+hal_lcd_status_t hal_lcd_get_stats(hal_lcd_stats_t *stats);
+
+/**
+ * @brief Clear the frame timing statistics
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_reset_stats(void);
+
+/**
+ * @brief Periodically write the frame statistics to a file
+ *
+ * A HAL thread replaces the file once per period with key=value lines
+ * from a hal_lcd_get_stats() snapshot, so a shell can watch it with cat
+ * and hal_lcd_swap() does no file I/O. The writer stops in
+ * hal_lcd_deinit().
+ *
+ * @param path File to write, NULL to stop
+ * @param period_ms Time between writes
+ * @return HAL_LCD_OK on success, HAL_LCD_ERROR if statistics are compiled out
+ *         or the writer thread could not be started
+ */
+hal_lcd_status_t hal_lcd_set_stats_file(const char *path, uint32_t period_ms);
+
+/**
+ * @brief Select blocking or non-blocking swap behaviour
+ * @param swap Swap mode
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_set_swap_mode(hal_lcd_swap_mode_t swap);
+
+/**
+ * @brief Get the DRM file descriptor, readable when a flip has completed
+ * @return File descriptor, or -1 if the LCD is not initialized
+ */
+int hal_lcd_get_fd(void);
+
+/**
+ * @brief Process completed page flips
+ * @param timeout_ms Time to wait for an event (0 = poll, -1 = wait forever)
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_handle_events(int timeout_ms);
+
+/**
+ * @brief Check if a submitted frame has not reached the screen yet
+ * @return true if a flip is pending, false otherwise
+ */
+bool hal_lcd_flip_pending(void);
+
 /*=============================================================================
  * Touch Interface Control Functions  
  *============================================================================*/
 
 /* Touch Definitions - FocalTech FT6236 */
-#define HAL_TOUCH_MAX_POINTS    2           /* Maximum simultaneous touch points */
+#define HAL_TOUCH_MAX_POINTS    10          /* Contact slots reported, the FT6236 uses 2 */
 #define HAL_TOUCH_WIDTH         480         /* Touch panel width */
 #define HAL_TOUCH_HEIGHT        800         /* Touch panel height */
 
@@ -248,7 +733,7 @@ typedef enum {
 typedef struct {
     uint16_t x;                 /* X coordinate (0-479) */
     uint16_t y;                 /* Y coordinate (0-799) */
-    uint8_t id;                 /* Touch point ID (0-1) */
+    uint8_t id;                 /* Touch point ID (contact slot) */
     hal_touch_event_t event;    /* Touch event type */
     uint8_t pressure;           /* Touch pressure (0-255, if supported) */
     bool valid;                 /* True if this touch point is valid */
@@ -260,6 +745,37 @@ typedef struct {
     uint32_t timestamp;         /* Timestamp of touch event */
 } hal_touch_data_t;
 
+typedef enum {
+    HAL_GESTURE_NONE = 0,
+    HAL_GESTURE_TAP,            /* Short press without movement */
+    HAL_GESTURE_LONG_PRESS,     /* Held still, reported once while still down */
+    HAL_GESTURE_DRAG,           /* Every frame while a single contact moves */
+    HAL_GESTURE_DRAG_END,       /* Drag released slower than a swipe */
+    HAL_GESTURE_SWIPE,          /* Drag released fast, see vx/vy */
+    HAL_GESTURE_PINCH,          /* Every frame while two contacts are down, see scale */
+    HAL_GESTURE_PINCH_END
+} hal_gesture_type_t;
+
+typedef enum {
+    HAL_TOUCH_PREDICT_NONE = 0,
+    HAL_TOUCH_PREDICT_LINEAR,   /* Last position plus smoothed velocity */
+    HAL_TOUCH_PREDICT_KALMAN    /* Constant-velocity Kalman filter, smoother on noisy panels */
+} hal_touch_predict_t;
+
+typedef struct {
+    hal_gesture_type_t type;
+    uint16_t x;                 /* Primary contact, centroid for pinch */
+    uint16_t y;
+    uint16_t px;                /* Predicted position, see hal_touch_set_prediction() */
+    uint16_t py;
+    int16_t dx;                 /* Movement since the contact started */
+    int16_t dy;
+    float vx;                   /* Velocity in pixels per second */
+    float vy;
+    float scale;                /* Pinch finger distance relative to its start */
+    uint32_t timestamp;         /* Timestamp of the frame that produced it */
+} hal_gesture_t;
+
 /**
  * @brief Initialize the touch subsystem
  * @return HAL_TOUCH_OK on success, error code otherwise
@@ -279,6 +795,139 @@ hal_touch_status_t hal_touch_deinit(void);
  */
 hal_touch_status_t hal_touch_read(hal_touch_data_t *data);
 
+/**
+ * @brief Copy the newest decoded touch frame without touching the device
+ *
+ * Lock-free (seqlock) and safe from any thread, e.g. a render thread
+ * reading the frame that an input thread or the reader thread decoded.
+ *
+ * @param data Pointer to store touch data
+ * @return HAL_TOUCH_OK on success, error code otherwise
+ */
+hal_touch_status_t hal_touch_get_snapshot(hal_touch_data_t *data);
+
+/**
+ * @brief Get the touch input file descriptor for an external poll/epoll loop
+ *
+ * The descriptor is non-blocking and becomes readable when the controller
+ * reports new input. Call hal_touch_read() when it does.
+ *
+ * @return File descriptor, or -1 if touch is not initialized
+ */
+int hal_touch_get_fd(void);
+
+/**
+ * @brief Sleep until touch input is available
+ * @param timeout_ms Maximum time to wait (0 = poll, -1 = wait forever)
+ * @return HAL_TOUCH_OK if input is ready, HAL_TOUCH_NO_DATA on timeout, error code otherwise
+ */
+hal_touch_status_t hal_touch_wait(int timeout_ms);
+
+/**
+ * @brief Capture touch input on a background thread (call before hal_touch_init)
+ *
+ * A reader thread drains the device and queues every decoded report in a
+ * lock-free ring, so frames that arrive while the application is busy are
+ * kept instead of merged. Drain them with hal_touch_pop_events().
+ * hal_touch_read() then returns the newest queued frame and discards the
+ * rest, and hal_touch_get_fd() returns a descriptor that is readable while
+ * frames are queued.
+ *
+ * @param enable true to start the reader thread on init
+ * @return HAL_TOUCH_OK on success, error code otherwise
+ */
+hal_touch_status_t hal_touch_set_threaded(bool enable);
+
+/**
+ * @brief Record the raw input stream to a capture file (call before hal_touch_init)
+ *
+ * Every event read from the device is appended with its kernel timestamp,
+ * after a header holding the device name and axis ranges. The file plays
+ * back with hal_touch_set_replay() on the board or a host.
+ *
+ * @param path File to create, NULL to stop recording on the next init
+ * @return HAL_TOUCH_OK on success, error code otherwise
+ */
+hal_touch_status_t hal_touch_set_record(const char *path);
+
+/**
+ * @brief Read input from a capture file instead of the device (call before hal_touch_init)
+ *
+ * Events are delivered at the recorded pace divided by speed, with their
+ * recorded timestamps, through the same descriptor, threaded mode and
+ * gesture paths as live input. The end of the file reads like a removed
+ * device: hal_touch_wait() returns HAL_TOUCH_ERROR once it is drained.
+ *
+ * @param path Capture from hal_touch_set_record(), NULL for the live device
+ * @param speed 1.0 as recorded, 4.0 four times faster, 0 without delays
+ * @return HAL_TOUCH_OK on success, error code otherwise
+ */
+hal_touch_status_t hal_touch_set_replay(const char *path, float speed);
+
+/**
+ * @brief Take queued touch frames in the order they were reported (threaded mode)
+ * @param frames Output array
+ * @param max Capacity of frames
+ * @return Number of frames copied (0 if none), -1 if threaded mode is not running
+ */
+int hal_touch_pop_events(hal_touch_data_t *frames, int max);
+
+/**
+ * @brief Get the number of frames dropped because the queue was full
+ * @return Frames lost since hal_touch_init()
+ */
+uint32_t hal_touch_get_overflow_count(void);
+
+/**
+ * @brief Get a descriptor that becomes readable on input device hotplug
+ *
+ * Opens a kernel uevent socket on first use. When it is readable call
+ * hal_touch_handle_hotplug().
+ *
+ * @return File descriptor, or -1 if touch is not initialized or the socket failed
+ */
+int hal_touch_get_hotplug_fd(void);
+
+/**
+ * @brief Process pending hotplug events, closing or reopening the touchscreen
+ * @return HAL_TOUCH_OK if the device was attached or removed, HAL_TOUCH_NO_DATA if nothing changed
+ */
+hal_touch_status_t hal_touch_handle_hotplug(void);
+
+/**
+ * @brief Check if a touchscreen is currently open
+ * @return true if connected, false otherwise
+ */
+bool hal_touch_is_connected(void);
+
+/**
+ * @brief Take recognized gestures in the order they happened
+ *
+ * Every frame hal_touch_read() or hal_touch_pop_events() decodes is run
+ * through the recognizer, so call one of them regularly.
+ *
+ * @param gestures Output array
+ * @param max Capacity of gestures
+ * @return Number of gestures copied, -1 if touch is not initialized
+ */
+int hal_touch_pop_gestures(hal_gesture_t *gestures, int max);
+
+/**
+ * @brief Select position prediction for the primary contact
+ * @param mode Predictor
+ * @param lead_ms How far ahead to predict, typically one frame plus scanout (~20-40 ms at 50 Hz)
+ * @return HAL_TOUCH_OK on success, error code otherwise
+ */
+hal_touch_status_t hal_touch_set_prediction(hal_touch_predict_t mode, uint32_t lead_ms);
+
+/**
+ * @brief Get the predicted position of the primary contact
+ * @param x Predicted X
+ * @param y Predicted Y
+ * @return HAL_TOUCH_OK if a contact is down, HAL_TOUCH_NO_DATA otherwise
+ */
+hal_touch_status_t hal_touch_get_predicted(uint16_t *x, uint16_t *y);
+
 /**
  * @brief Check if touch panel is being touched
  * @return true if touched, false otherwise
@@ -299,6 +948,154 @@ hal_touch_status_t hal_touch_get_point(uint16_t *x, uint16_t *y);
  */
 hal_touch_status_t hal_touch_calibrate(void);
 
+/*=============================================================================
+ * Event Loop Functions
+ *============================================================================*/
+
+#define HAL_LOOP_MAX_WATCHES    32          /* Descriptors and timers per loop */
+
+/* Event flags for hal_loop_add_fd() and its callback */
+#define HAL_LOOP_READ           0x01
+#define HAL_LOOP_WRITE          0x02
+#define HAL_LOOP_ERROR          0x04        /* Reported only: error or hangup */
+
+typedef void (*hal_loop_fd_cb_t)(int fd, uint32_t events, void *user);
+typedef void (*hal_loop_timer_cb_t)(void *user);
+typedef void (*hal_loop_touch_cb_t)(const hal_touch_data_t *frame, void *user);
+typedef void (*hal_loop_button_cb_t)(const hal_button_event_t *event, void *user);
+typedef void (*hal_loop_flip_cb_t)(void *user);
+
+/**
+ * @brief Create the event loop
+ *
+ * Touch, buttons, page flips, timers and application descriptors all
+ * register on one epoll instance, and hal_loop_run() sleeps until the
+ * next of them is ready. Callbacks run on the thread running the loop
+ * and may add or remove watches, including their own.
+ *
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_loop_init(void);
+
+/**
+ * @brief Remove all watches and destroy the event loop
+ * @return HAL_OK on success, error code otherwise
+ */
+hal_status_t hal_loop_deinit(void);
+
+/**
+ * @brief Watch an application descriptor
+ * @param fd Descriptor, still owned by the caller (remove the watch before closing it)
+ * @param events HAL_LOOP_READ and/or HAL_LOOP_WRITE
+ * @param cb Called with the ready flags
+ * @param user Passed to cb
+ * @return Watch ID, or -1 on error
+ */
+int hal_loop_add_fd(int fd, uint32_t events, hal_loop_fd_cb_t cb, void *user);
+
+/**
+ * @brief Add a timer on CLOCK_MONOTONIC
+ * @param interval_ms First expiry and, if repeating, the period
+ * @param repeat false for a one-shot timer, removed automatically once it fires
+ * @param cb Called once per wakeup, missed periods are not replayed
+ * @param user Passed to cb
+ * @return Watch ID, or -1 on error
+ */
+int hal_loop_add_timer(uint32_t interval_ms, bool repeat, hal_loop_timer_cb_t cb, void *user);
+
+/**
+ * @brief Deliver touch frames (call after hal_touch_init)
+ *
+ * In threaded mode every queued frame is delivered, otherwise one merged
+ * frame per wakeup. The touchscreen is followed across hotplug.
+ *
+ * @param cb Called per frame
+ * @param user Passed to cb
+ * @return Watch ID, or -1 on error
+ */
+int hal_loop_add_touch(hal_loop_touch_cb_t cb, void *user);
+
+/**
+ * @brief Deliver button edges (call after hal_button_init)
+ * @param cb Called per debounced edge
+ * @param user Passed to cb
+ * @return Watch ID, or -1 on error
+ */
+int hal_loop_add_buttons(hal_loop_button_cb_t cb, void *user);
+
+/**
+ * @brief Get notified when a submitted frame reaches the screen (call after hal_lcd_init)
+ *
+ * Use with HAL_LCD_SWAP_NONBLOCKING and draw the next frame from the callback.
+ *
+ * @param cb Called after each completed page flip
+ * @param user Passed to cb
+ * @return Watch ID, or -1 on error
+ */
+int hal_loop_add_lcd(hal_loop_flip_cb_t cb, void *user);
+
+/**
+ * @brief Remove a watch
+ * @param id Watch ID returned by one of the hal_loop_add_*() functions
+ * @return HAL_OK on success, HAL_INVALID_PARAM for unknown or already removed IDs
+ */
+hal_status_t hal_loop_remove(int id);
+
+/**
+ * @brief Wait once and dispatch whatever is ready
+ * @param timeout_ms Maximum time to wait (0 = poll, -1 = wait forever)
+ * @return HAL_OK if woken, HAL_TIMEOUT if nothing happened, error code otherwise
+ */
+hal_status_t hal_loop_run_once(int timeout_ms);
+
+/**
+ * @brief Dispatch events until hal_loop_stop() is called
+ * @return HAL_OK after a stop, error code otherwise
+ */
+hal_status_t hal_loop_run(void);
+
+/**
+ * @brief Make hal_loop_run() return (safe from other threads and signal handlers)
+ */
+void hal_loop_stop(void);
+
+/*=============================================================================
+ * Logging Functions
+ *============================================================================*/
+
+/*
+ * HAL messages go through one log. Levels above the build's HAL_LOG_MAX_LEVEL
+ * (make LOG_LEVEL=n, default 2 = info) are not compiled in at all. The
+ * runtime level starts from the HAL_LOG_LEVEL environment variable (error,
+ * warn, info, debug, trace or 0-4, default info), and HAL_LOG_STDOUT=0
+ * keeps messages in the ring only. All of these are safe from any thread.
+ */
+
+/**
+ * @brief Set the runtime log level
+ * @param level Messages above this level are dropped
+ */
+void hal_log_set_level(hal_log_level_t level);
+
+/**
+ * @brief Get the runtime log level
+ * @return Current level, from HAL_LOG_LEVEL until set
+ */
+hal_log_level_t hal_log_get_level(void);
+
+/**
+ * @brief Echo messages to stdout or keep them in the ring only
+ * @param enable false keeps the console quiet, the ring still records
+ */
+void hal_log_set_stdout(bool enable);
+
+/**
+ * @brief Write the ring, oldest message first, one timestamped line each
+ * @param fd Destination, e.g. STDERR_FILENO or a file opened for a bug report
+ * @return Number of messages written, -1 if a write failed
+ */
+int hal_log_dump(int fd);
+
 /*=============================================================================
  * HAL System Functions
  *============================================================================*/
@@ -343,4 +1140,8 @@ hal_status_t hal_gpio_init(void);
  */
 hal_status_t hal_gpio_deinit(void);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* HAL_H */
@@ -2,6 +2,10 @@
 #pragma once
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct {
     int w, h;
     int bpp;
@@ -15,3 +19,35 @@ int  hal_ui_info(hal_ui_info_t *out);         // 0 ok, <0 disabled
 void hal_ui_clear(uint32_t color);            // 
 void hal_ui_fill_rect(int x,int y,int w,int h,uint32_t color);
 int  hal_ui_bar3(int cpu,int mem,int temp);   // 0..100, no-op nếu LCD off
+
+// Retained widgets: each caches what it last painted, so an update only
+// repaints the pixels that changed (bars: the strip between old and new length).
+// Changes reach the panel through the LCD dirty-rect flush on hal_ui_render().
+#define HAL_UI_MAX_WIDGETS 32
+
+int  hal_ui_add_bar(int x,int y,int w,int h,uint32_t fg,uint32_t bg);        // horizontal, grows right
+int  hal_ui_add_gauge(int x,int y,int w,int h,int warn,int alarm,uint32_t bg); // vertical, green/amber/red zones
+int  hal_ui_add_sparkline(int x,int y,int w,int h,uint32_t fg,uint32_t bg);  // one column per sample, sweeps left to right
+int  hal_ui_set_value(int id,int value);      // 0..100, <0 on bad id
+int  hal_ui_render(void);                     // swap if anything changed, returns pixels painted since last render
+void hal_ui_reset_widgets(void);              // drop the scene, pixels stay on screen
+
+// Text from precompiled glyph atlases (src/hal/font_data.c, tools/mkfont.py).
+// Strings are colored once into a small run cache keyed by content and then
+// alpha-blended row by row, so redrawing the same text never touches the atlas.
+typedef enum {
+    HAL_UI_FONT_SMALL = 0,    // 10x19 cells, printable ASCII
+    HAL_UI_FONT_LARGE         // 19x38 cells, digits, signs and " %+,-./:ACFVW"
+} hal_ui_font_t;
+
+#define HAL_UI_TEXT_MAX  64   // longer strings are cut
+#define HAL_UI_LABEL_MAX 23   // characters per label
+
+int  hal_ui_text(int x,int y,hal_ui_font_t font,uint32_t color,const char *text); // blended over the screen, returns width or <0
+int  hal_ui_text_size(hal_ui_font_t font,const char *text,int *w,int *h);
+int  hal_ui_add_label(int x,int y,int chars,hal_ui_font_t font,uint32_t fg,uint32_t bg); // fixed-width text field
+int  hal_ui_set_text(int id,const char *text); // repaints only the character cells that changed
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,8 +10,10 @@
  */
 
 #include "../include/hal.h"
+#include "hal/log.h"
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 
 /* HAL Version Information */
 #define HAL_VERSION_MAJOR   1
@@ -21,39 +23,46 @@
 
 /* Global HAL state */
 static bool hal_initialized = false;
+static pthread_mutex_t hal_lock = PTHREAD_MUTEX_INITIALIZER;   /* Serializes hal_init()/hal_deinit() */
 
 hal_status_t hal_init(void)
 {
+    pthread_mutex_lock(&hal_lock);
     if (hal_initialized) {
-        printf("HAL already initialized\n");
+        pthread_mutex_unlock(&hal_lock);
+        LOGI("HAL already initialized");
         return HAL_OK;
     }
 
-    printf("Initializing STM32MP157F-DK2 HAL v%s...\n", HAL_VERSION_STRING);
+    LOGI("Initializing STM32MP157F-DK2 HAL v%s...", HAL_VERSION_STRING);
 
     /* Initialize GPIO subsystem */
     hal_status_t gpio_status = hal_gpio_init();
     if (gpio_status != HAL_OK) {
-        printf("Error: Failed to initialize GPIO subsystem\n");
+        LOGE("Failed to initialize GPIO subsystem");
+        pthread_mutex_unlock(&hal_lock);
         return gpio_status;
     }
 
-    /* Button subsystem is part of GPIO, so no separate init needed */
-    printf("Button subsystem initialized (placeholder)\n");
-
-    hal_initialized = true;
-    printf("HAL initialization complete\n");
+    __atomic_store_n(&hal_initialized, true, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&hal_lock);
+    LOGI("HAL initialization complete");
     return HAL_OK;
 }
 
 hal_status_t hal_deinit(void)
 {
+    pthread_mutex_lock(&hal_lock);
     if (!hal_initialized) {
-        printf("HAL not initialized\n");
+        pthread_mutex_unlock(&hal_lock);
+        LOGI("HAL not initialized");
         return HAL_OK;
     }
 
-    printf("Deinitializing HAL subsystems...\n");
+    LOGI("Deinitializing HAL subsystems...");
+
+    /* Drop loop watches before the descriptors they refer to are closed */
+    hal_loop_deinit();
 
     /* Deinitialize touch subsystem if it was initialized */
     hal_touch_deinit();
@@ -64,10 +73,9 @@ hal_status_t hal_deinit(void)
     /* Deinitialize GPIO subsystem */
     hal_gpio_deinit();
 
-    printf("Button subsystem deinitialized (placeholder)\n");
-
-    hal_initialized = false;
-    printf("HAL deinitialization complete\n");
+    __atomic_store_n(&hal_initialized, false, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&hal_lock);
+    LOGI("HAL deinitialization complete");
     return HAL_OK;
 }
 
@@ -78,5 +86,5 @@ const char* hal_get_version(void)
 
 bool hal_is_initialized(void)
 {
-    return hal_initialized;
+    return __atomic_load_n(&hal_initialized, __ATOMIC_ACQUIRE);
 }
@@ -0,0 +1,48 @@
+/**
+ * @file font.h
+ * @brief Precompiled monospace glyph atlases used by ui_lite
+ *
+ * Each font is a strip of fixed-size cells, one per character of its
+ * charset, with 4-bit coverage packed two pixels per byte (low nibble
+ * first, rows padded to whole bytes). Coverage expands to alpha as
+ * nibble * 17. The tables are produced by tools/mkfont.py and live in
+ * .rodata, so nothing is rasterized at runtime.
+ *
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#ifndef HAL_FONT_H
+#define HAL_FONT_H
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    int cell_w;                 /* Advance and cell width in pixels */
+    int cell_h;                 /* Line height in pixels */
+    int baseline;               /* Baseline offset from the cell top */
+    const char *charset;        /* Characters in atlas order */
+    const uint8_t *alpha;       /* 4bpp coverage, cells back to back */
+} font_t;
+
+extern const font_t font_small;     /* 16px em, printable ASCII */
+extern const font_t font_large;     /* 32px em, digits, units and signs */
+
+/* Bytes per glyph row and per glyph cell */
+static inline int font_row_bytes(const font_t *font)
+{
+    return (font->cell_w + 1) / 2;
+}
+
+/* Coverage rows of character c, or NULL if the font lacks it */
+static inline const uint8_t *font_glyph(const font_t *font, char c)
+{
+    const char *hit = c ? strchr(font->charset, c) : NULL;
+    if (!hit) {
+        return NULL;
+    }
+    return font->alpha + (size_t)(hit - font->charset) * font_row_bytes(font) * font->cell_h;
+}
+
+#endif /* HAL_FONT_H */
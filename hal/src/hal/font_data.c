@@ -0,0 +1,778 @@
+/**
+ * @file font_data.c
+ * @brief Precompiled glyph atlases for ui_lite text
+ * 
+ * Generated by tools/mkfont.py from DejaVu Sans Mono, do not edit.
+ * 4-bit coverage, low nibble first, rows padded to whole bytes.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#include "font.h"
+
+/* small: 16px em, 10x19 cells, 95 glyphs */
+static const uint8_t small_alpha[9025] = {
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,106,0,0,0,0,158,0,0,
+    0,0,158,0,0,0,0,158,0,0,0,0,158,0,0,0,0,158,0,0,0,0,142,0,
+    0,0,0,125,0,0,0,0,35,0,0,0,0,0,0,0,0,0,158,0,0,0,0,158,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,164,64,10,0,0,246,96,15,0,0,
+    246,96,15,0,0,246,96,15,0,0,164,64,10,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,39,96,3,0,32,31,224,4,0,96,
+    13,243,1,64,180,75,217,36,225,254,238,239,158,0,242,2,78,0,0,214,48,31,0,119,
+    203,167,125,4,187,207,235,189,8,32,31,224,4,0,96,13,243,1,0,160,9,183,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,17,0,0,0,0,118,0,0,0,32,152,3,0,0,249,221,
+    222,0,80,63,118,64,0,112,14,118,0,0,80,127,118,0,0,0,248,223,41,0,0,16,
+    184,236,3,0,0,118,208,9,0,0,118,192,10,112,73,135,247,4,48,218,255,92,0,0,
+    0,118,0,0,0,0,118,0,0,0,0,34,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,18,0,0,0,193,238,7,0,0,153,32,46,0,
+    0,91,0,61,0,0,198,132,13,32,7,112,172,83,187,5,0,130,140,2,0,178,91,129,
+    222,5,33,0,198,66,46,0,0,121,0,91,0,0,198,66,46,0,0,144,238,6,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,162,205,8,0,0,205,101,8,0,32,79,0,0,0,
+    16,111,0,0,0,0,233,1,0,0,48,238,11,0,0,225,55,127,0,92,230,0,247,3,
+    77,200,0,160,45,47,246,2,16,237,10,225,60,32,251,7,48,252,255,138,63,0,32,19,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,89,0,0,0,0,125,0,0,0,0,125,0,0,0,
+    0,125,0,0,0,0,89,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,16,2,0,0,0,176,8,0,0,0,244,1,0,0,0,171,0,0,0,16,
+    95,0,0,0,96,31,0,0,0,128,14,0,0,0,160,13,0,0,0,160,13,0,0,0,
+    128,14,0,0,0,96,47,0,0,0,16,95,0,0,0,0,171,0,0,0,0,244,2,0,
+    0,0,176,9,0,0,0,16,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,32,0,0,0,0,208,5,0,0,0,112,13,0,0,0,16,95,0,0,0,0,187,
+    0,0,0,0,247,0,0,0,0,245,3,0,0,0,244,4,0,0,0,244,4,0,0,0,
+    245,3,0,0,0,247,0,0,0,0,187,0,0,0,16,95,0,0,0,112,13,0,0,0,
+    225,5,0,0,0,32,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,56,0,0,48,2,73,64,0,64,124,90,186,1,0,112,223,4,
+    0,0,197,205,58,0,112,25,73,195,2,0,0,73,0,0,0,0,36,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,17,0,0,0,0,124,0,0,
+    0,0,124,0,0,0,0,124,0,0,163,170,222,170,10,147,153,206,153,9,0,0,124,0,
+    0,0,0,124,0,0,0,0,124,0,0,0,0,17,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,86,0,0,0,16,223,0,0,0,32,191,0,0,0,96,79,0,0,0,160,11,0,
+    0,0,48,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,243,255,13,0,0,65,68,3,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,
+    86,0,0,0,48,207,0,0,0,48,207,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,162,3,0,0,0,217,0,0,0,16,111,0,0,0,128,14,0,0,0,225,7,
+    0,0,0,231,1,0,0,0,142,0,0,0,96,47,0,0,0,208,9,0,0,0,245,2,
+    0,0,0,172,0,0,0,64,63,0,0,0,176,11,0,0,0,113,3,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    145,205,7,0,0,221,134,143,0,96,63,0,249,1,176,13,0,244,5,208,11,0,241,7,
+    224,25,140,240,8,224,41,191,240,8,224,10,18,241,8,192,12,0,243,6,128,31,0,247,
+    2,32,175,49,190,0,0,229,255,44,0,0,0,35,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,99,
+    170,1,0,16,255,253,2,0,0,3,247,2,0,0,0,247,2,0,0,0,247,2,0,0,
+    0,247,2,0,0,0,247,2,0,0,0,247,2,0,0,0,247,2,0,0,0,247,2,0,
+    0,84,249,86,3,0,253,255,255,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,48,201,189,
+    6,0,160,141,167,143,0,48,0,0,250,1,0,0,0,247,3,0,0,0,233,1,0,0,
+    48,143,0,0,0,209,11,0,0,16,204,1,0,0,176,45,0,0,0,218,2,0,0,144,
+    127,85,85,1,192,255,255,255,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,201,189,6,
+    0,128,139,167,159,0,0,0,0,249,1,0,0,0,247,2,0,0,32,204,0,0,192,253,
+    27,0,0,96,167,127,0,0,0,0,247,3,0,0,0,242,6,0,0,0,244,5,160,37,
+    82,237,1,176,255,255,60,0,0,49,35,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,112,58,0,
+    0,0,244,95,0,0,0,141,95,0,0,128,75,95,0,0,227,66,95,0,0,140,64,95,
+    0,96,29,64,95,0,225,22,65,95,1,243,255,255,255,13,48,51,99,127,2,0,0,64,
+    95,0,0,0,64,95,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,170,170,90,0,96,
+    191,170,90,0,96,31,0,0,0,96,31,0,0,0,96,159,154,3,0,96,173,234,111,0,
+    0,0,16,236,1,0,0,0,245,4,0,0,0,244,5,0,0,0,247,3,144,37,98,190,
+    0,192,255,255,26,0,0,49,19,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,96,220,108,0,0,250,
+    122,169,0,64,95,0,0,0,160,12,0,0,0,208,73,170,7,0,224,235,153,206,0,224,
+    63,0,245,5,224,13,0,240,8,192,12,0,224,8,128,14,0,242,7,32,159,17,250,2,
+    0,229,255,94,0,0,0,51,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,160,170,170,170,4,160,170,170,
+    252,4,0,0,0,218,0,0,0,16,127,0,0,0,112,47,0,0,0,208,11,0,0,0,
+    243,5,0,0,0,233,0,0,0,16,158,0,0,0,96,63,0,0,0,192,12,0,0,0,
+    243,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,164,205,25,0,64,191,118,206,
+    0,144,30,0,245,4,160,13,0,244,4,80,79,0,233,1,0,230,220,60,0,32,204,135,
+    158,0,176,13,0,244,5,224,9,0,240,9,224,11,0,241,8,144,111,16,250,3,16,250,
+    255,110,0,0,16,51,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,180,205,6,0,80,175,134,143,0,
+    192,12,0,248,1,240,9,0,243,5,240,9,0,243,7,208,11,0,247,8,112,143,83,253,
+    8,0,231,223,244,7,0,0,1,242,5,0,0,0,232,1,16,38,114,143,0,16,254,255,
+    8,0,0,48,19,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,16,69,0,0,0,48,207,0,0,0,48,207,0,0,0,0,17,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,16,86,0,0,0,48,207,0,0,0,48,207,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,16,69,0,0,0,48,207,0,0,0,48,207,0,0,0,0,17,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,86,0,0,0,16,223,0,0,0,32,191,0,0,
+    0,96,79,0,0,0,160,11,0,0,0,48,1,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,80,10,0,0,131,254,9,16,198,207,22,0,227,142,2,0,0,227,142,
+    3,0,0,0,181,207,23,0,0,0,130,254,10,0,0,0,80,10,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,65,68,68,68,3,245,255,255,255,14,16,17,17,17,1,33,34,34,
+    34,2,245,255,255,255,14,65,68,68,68,3,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    148,3,0,0,0,195,207,22,0,0,0,131,238,73,0,0,0,80,250,12,0,0,80,250,
+    12,0,147,238,57,0,211,207,22,0,0,148,3,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,165,221,25,0,16,175,135,191,0,0,2,0,248,1,0,
+    0,0,249,1,0,0,80,143,0,0,0,245,9,0,0,0,174,0,0,0,32,111,0,0,
+    0,32,93,0,0,0,0,0,0,0,0,48,111,0,0,0,48,111,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,113,220,108,0,16,204,53,230,7,176,10,
+    0,64,14,227,1,130,57,62,168,32,190,216,63,123,144,11,48,63,108,176,7,0,62,107,
+    176,8,0,62,137,96,62,145,63,214,0,248,175,61,225,6,0,1,0,64,110,0,0,0,
+    0,212,173,202,0,0,0,116,87,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,32,154,0,0,0,112,255,2,0,0,192,233,7,0,0,242,165,
+    11,0,0,246,97,31,0,0,187,32,95,0,16,127,0,173,0,80,127,85,235,0,160,239,
+    238,254,4,224,9,0,224,9,244,5,0,176,13,248,1,0,96,63,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,112,170,154,22,0,160,158,185,206,1,160,13,0,245,6,160,13,0,242,
+    7,160,13,0,247,3,160,223,237,110,0,160,126,119,220,2,160,13,0,225,10,160,13,0,
+    176,13,160,13,0,208,12,160,94,85,250,6,160,255,255,108,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,64,218,156,2,0,247,123,199,6,32,159,0,0,1,128,31,0,0,0,
+    192,13,0,0,0,208,11,0,0,0,224,11,0,0,0,192,12,0,0,0,160,14,0,0,
+    0,80,111,0,0,0,0,235,21,114,5,0,161,255,239,4,0,0,49,3,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,160,170,105,1,0,224,157,251,61,0,224,10,32,221,0,224,10,0,246,4,224,
+    10,0,242,8,224,10,0,241,9,224,10,0,240,9,224,10,0,241,8,224,10,0,244,6,
+    224,10,0,234,1,224,92,182,111,0,224,255,190,4,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,64,170,170,170,4,112,191,170,170,4,112,47,0,0,0,112,47,0,0,0,112,47,
+    0,0,0,112,223,221,221,3,112,143,119,119,2,112,47,0,0,0,112,47,0,0,0,112,
+    47,0,0,0,112,111,85,85,3,112,255,255,255,9,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,32,170,170,170,7,48,207,170,170,7,48,127,0,0,0,48,127,0,0,0,48,127,0,
+    0,0,48,239,221,221,2,48,175,119,119,1,48,127,0,0,0,48,127,0,0,0,48,127,
+    0,0,0,48,127,0,0,0,48,127,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,96,220,107,0,0,251,121,232,4,96,95,0,16,2,208,12,0,0,0,241,8,0,0,
+    0,243,7,0,0,0,243,7,128,255,9,242,8,48,229,9,224,10,0,208,9,144,30,0,
+    208,9,32,206,19,227,9,0,195,255,207,3,0,0,50,2,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,160,
+    7,0,160,6,224,10,0,240,8,224,10,0,240,8,224,10,0,240,8,224,10,0,240,8,
+    224,222,221,253,8,224,124,119,247,8,224,10,0,240,8,224,10,0,240,8,224,10,0,240,
+    8,224,10,0,240,8,224,10,0,240,8,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,170,
+    170,170,1,64,170,223,170,1,0,0,159,0,0,0,0,159,0,0,0,0,159,0,0,0,
+    0,159,0,0,0,0,159,0,0,0,0,159,0,0,0,0,159,0,0,0,0,159,0,0,
+    32,85,191,85,0,112,255,255,255,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,161,170,
+    90,0,0,161,186,127,0,0,0,32,127,0,0,0,32,127,0,0,0,32,127,0,0,0,
+    32,127,0,0,0,32,127,0,0,0,32,127,0,0,0,32,127,0,0,0,48,111,0,194,
+    21,178,47,0,193,255,239,6,0,0,49,19,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,160,7,0,112,
+    42,224,10,0,248,5,224,10,112,111,0,224,10,246,6,0,224,106,127,0,0,224,254,63,
+    0,0,224,143,205,0,0,224,11,244,8,0,224,10,144,63,0,224,10,16,221,0,224,10,
+    0,245,8,224,10,0,160,79,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,48,58,0,0,0,
+    80,79,0,0,0,80,79,0,0,0,80,79,0,0,0,80,79,0,0,0,80,79,0,0,
+    0,80,79,0,0,0,80,79,0,0,0,80,79,0,0,0,80,79,0,0,0,80,127,85,
+    85,4,80,255,255,255,13,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,163,9,0,163,10,245,
+    63,0,249,14,245,139,0,189,14,245,214,64,141,14,245,226,147,120,14,245,146,232,115,14,
+    245,66,223,112,14,245,2,123,112,14,245,2,0,112,14,245,2,0,112,14,245,2,0,112,
+    14,245,2,0,112,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,160,42,0,160,6,224,143,
+    0,240,8,224,238,1,240,8,224,234,6,240,8,224,137,12,240,8,224,41,63,240,8,224,
+    9,155,240,8,224,9,228,241,8,224,9,208,247,8,224,9,112,253,8,224,9,16,255,8,
+    224,9,0,250,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,162,205,7,0,16,222,135,
+    175,0,128,47,0,247,2,208,12,0,242,7,240,10,0,240,9,241,8,0,224,10,241,8,
+    0,224,10,240,9,0,240,10,224,11,0,241,8,160,14,0,245,4,64,159,49,221,0,0,
+    230,255,45,0,0,16,35,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,170,154,39,0,112,175,169,238,
+    3,112,47,0,242,11,112,47,0,192,13,112,47,0,192,13,112,47,16,247,9,112,255,255,
+    175,1,112,111,69,2,0,112,47,0,0,0,112,47,0,0,0,112,47,0,0,0,112,47,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,162,205,7,0,16,222,135,175,0,
+    128,47,0,247,2,208,12,0,242,7,240,10,0,240,9,241,8,0,224,10,241,8,0,224,
+    10,240,9,0,240,10,224,11,0,241,8,160,14,0,245,5,64,159,49,221,0,0,230,255,
+    61,0,0,16,147,78,0,0,0,0,186,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,144,170,154,4,0,208,157,218,143,0,208,
+    10,0,250,2,208,10,0,245,5,208,10,0,247,3,208,75,100,190,0,208,255,255,9,0,
+    208,27,129,79,0,208,10,0,219,0,208,10,0,244,6,208,10,0,192,13,208,10,0,64,
+    111,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,163,221,106,0,64,207,119,234,0,176,12,
+    0,32,0,208,9,0,0,0,192,62,0,0,0,64,254,157,4,0,0,113,235,175,0,0,
+    0,16,248,5,0,0,0,224,8,0,0,0,241,8,160,55,49,250,3,128,254,255,94,0,
+    0,32,35,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,166,170,170,170,58,166,170,223,170,58,0,0,158,
+    0,0,0,0,158,0,0,0,0,158,0,0,0,0,158,0,0,0,0,158,0,0,0,0,
+    158,0,0,0,0,158,0,0,0,0,158,0,0,0,0,158,0,0,0,0,158,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,144,8,0,161,5,208,11,0,242,7,208,11,0,242,
+    7,208,11,0,242,7,208,11,0,242,7,208,11,0,242,7,208,11,0,242,7,208,11,0,
+    242,7,192,11,0,242,7,176,12,0,243,5,112,111,33,251,1,0,248,255,77,0,0,16,
+    51,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,165,2,0,80,26,243,6,0,176,13,224,10,0,241,8,
+    144,14,0,244,4,80,63,0,232,0,16,127,0,172,0,0,187,16,111,0,0,231,80,31,
+    0,0,242,148,12,0,0,208,215,8,0,0,144,253,3,0,0,64,239,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,106,0,0,0,106,172,0,0,16,127,202,0,0,32,95,232,
+    0,71,64,47,246,48,223,96,15,243,98,252,129,13,241,164,215,148,11,224,214,148,183,8,
+    192,249,97,218,6,144,205,48,254,4,112,159,0,254,2,80,95,0,235,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,161,6,0,112,26,144,30,0,243,7,16,158,0,203,0,0,246,
+    83,63,0,0,176,220,9,0,0,48,239,1,0,0,96,255,3,0,0,225,201,11,0,0,
+    234,49,95,0,64,111,0,233,1,209,11,0,226,9,248,2,0,112,63,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,165,1,0,80,42,225,9,0,225,10,112,63,0,232,2,0,189,32,
+    127,0,0,244,164,29,0,0,176,253,5,0,0,32,207,0,0,0,0,159,0,0,0,0,
+    159,0,0,0,0,159,0,0,0,0,159,0,0,0,0,159,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,96,170,170,170,10,96,170,170,250,13,0,0,0,246,5,0,0,32,174,
+    0,0,0,160,30,0,0,0,245,5,0,0,16,174,0,0,0,160,30,0,0,0,244,5,
+    0,0,16,173,0,0,0,128,111,85,85,21,176,255,255,255,47,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    16,51,3,0,0,96,239,13,0,0,96,31,0,0,0,96,31,0,0,0,96,31,0,0,
+    0,96,31,0,0,0,96,31,0,0,0,96,31,0,0,0,96,31,0,0,0,96,31,0,
+    0,0,96,31,0,0,0,96,31,0,0,0,96,31,0,0,0,96,31,0,0,0,96,255,
+    14,0,0,16,34,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,161,4,0,0,0,160,12,0,0,0,48,79,0,0,0,0,203,0,0,0,0,
+    244,3,0,0,0,192,11,0,0,0,80,63,0,0,0,0,173,0,0,0,0,246,2,0,
+    0,0,208,9,0,0,0,112,30,0,0,0,16,142,0,0,0,0,232,1,0,0,0,113,
+    2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,49,51,
+    0,0,0,228,254,0,0,0,0,247,0,0,0,0,247,0,0,0,0,247,0,0,0,0,
+    247,0,0,0,0,247,0,0,0,0,247,0,0,0,0,247,0,0,0,0,247,0,0,0,
+    0,247,0,0,0,0,247,0,0,0,0,247,0,0,0,0,247,0,0,0,245,255,0,0,
+    0,33,34,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,32,138,0,0,0,192,253,7,0,0,218,82,79,0,112,46,0,230,2,162,3,0,
+    112,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,153,153,153,153,105,0,0,0,0,0,0,0,0,0,0,0,182,1,0,0,0,
+    160,10,0,0,0,16,124,0,0,0,0,33,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,32,217,222,25,0,80,106,84,205,0,0,
+    0,0,244,3,0,97,119,249,4,64,222,154,250,4,192,11,0,243,4,224,8,0,247,4,
+    192,45,64,254,4,48,253,223,246,4,0,48,3,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,3,0,0,0,112,14,0,
+    0,0,112,14,0,0,0,112,14,0,0,0,112,94,237,43,0,112,223,85,220,1,112,95,
+    0,243,6,112,15,0,224,9,112,14,0,192,10,112,15,0,208,10,112,63,0,241,7,112,
+    191,17,234,2,112,142,255,94,0,0,0,50,1,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,96,236,174,2,0,248,73,165,5,32,143,0,
+    0,0,96,47,0,0,0,112,31,0,0,0,96,47,0,0,0,48,111,0,0,0,0,235,
+    5,97,4,0,161,255,239,3,0,0,49,3,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,49,0,0,0,0,245,2,
+    0,0,0,245,2,0,0,0,245,2,0,213,190,246,2,64,159,132,254,2,176,12,0,250,
+    2,224,8,0,246,2,240,7,0,245,2,240,8,0,245,2,192,11,0,248,2,96,95,64,
+    254,2,0,249,239,249,2,0,16,19,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,162,238,42,0,32,206,85,219,1,160,29,0,225,6,
+    224,42,34,194,10,240,238,238,238,10,240,7,0,0,0,176,11,0,0,0,64,143,1,114,
+    4,0,213,255,223,3,0,0,50,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,50,1,0,0,246,255,5,0,0,
+    158,17,0,0,32,95,0,0,96,203,207,187,3,48,118,159,102,2,0,32,95,0,0,0,
+    32,95,0,0,0,32,95,0,0,0,32,95,0,0,0,32,95,0,0,0,32,95,0,0,
+    0,32,95,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,213,190,181,1,64,175,116,254,2,176,12,0,250,2,224,8,
+    0,246,2,240,7,0,245,2,240,8,0,245,2,192,12,0,249,2,80,143,98,254,2,0,
+    231,207,247,2,0,0,1,246,1,0,3,0,203,0,16,223,219,62,0,0,82,87,1,0,
+    0,0,0,0,0,0,0,0,0,0,16,3,0,0,0,112,14,0,0,0,112,14,0,0,
+    0,112,14,0,0,0,112,62,236,60,0,112,206,86,221,0,112,79,0,246,2,112,15,0,
+    244,3,112,14,0,244,3,112,14,0,244,3,112,14,0,244,3,112,14,0,244,3,112,14,
+    0,244,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,34,0,0,0,0,171,0,0,0,0,120,0,0,
+    0,0,0,0,0,0,187,139,0,0,0,102,173,0,0,0,0,171,0,0,0,0,171,0,
+    0,0,0,171,0,0,0,0,171,0,0,0,0,171,0,0,16,34,188,34,1,144,255,255,
+    255,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,49,0,0,0,0,245,2,0,0,0,163,1,0,0,
+    0,0,0,0,0,185,187,1,0,0,101,249,2,0,0,0,245,2,0,0,0,245,2,0,
+    0,0,245,2,0,0,0,245,2,0,0,0,245,2,0,0,0,245,2,0,0,0,245,2,
+    0,0,0,245,2,0,0,0,233,0,0,112,237,111,0,0,48,85,2,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,19,0,0,0,32,95,0,0,0,32,95,0,0,0,32,95,
+    0,0,0,32,95,0,179,5,32,95,64,142,0,32,95,228,7,0,32,159,175,0,0,32,
+    255,236,2,0,32,127,208,12,0,32,95,48,143,0,32,95,0,247,4,32,95,0,176,46,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,48,68,4,0,0,160,237,15,0,0,0,112,15,0,0,0,112,15,
+    0,0,0,112,15,0,0,0,112,15,0,0,0,112,15,0,0,0,112,15,0,0,0,112,
+    15,0,0,0,112,15,0,0,0,96,31,0,0,0,32,159,68,0,0,0,214,255,1,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,177,232,91,221,3,242,89,223,196,10,242,3,157,128,12,242,3,124,112,13,242,3,124,
+    112,13,242,3,124,112,13,242,3,124,112,13,242,3,124,112,13,242,3,124,112,13,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    96,59,236,60,0,112,206,86,221,0,112,79,0,246,2,112,15,0,244,3,112,14,0,244,
+    3,112,14,0,244,3,112,14,0,244,3,112,14,0,244,3,112,14,0,244,3,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    180,222,25,0,48,191,100,206,0,144,30,0,245,4,208,10,0,241,7,224,9,0,224,8,
+    208,10,0,240,8,176,13,0,243,5,80,143,32,236,1,0,247,255,61,0,0,16,35,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,96,91,
+    237,43,0,112,223,85,221,0,112,79,0,243,5,112,15,0,224,9,112,14,0,208,9,112,
+    15,0,208,9,112,63,0,241,6,112,191,17,234,1,112,158,255,78,0,112,14,50,1,0,
+    112,14,0,0,0,112,14,0,0,0,32,4,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,196,190,
+    180,3,48,191,117,254,4,144,14,0,249,4,208,10,0,244,4,224,9,0,243,4,208,10,
+    0,244,4,176,13,0,247,4,80,111,32,253,4,0,248,255,248,4,0,32,20,243,4,0,
+    0,0,243,4,0,0,0,243,4,0,0,0,97,1,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,178,131,237,
+    10,0,243,203,102,11,0,243,12,0,0,0,243,6,0,0,0,243,4,0,0,0,243,4,
+    0,0,0,243,4,0,0,0,243,4,0,0,0,243,4,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,179,238,92,0,
+    16,174,68,135,0,64,63,0,0,0,32,175,3,0,0,0,214,255,43,0,0,0,98,222,
+    0,0,0,0,247,1,48,38,32,220,0,48,254,255,61,0,0,32,35,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,32,3,0,0,0,144,12,0,0,0,144,12,0,0,176,235,190,187,1,96,
+    182,109,102,0,0,144,12,0,0,0,144,12,0,0,0,144,12,0,0,0,144,12,0,0,
+    0,144,12,0,0,0,112,95,34,0,0,16,234,255,1,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,96,11,0,179,2,112,14,
+    0,244,3,112,14,0,244,3,112,14,0,244,3,112,14,0,244,3,112,14,0,244,3,96,
+    31,0,246,3,48,143,49,253,3,0,250,223,247,3,0,32,3,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,177,5,0,144,8,192,11,0,
+    241,6,96,31,0,246,1,16,111,0,171,0,0,187,32,95,0,0,245,113,14,0,0,225,
+    198,9,0,0,160,253,4,0,0,64,239,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,106,0,0,0,106,171,0,0,16,
+    95,231,0,18,64,47,244,2,158,112,13,240,69,220,176,10,192,136,199,227,6,128,204,130,
+    249,2,80,223,48,239,0,16,143,0,190,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,144,9,0,178,5,48,111,0,204,0,
+    0,246,131,46,0,0,160,253,4,0,0,32,207,0,0,0,176,253,6,0,0,232,114,63,
+    0,64,95,0,219,1,226,9,0,225,10,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,177,5,0,112,10,160,12,0,225,8,64,
+    63,0,245,2,0,157,0,187,0,0,232,32,95,0,0,242,117,14,0,0,176,219,9,0,
+    0,80,255,3,0,0,0,206,0,0,0,16,127,0,0,0,128,30,0,0,112,254,7,0,
+    0,48,37,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,48,187,187,187,1,16,102,102,236,1,0,0,
+    64,95,0,0,0,226,8,0,0,16,188,0,0,0,160,29,0,0,0,231,3,0,0,64,
+    143,51,51,0,112,255,255,255,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,34,0,0,0,228,223,
+    0,0,0,203,1,0,0,0,157,0,0,0,0,157,0,0,0,0,157,0,0,0,0,142,
+    0,0,16,166,62,0,0,48,236,26,0,0,0,32,127,0,0,0,0,157,0,0,0,0,
+    157,0,0,0,0,157,0,0,0,0,172,0,0,0,0,248,121,0,0,0,96,152,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,35,0,0,0,0,125,0,0,
+    0,0,125,0,0,0,0,125,0,0,0,0,125,0,0,0,0,125,0,0,0,0,125,0,
+    0,0,0,125,0,0,0,0,125,0,0,0,0,125,0,0,0,0,125,0,0,0,0,125,
+    0,0,0,0,125,0,0,0,0,125,0,0,0,0,125,0,0,0,0,125,0,0,0,0,
+    106,0,0,0,0,0,0,0,0,0,0,0,0,16,18,0,0,0,48,254,27,0,0,0,
+    64,95,0,0,0,0,127,0,0,0,0,126,0,0,0,0,126,0,0,0,0,158,0,0,
+    0,0,232,87,0,0,0,211,189,0,0,0,188,0,0,0,0,142,0,0,0,0,126,0,
+    0,0,0,126,0,0,0,16,111,0,0,32,184,47,0,0,32,137,3,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,0,0,0,177,
+    255,108,66,10,149,68,232,255,8,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,
+};
+
+const font_t font_small = {
+    .cell_w = 10,
+    .cell_h = 19,
+    .baseline = 15,
+    .charset = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~",
+    .alpha = small_alpha
+};
+
+/* large: 32px em, 19x38 cells, 23 glyphs */
+static const uint8_t large_alpha[8740] = {
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,100,4,0,0,
+    0,0,0,0,0,230,255,239,6,0,0,0,0,0,96,255,190,254,111,0,0,0,0,0,
+    225,143,0,128,239,1,0,0,0,0,245,13,0,0,253,5,0,0,0,0,247,10,0,0,
+    249,7,0,0,0,0,246,11,0,0,251,6,0,0,0,0,242,95,0,80,255,2,0,0,
+    32,0,144,255,138,250,159,0,0,113,237,1,0,249,255,255,9,0,164,255,141,1,0,48,
+    152,56,16,215,255,90,0,0,0,0,0,64,250,223,39,0,0,0,0,0,113,253,175,4,
+    0,0,0,0,0,147,254,125,2,112,253,174,2,0,112,255,74,0,16,252,255,255,78,0,
+    48,23,0,0,144,239,38,180,239,1,0,0,0,0,241,79,0,0,252,7,0,0,0,0,
+    243,14,0,0,247,11,0,0,0,0,243,14,0,0,247,11,0,0,0,0,241,79,0,0,
+    252,8,0,0,0,0,144,239,38,179,239,2,0,0,0,0,16,252,255,255,95,0,0,0,
+    0,0,0,112,253,174,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,83,4,0,0,0,0,0,0,0,0,250,14,0,0,
+    0,0,0,0,0,0,250,14,0,0,0,0,0,0,0,0,250,14,0,0,0,0,0,0,
+    0,0,250,14,0,0,0,0,0,0,0,0,250,14,0,0,0,0,0,0,0,0,250,14,
+    0,0,0,0,48,102,102,102,252,110,102,102,86,0,144,255,255,255,255,255,255,255,223,0,
+    144,255,255,255,255,255,255,255,223,0,48,85,85,85,252,94,85,85,69,0,0,0,0,0,
+    250,14,0,0,0,0,0,0,0,0,250,14,0,0,0,0,0,0,0,0,250,14,0,0,
+    0,0,0,0,0,0,250,14,0,0,0,0,0,0,0,0,250,14,0,0,0,0,0,0,
+    0,0,250,14,0,0,0,0,0,0,0,0,67,3,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,16,187,155,0,0,0,0,0,0,0,32,255,207,0,0,0,0,0,0,0,32,255,207,
+    0,0,0,0,0,0,0,48,255,191,0,0,0,0,0,0,0,96,255,79,0,0,0,0,
+    0,0,0,160,255,11,0,0,0,0,0,0,0,224,255,4,0,0,0,0,0,0,0,243,
+    191,0,0,0,0,0,0,0,0,247,63,0,0,0,0,0,0,0,0,117,6,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,17,17,17,17,0,0,0,0,0,112,255,255,255,175,0,
+    0,0,0,0,112,255,255,255,175,0,0,0,0,0,48,119,119,119,87,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,187,107,0,0,0,0,
+    0,0,0,96,255,143,0,0,0,0,0,0,0,96,255,143,0,0,0,0,0,0,0,96,
+    255,143,0,0,0,0,0,0,0,96,255,143,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,16,85,4,0,0,0,
+    0,0,0,0,112,255,7,0,0,0,0,0,0,0,225,239,1,0,0,0,0,0,0,0,
+    246,143,0,0,0,0,0,0,0,0,253,31,0,0,0,0,0,0,0,80,255,9,0,0,
+    0,0,0,0,0,192,255,2,0,0,0,0,0,0,0,244,175,0,0,0,0,0,0,0,
+    0,252,63,0,0,0,0,0,0,0,64,255,11,0,0,0,0,0,0,0,176,255,4,0,
+    0,0,0,0,0,0,243,207,0,0,0,0,0,0,0,0,250,95,0,0,0,0,0,0,
+    0,32,255,13,0,0,0,0,0,0,0,144,255,6,0,0,0,0,0,0,0,225,239,0,
+    0,0,0,0,0,0,0,248,127,0,0,0,0,0,0,0,16,254,30,0,0,0,0,0,
+    0,0,112,255,8,0,0,0,0,0,0,0,208,255,1,0,0,0,0,0,0,0,246,159,
+    0,0,0,0,0,0,0,0,253,47,0,0,0,0,0,0,0,80,255,10,0,0,0,0,
+    0,0,0,192,255,3,0,0,0,0,0,0,0,244,191,0,0,0,0,0,0,0,0,251,
+    79,0,0,0,0,0,0,0,32,238,11,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,113,186,138,2,0,0,0,0,0,96,254,255,255,
+    159,0,0,0,0,0,246,255,190,253,255,10,0,0,0,32,255,143,0,80,254,111,0,0,
+    0,144,255,10,0,0,246,223,0,0,0,225,255,3,0,0,224,255,4,0,0,244,223,0,
+    0,0,144,255,8,0,0,248,159,0,0,0,80,255,12,0,0,250,127,0,0,0,48,255,
+    14,0,0,252,95,0,0,0,16,255,31,0,0,253,95,0,199,25,0,255,47,0,0,253,
+    79,64,255,143,0,255,63,0,0,254,79,96,255,175,0,255,63,0,0,253,79,32,254,79,
+    0,255,63,0,0,253,95,0,82,2,16,255,47,0,0,251,111,0,0,0,32,255,15,0,
+    0,250,143,0,0,0,64,255,13,0,0,247,175,0,0,0,96,255,11,0,0,243,239,0,
+    0,0,160,255,7,0,0,208,255,5,0,0,241,255,2,0,0,112,255,29,0,0,249,191,
+    0,0,0,16,253,207,20,146,255,63,0,0,0,0,227,255,255,255,255,6,0,0,0,0,
+    32,251,255,255,77,0,0,0,0,0,0,32,117,54,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,83,85,1,0,0,0,0,0,133,235,255,255,4,0,0,0,
+    0,32,255,255,255,255,4,0,0,0,0,32,255,223,234,255,4,0,0,0,0,16,88,1,
+    208,255,4,0,0,0,0,0,0,0,208,255,4,0,0,0,0,0,0,0,208,255,4,0,
+    0,0,0,0,0,0,208,255,4,0,0,0,0,0,0,0,208,255,4,0,0,0,0,0,
+    0,0,208,255,4,0,0,0,0,0,0,0,208,255,4,0,0,0,0,0,0,0,208,255,
+    4,0,0,0,0,0,0,0,208,255,4,0,0,0,0,0,0,0,208,255,4,0,0,0,
+    0,0,0,0,208,255,4,0,0,0,0,0,0,0,208,255,4,0,0,0,0,0,0,0,
+    208,255,4,0,0,0,0,0,0,0,208,255,4,0,0,0,0,0,0,0,208,255,4,0,
+    0,0,0,0,0,0,208,255,4,0,0,0,0,0,0,0,208,255,4,0,0,0,0,0,
+    168,170,234,255,171,170,26,0,0,0,251,255,255,255,255,255,47,0,0,0,251,255,255,255,
+    255,255,47,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,64,168,187,105,1,0,0,0,0,146,254,255,255,255,142,0,0,0,0,247,255,255,
+    238,255,255,10,0,0,0,247,142,4,0,146,255,143,0,0,0,118,1,0,0,0,249,239,
+    1,0,0,0,0,0,0,0,241,255,4,0,0,0,0,0,0,0,208,255,6,0,0,0,
+    0,0,0,0,208,255,5,0,0,0,0,0,0,0,241,255,2,0,0,0,0,0,0,0,
+    246,223,0,0,0,0,0,0,0,16,254,95,0,0,0,0,0,0,0,160,255,11,0,0,
+    0,0,0,0,0,247,223,1,0,0,0,0,0,0,80,255,62,0,0,0,0,0,0,0,
+    244,255,4,0,0,0,0,0,0,48,254,95,0,0,0,0,0,0,0,226,255,6,0,0,
+    0,0,0,0,32,253,127,0,0,0,0,0,0,0,209,255,8,0,0,0,0,0,0,16,
+    252,159,0,0,0,0,0,0,0,193,255,9,0,0,0,0,0,0,0,248,255,170,170,170,
+    170,170,6,0,0,249,255,255,255,255,255,255,8,0,0,249,255,255,255,255,255,255,8,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,82,168,
+    187,105,2,0,0,0,0,225,255,255,255,255,159,1,0,0,0,242,255,255,238,255,255,28,
+    0,0,0,226,89,2,0,130,255,143,0,0,0,0,0,0,0,0,246,239,1,0,0,0,
+    0,0,0,0,224,255,3,0,0,0,0,0,0,0,192,255,5,0,0,0,0,0,0,0,
+    224,255,3,0,0,0,0,0,0,0,245,239,0,0,0,0,0,0,0,97,254,111,0,0,
+    0,0,0,185,203,255,239,6,0,0,0,0,0,252,255,255,43,0,0,0,0,0,0,202,
+    220,255,239,6,0,0,0,0,0,0,0,113,254,127,0,0,0,0,0,0,0,0,243,255,
+    2,0,0,0,0,0,0,0,144,255,8,0,0,0,0,0,0,0,80,255,12,0,0,0,
+    0,0,0,0,64,255,13,0,0,0,0,0,0,0,96,255,12,0,0,0,0,0,0,0,
+    192,255,9,0,0,56,0,0,0,0,248,255,4,0,0,253,141,69,67,199,255,175,0,0,
+    0,253,255,255,255,255,255,27,0,0,0,182,254,255,255,255,109,0,0,0,0,0,32,101,
+    103,37,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,81,85,3,
+    0,0,0,0,0,0,0,248,255,9,0,0,0,0,0,0,48,255,255,9,0,0,0,0,
+    0,0,192,239,255,9,0,0,0,0,0,0,247,141,255,9,0,0,0,0,0,32,254,117,
+    255,9,0,0,0,0,0,176,191,112,255,9,0,0,0,0,0,245,47,112,255,9,0,0,
+    0,0,16,254,8,112,255,9,0,0,0,0,144,223,1,112,255,9,0,0,0,0,244,95,
+    0,112,255,9,0,0,0,16,253,11,0,112,255,9,0,0,0,128,255,2,0,112,255,9,
+    0,0,0,243,143,0,0,112,255,9,0,0,0,252,29,0,0,112,255,9,0,0,80,255,
+    39,34,34,130,255,42,18,0,96,255,255,255,255,255,255,255,191,0,96,255,255,255,255,255,
+    255,255,191,0,32,119,119,119,119,183,255,124,87,0,0,0,0,0,0,112,255,9,0,0,
+    0,0,0,0,0,112,255,9,0,0,0,0,0,0,0,112,255,9,0,0,0,0,0,0,
+    0,112,255,9,0,0,0,0,0,0,0,112,255,9,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,48,85,85,85,85,85,5,0,0,0,176,
+    255,255,255,255,255,31,0,0,0,176,255,255,255,255,255,31,0,0,0,176,255,86,85,85,
+    85,5,0,0,0,176,255,2,0,0,0,0,0,0,0,176,255,2,0,0,0,0,0,0,
+    0,176,255,2,0,0,0,0,0,0,0,176,255,2,0,0,0,0,0,0,0,176,255,83,
+    102,20,0,0,0,0,0,176,255,255,255,255,58,0,0,0,0,176,255,255,255,255,255,5,
+    0,0,0,176,141,69,100,250,255,79,0,0,0,32,0,0,0,48,254,207,0,0,0,0,
+    0,0,0,0,244,255,4,0,0,0,0,0,0,0,192,255,8,0,0,0,0,0,0,0,
+    128,255,10,0,0,0,0,0,0,0,112,255,10,0,0,0,0,0,0,0,128,255,10,0,
+    0,0,0,0,0,0,176,255,8,0,0,0,0,0,0,0,243,255,4,0,0,38,0,0,
+    0,32,253,207,0,0,0,251,140,53,83,233,255,63,0,0,0,251,255,255,255,255,239,4,
+    0,0,0,215,255,255,255,255,42,0,0,0,0,0,66,118,103,20,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,32,167,187,122,3,0,0,0,0,16,249,255,255,
+    255,127,0,0,0,0,193,255,255,238,255,127,0,0,0,0,251,239,23,0,64,121,0,0,
+    0,80,255,62,0,0,0,0,0,0,0,192,255,5,0,0,0,0,0,0,0,242,223,0,
+    0,0,0,0,0,0,0,246,127,0,0,0,0,0,0,0,0,249,79,0,99,86,2,0,
+    0,0,0,251,47,195,255,255,191,2,0,0,0,253,63,254,255,255,255,62,0,0,0,253,
+    207,191,20,81,253,223,1,0,0,254,255,10,0,0,209,255,7,0,0,253,255,2,0,0,
+    96,255,12,0,0,253,191,0,0,0,32,255,15,0,0,252,159,0,0,0,0,255,47,0,
+    0,250,143,0,0,0,0,254,63,0,0,247,159,0,0,0,0,254,47,0,0,244,191,0,
+    0,0,32,255,15,0,0,224,255,1,0,0,96,255,12,0,0,144,255,10,0,0,209,255,
+    7,0,0,16,254,191,3,65,252,223,1,0,0,0,244,255,255,255,255,62,0,0,0,0,
+    48,251,255,255,175,2,0,0,0,0,0,32,117,86,1,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,84,85,85,85,85,85,85,4,0,0,252,255,255,255,255,255,255,13,0,
+    0,252,255,255,255,255,255,255,10,0,0,84,85,85,85,85,213,255,4,0,0,0,0,0,
+    0,0,242,239,0,0,0,0,0,0,0,0,248,143,0,0,0,0,0,0,0,0,253,47,
+    0,0,0,0,0,0,0,64,255,12,0,0,0,0,0,0,0,160,255,6,0,0,0,0,
+    0,0,0,241,239,1,0,0,0,0,0,0,0,247,175,0,0,0,0,0,0,0,0,253,
+    79,0,0,0,0,0,0,0,64,255,13,0,0,0,0,0,0,0,160,255,7,0,0,0,
+    0,0,0,0,241,255,2,0,0,0,0,0,0,0,247,191,0,0,0,0,0,0,0,0,
+    252,95,0,0,0,0,0,0,0,48,255,30,0,0,0,0,0,0,0,144,255,9,0,0,
+    0,0,0,0,0,225,255,3,0,0,0,0,0,0,0,246,223,0,0,0,0,0,0,0,
+    0,252,127,0,0,0,0,0,0,0,48,255,31,0,0,0,0,0,0,0,144,255,11,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,132,186,155,5,0,0,0,0,0,195,255,255,255,239,5,0,0,0,32,254,255,
+    172,235,255,111,0,0,0,192,255,45,0,16,250,239,1,0,0,242,255,3,0,0,208,255,
+    6,0,0,245,223,0,0,0,144,255,9,0,0,246,191,0,0,0,112,255,10,0,0,244,
+    207,0,0,0,128,255,8,0,0,224,255,2,0,0,192,255,3,0,0,96,255,27,0,0,
+    248,175,0,0,0,0,247,239,138,217,255,26,0,0,0,0,32,252,255,255,77,0,0,0,
+    0,0,230,255,239,255,255,25,0,0,0,128,255,93,1,64,252,207,0,0,0,243,239,2,
+    0,0,192,255,7,0,0,249,143,0,0,0,64,255,13,0,0,253,79,0,0,0,0,255,
+    47,0,0,254,79,0,0,0,0,254,63,0,0,254,95,0,0,0,16,255,63,0,0,252,
+    159,0,0,0,64,255,31,0,0,247,255,3,0,0,193,255,11,0,0,209,255,126,2,81,
+    252,255,3,0,0,48,254,255,255,255,255,111,0,0,0,0,145,255,255,255,191,3,0,0,
+    0,0,0,65,118,86,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,149,
+    187,122,2,0,0,0,0,0,212,255,255,255,159,0,0,0,0,64,255,255,188,253,255,10,
+    0,0,0,225,255,27,0,80,254,111,0,0,0,246,223,1,0,0,245,223,0,0,0,251,
+    127,0,0,0,192,255,4,0,0,254,63,0,0,0,128,255,8,0,0,255,47,0,0,0,
+    96,255,11,0,0,255,47,0,0,0,96,255,13,0,0,254,47,0,0,0,112,255,15,0,
+    0,252,95,0,0,0,160,255,31,0,0,248,175,0,0,0,242,255,31,0,0,242,255,5,
+    0,16,251,255,31,0,0,144,255,175,102,216,207,253,31,0,0,0,250,255,255,255,46,253,
+    15,0,0,0,80,251,255,158,1,255,13,0,0,0,0,0,34,0,32,255,11,0,0,0,
+    0,0,0,0,96,255,8,0,0,0,0,0,0,0,192,255,4,0,0,0,0,0,0,0,
+    245,223,0,0,0,16,1,0,0,64,254,95,0,0,0,80,158,53,83,250,255,10,0,0,
+    0,80,255,255,255,255,191,1,0,0,0,48,252,255,255,223,6,0,0,0,0,0,32,101,
+    103,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,48,153,89,0,0,0,0,
+    0,0,0,96,255,143,0,0,0,0,0,0,0,96,255,143,0,0,0,0,0,0,0,96,
+    255,143,0,0,0,0,0,0,0,96,255,143,0,0,0,0,0,0,0,16,34,18,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,64,187,107,0,0,0,0,
+    0,0,0,96,255,143,0,0,0,0,0,0,0,96,255,143,0,0,0,0,0,0,0,96,
+    255,143,0,0,0,0,0,0,0,96,255,143,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,32,85,53,0,0,0,0,0,0,
+    0,128,255,207,0,0,0,0,0,0,0,208,255,255,2,0,0,0,0,0,0,242,239,255,
+    6,0,0,0,0,0,0,247,111,255,11,0,0,0,0,0,0,251,31,252,31,0,0,0,
+    0,0,16,255,12,248,95,0,0,0,0,0,96,255,7,244,175,0,0,0,0,0,160,255,
+    3,224,239,0,0,0,0,0,224,239,0,160,255,4,0,0,0,0,244,175,0,96,255,8,
+    0,0,0,0,249,111,0,32,255,13,0,0,0,0,253,47,0,0,253,47,0,0,0,48,
+    255,12,0,0,249,127,0,0,0,128,255,8,0,0,244,207,0,0,0,192,255,155,153,153,
+    250,255,1,0,0,242,255,255,255,255,255,255,6,0,0,246,255,238,238,238,238,255,10,0,
+    0,251,111,0,0,0,32,255,30,0,16,255,31,0,0,0,0,253,95,0,80,255,12,0,
+    0,0,0,249,159,0,160,255,8,0,0,0,0,244,239,0,224,255,4,0,0,0,0,224,
+    255,3,244,239,0,0,0,0,0,176,255,8,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,132,186,155,22,0,0,0,0,0,212,255,255,
+    255,255,7,0,0,0,112,255,255,206,253,255,11,0,0,0,245,255,58,0,16,214,11,0,
+    0,16,254,143,0,0,0,0,5,0,0,128,255,12,0,0,0,0,0,0,0,224,255,5,
+    0,0,0,0,0,0,0,244,255,1,0,0,0,0,0,0,0,247,207,0,0,0,0,0,
+    0,0,0,250,175,0,0,0,0,0,0,0,0,251,143,0,0,0,0,0,0,0,0,252,
+    127,0,0,0,0,0,0,0,0,252,127,0,0,0,0,0,0,0,0,252,127,0,0,0,
+    0,0,0,0,0,251,143,0,0,0,0,0,0,0,0,249,175,0,0,0,0,0,0,0,
+    0,246,223,0,0,0,0,0,0,0,0,243,255,2,0,0,0,0,0,0,0,208,255,7,
+    0,0,0,0,0,0,0,96,255,30,0,0,0,0,0,0,0,0,253,207,1,0,0,48,
+    9,0,0,0,227,255,126,35,82,250,11,0,0,0,64,254,255,255,255,255,11,0,0,0,
+    0,145,254,255,255,191,4,0,0,0,0,0,64,118,70,1,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,32,85,85,85,85,85,85,37,0,0,96,255,255,255,255,255,255,111,0,
+    0,96,255,255,255,255,255,255,111,0,0,96,255,93,85,85,85,85,37,0,0,96,255,12,
+    0,0,0,0,0,0,0,96,255,12,0,0,0,0,0,0,0,96,255,12,0,0,0,0,
+    0,0,0,96,255,12,0,0,0,0,0,0,0,96,255,12,0,0,0,0,0,0,0,96,
+    255,12,0,0,0,0,0,0,0,96,255,206,204,204,204,204,5,0,0,96,255,255,255,255,
+    255,255,6,0,0,96,255,223,221,221,221,221,5,0,0,96,255,12,0,0,0,0,0,0,
+    0,96,255,12,0,0,0,0,0,0,0,96,255,12,0,0,0,0,0,0,0,96,255,12,
+    0,0,0,0,0,0,0,96,255,12,0,0,0,0,0,0,0,96,255,12,0,0,0,0,
+    0,0,0,96,255,12,0,0,0,0,0,0,0,96,255,12,0,0,0,0,0,0,0,96,
+    255,12,0,0,0,0,0,0,0,96,255,12,0,0,0,0,0,0,0,96,255,12,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    80,85,1,0,0,0,0,64,85,1,208,255,6,0,0,0,0,242,255,2,144,255,10,0,
+    0,0,0,246,223,0,64,255,14,0,0,0,0,250,143,0,0,254,63,0,0,0,0,254,
+    79,0,0,250,111,0,0,0,48,255,14,0,0,246,175,0,0,0,112,255,10,0,0,242,
+    239,0,0,0,176,255,6,0,0,192,255,3,0,0,224,255,1,0,0,128,255,7,0,0,
+    243,207,0,0,0,48,255,11,0,0,247,127,0,0,0,0,254,31,0,0,251,63,0,0,
+    0,0,250,79,0,16,255,14,0,0,0,0,245,143,0,64,255,9,0,0,0,0,241,207,
+    0,128,255,5,0,0,0,0,192,255,1,192,255,1,0,0,0,0,112,255,5,241,191,0,
+    0,0,0,0,48,255,9,245,127,0,0,0,0,0,0,253,13,249,47,0,0,0,0,0,
+    0,249,47,253,13,0,0,0,0,0,0,245,143,255,9,0,0,0,0,0,0,241,255,255,
+    4,0,0,0,0,0,0,176,255,239,0,0,0,0,0,0,0,96,255,175,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,85,5,0,0,
+    0,0,0,0,84,5,253,63,0,0,0,0,0,0,254,15,251,79,0,0,0,0,0,0,
+    255,15,249,111,0,0,0,0,0,32,255,13,246,143,0,0,0,0,0,64,255,10,244,175,
+    0,0,0,0,0,96,255,8,242,191,0,0,0,0,0,112,255,6,240,223,0,32,238,94,
+    0,144,255,4,192,255,0,80,255,159,0,176,255,1,160,255,2,128,255,207,0,208,239,0,
+    128,255,4,176,207,255,0,240,207,0,96,255,5,224,111,255,3,241,175,0,64,255,7,243,
+    31,253,6,243,127,0,16,255,9,246,13,249,10,245,95,0,0,254,11,249,9,246,13,247,
+    63,0,0,252,12,252,6,242,31,248,31,0,0,250,30,255,3,224,79,250,13,0,0,247,
+    79,239,0,160,127,252,11,0,0,245,159,191,0,112,191,254,9,0,0,243,239,127,0,48,
+    239,255,7,0,0,241,255,79,0,0,255,255,5,0,0,208,255,31,0,0,252,255,2,0,
+    0,176,255,12,0,0,248,255,0,0,0,144,255,9,0,0,245,223,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,
+};
+
+const font_t font_large = {
+    .cell_w = 19,
+    .cell_h = 38,
+    .baseline = 30,
+    .charset = " %+,-./0123456789:ACFVW",
+    .alpha = large_alpha
+};
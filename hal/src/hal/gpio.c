@@ -5,6 +5,11 @@
  * This module provides GPIO control for the 4 user LEDs on the STM32MP157F-DK2
  * board using the Linux sysfs interface.
  * 
+ * Buttons are read through the GPIO character device (v2 line requests
+ * with kernel debounce and edge events). When the lines are already
+ * claimed by the gpio-keys driver, its evdev node is used instead.
+ * Either way there is one pollable descriptor and no sampling loop.
+ * 
  * LED Mapping (STM32MP157F-DK2):
  * - Green LED  : LD4 (PA14)
  * - Orange LED : LD7 (PH7)  
@@ -12,27 +17,104 @@
  * - Blue LED   : LD8 (PD11)
  * 
  * These LEDs are accessible via /sys/class/leds/ interface
+ * 
+ * Blink and pattern animations are handed to the kernel timer, pattern
+ * and oneshot LED triggers. When a trigger is not built into the kernel
+ * a single background thread steps the animation instead.
  */
 
+#define _GNU_SOURCE
 #include "../../include/hal.h"
+#include "log.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <dirent.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <linux/input.h>
 
-/* LED sysfs paths for STM32MP157F-DK2 */
-static const char* led_paths[HAL_LED_COUNT] = {
-    "/sys/class/leds/green:usr0/brightness",   /* HAL_LED_GREEN */
-    "/sys/class/leds/red:usr1/brightness",     /* HAL_LED_RED */
-    "/sys/class/leds/orange:usr2/brightness",  /* HAL_LED_ORANGE */
-    "/sys/class/leds/blue:usr3/brightness"     /* HAL_LED_BLUE */
+/* LED sysfs directories for STM32MP157F-DK2 */
+static const char* led_dirs[HAL_LED_COUNT] = {
+    "/sys/class/leds/green:usr0",   /* HAL_LED_GREEN */
+    "/sys/class/leds/red:usr1",     /* HAL_LED_RED */
+    "/sys/class/leds/orange:usr2",  /* HAL_LED_ORANGE */
+    "/sys/class/leds/blue:usr3"     /* HAL_LED_BLUE */
 };
 
+/* Button lines on GPIOA (USER1 = PA14, USER2 = PA13), active low */
+#define BUTTON_GPIO_CHIP        "/dev/gpiochip0"
+#define BUTTON_DEBOUNCE_US      10000
+#define BUTTON_KEYS_NAME        "gpio-keys"
+static const uint32_t button_offsets[HAL_BUTTON_COUNT] = { 14, 13 };
+static const uint16_t button_codes[HAL_BUTTON_COUNT] = { BTN_1, BTN_2 };    /* gpio-keys fallback */
+
+typedef enum {
+    BUTTON_BACKEND_NONE = 0,
+    BUTTON_BACKEND_GPIO,            /* Line request fd from GPIO_V2_GET_LINE_IOCTL */
+    BUTTON_BACKEND_EVDEV            /* gpio-keys input device */
+} button_backend_t;
+
+/* Animation currently driving an LED */
+typedef enum {
+    LED_ANIM_NONE = 0,
+    LED_ANIM_TRIGGER,               /* Kernel timer or pattern trigger owns the LED */
+    LED_ANIM_ONESHOT,               /* Kernel oneshot trigger, on for led_shot_ms */
+    LED_ANIM_SOFTWARE               /* Stepped by soft_thread */
+} led_anim_t;
+
+typedef struct {
+    hal_led_step_t steps[HAL_LED_MAX_STEPS];
+    int count;
+    int repeat;                     /* Remaining passes, -1 = forever */
+    int index;                      /* Step currently shown */
+    struct timespec deadline;       /* When the next step starts */
+} led_sequence_t;
+
 /* Internal state tracking */
 static bool gpio_initialized = false;
 static hal_led_state_t led_states[HAL_LED_COUNT] = {HAL_LED_OFF, HAL_LED_OFF, HAL_LED_OFF, HAL_LED_OFF};
+static int led_fds[HAL_LED_COUNT] = {-1, -1, -1, -1};  /* brightness files, open while initialized */
+static led_anim_t led_anims[HAL_LED_COUNT];
+static uint32_t led_shot_ms[HAL_LED_COUNT];            /* delay_on of an active oneshot trigger */
+
+/*
+ * led_lock serializes the public LED calls. The fallback thread only takes
+ * soft_lock, so led_states is written with atomics from both sides.
+ * Lock order is led_lock, then soft_lock.
+ */
+static pthread_mutex_t led_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Software fallback, one thread for all LEDs */
+static pthread_mutex_t soft_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t soft_cond;
+static pthread_t soft_thread;
+static bool soft_running = false;
+static bool soft_stop = false;
+static led_sequence_t soft_sequences[HAL_LED_COUNT];
+
+/* Buttons */
+static button_backend_t button_backend = BUTTON_BACKEND_NONE;
+static int button_fd = -1;
+
+static hal_status_t write_led(hal_led_t led, hal_led_state_t state);
+static hal_status_t write_attr(hal_led_t led, const char *attr, const char *value);
+static hal_status_t stop_animation(hal_led_t led);
+static hal_status_t led_set_state(hal_led_t led, hal_led_state_t state);
+static hal_status_t led_get_state(hal_led_t led, hal_led_state_t *state);
+static hal_status_t led_toggle(hal_led_t led);
+static hal_status_t led_set_pattern(uint8_t pattern);
+static hal_status_t led_blink(hal_led_t led, uint32_t on_ms, uint32_t off_ms);
+static hal_status_t led_pattern_sequence(hal_led_t led, const hal_led_step_t *steps, int count, int repeat);
+static hal_status_t led_flash(hal_led_t led, uint32_t on_ms);
+static hal_status_t start_software(hal_led_t led, const hal_led_step_t *steps, int count, int repeat);
+static void *soft_main(void *arg);
 
 /* Helper function to write to sysfs file */
 static hal_status_t write_sysfs_file(const char* path, const char* value)
@@ -41,9 +123,8 @@ static hal_status_t write_sysfs_file(const char* path, const char* value)
     ssize_t bytes_written;
     size_t value_len;
     
-    fd = open(path, O_WRONLY);
+    fd = open(path, O_WRONLY | O_CLOEXEC);
     if (fd < 0) {
-        printf("Error: Could not open %s for writing: %s\n", path, strerror(errno));
         return HAL_ERROR;
     }
     
@@ -52,93 +133,135 @@ static hal_status_t write_sysfs_file(const char* path, const char* value)
     close(fd);
     
     if (bytes_written != (ssize_t)value_len) {
-        printf("Error: Could not write to %s: %s\n", path, strerror(errno));
         return HAL_ERROR;
     }
     
     return HAL_OK;
 }
 
-/* Helper function to read from sysfs file */
-static hal_status_t read_sysfs_file(const char* path, char* buffer, size_t buffer_size)
+/* Write a file in the LED's sysfs directory */
+static hal_status_t write_attr(hal_led_t led, const char *attr, const char *value)
 {
-    int fd;
+    char path[96];
+    snprintf(path, sizeof(path), "%s/%s", led_dirs[led], attr);
+    return write_sysfs_file(path, value);
+}
+
+/* Write a brightness value through the cached descriptor */
+static hal_status_t write_led(hal_led_t led, hal_led_state_t state)
+{
+    const char *value = (state == HAL_LED_ON) ? "1" : "0";
+
+    if (led_fds[led] < 0) {
+        return HAL_ERROR;
+    }
+
+    if (pwrite(led_fds[led], value, 1, 0) != 1) {
+        LOG_RATELIMIT(HAL_LOG_ERROR, 1000, "Could not write LED %d brightness: %s", led, strerror(errno));
+        return HAL_ERROR;
+    }
+
+    __atomic_store_n(&led_states[led], state, __ATOMIC_RELAXED);
+    return HAL_OK;
+}
+
+/* Read the brightness back from sysfs, the file is regenerated on every read at offset 0 */
+static hal_status_t read_led(hal_led_t led, hal_led_state_t *state)
+{
+    char buffer[16];
     ssize_t bytes_read;
-    
-    fd = open(path, O_RDONLY);
-    if (fd < 0) {
-        printf("Error: Could not open %s for reading: %s\n", path, strerror(errno));
+
+    if (led_fds[led] < 0) {
         return HAL_ERROR;
     }
-    
-    bytes_read = read(fd, buffer, buffer_size - 1);
-    close(fd);
-    
+
+    bytes_read = pread(led_fds[led], buffer, sizeof(buffer) - 1, 0);
     if (bytes_read < 0) {
-        printf("Error: Could not read from %s: %s\n", path, strerror(errno));
+        LOG_RATELIMIT(HAL_LOG_ERROR, 1000, "Could not read LED %d brightness: %s", led, strerror(errno));
         return HAL_ERROR;
     }
-    
+
     buffer[bytes_read] = '\0';
+    *state = (atoi(buffer) > 0) ? HAL_LED_ON : HAL_LED_OFF;
     return HAL_OK;
 }
 
 hal_status_t hal_led_init(void)
 {
+    pthread_mutex_lock(&led_lock);
     if (gpio_initialized) {
+        pthread_mutex_unlock(&led_lock);
         return HAL_OK;
     }
     
-    printf("Initializing GPIO/LED subsystem...\n");
+    LOGI("Initializing GPIO/LED subsystem...");
 
-    // Safely check if LED sysfs paths exist
-    printf("Checking LED paths...\n");
-    
-    for (int i = 0; i < HAL_LED_COUNT; i++) {
-        printf("Checking LED %d: %s\n", i, led_paths[i]);
-        if (led_paths[i] != NULL && access(led_paths[i], F_OK) == 0) {
-            printf("  -> Available\n");
-        } else {
-            printf("  -> Not available\n");
-        }
-    }
+    /* Open each brightness file once, later updates are a single pwrite */
+    LOGD("Opening LED brightness files...");
 
-    // Initialize LED states array safely
     for (int i = 0; i < HAL_LED_COUNT; i++) {
+        char path[96];
+        snprintf(path, sizeof(path), "%s/brightness", led_dirs[i]);
+
         led_states[i] = HAL_LED_OFF;
+        led_anims[i] = LED_ANIM_NONE;
+        led_fds[i] = open(path, O_RDWR | O_CLOEXEC);
+        if (led_fds[i] < 0) {
+            LOGD("LED %d: %s -> Not available (%s)", i, path, strerror(errno));
+            continue;
+        }
+
+        /* Start from the current brightness so toggling from the cache is correct */
+        read_led((hal_led_t)i, &led_states[i]);
+        LOGD("LED %d: %s -> Available", i, path);
     }
 
     gpio_initialized = true;
-    printf("GPIO/LED subsystem initialized successfully\n");
+    pthread_mutex_unlock(&led_lock);
+    LOGI("GPIO/LED subsystem initialized successfully");
     return HAL_OK;
 }
 
 hal_status_t hal_led_deinit(void)
 {
+    pthread_mutex_lock(&led_lock);
     if (!gpio_initialized) {
+        pthread_mutex_unlock(&led_lock);
         return HAL_OK;
     }
 
-    printf("Deinitializing GPIO/LED subsystem...\n");
+    LOGI("Deinitializing GPIO/LED subsystem...");
     /* Turn off all LEDs */
     for (int i = 0; i < HAL_LED_COUNT; i++) {
-        hal_led_set_state((hal_led_t)i, HAL_LED_OFF);
+        led_set_state((hal_led_t)i, HAL_LED_OFF);
+    }
+
+    /* Every animation is stopped now, the fallback thread can go */
+    if (soft_running) {
+        pthread_mutex_lock(&soft_lock);
+        soft_stop = true;
+        pthread_cond_signal(&soft_cond);
+        pthread_mutex_unlock(&soft_lock);
+        pthread_join(soft_thread, NULL);
+        pthread_cond_destroy(&soft_cond);
+        soft_running = false;
+    }
+
+    for (int i = 0; i < HAL_LED_COUNT; i++) {
+        if (led_fds[i] >= 0) {
+            close(led_fds[i]);
+            led_fds[i] = -1;
+        }
     }
 
     gpio_initialized = false;
-    printf("GPIO/LED subsystem deinitialized\n");
+    pthread_mutex_unlock(&led_lock);
+    LOGI("GPIO/LED subsystem deinitialized");
     return HAL_OK;
 }
 
-hal_status_t hal_led_set_state(hal_led_t led, hal_led_state_t state)
+static hal_status_t led_set_state(hal_led_t led, hal_led_state_t state)
 {
-    hal_status_t status;
-    const char* value;
-    
-    if (!gpio_initialized) {
-        return HAL_ERROR;
-    }
-
     if (led >= HAL_LED_COUNT) {
         return HAL_INVALID_PARAM;
     }
@@ -147,82 +270,63 @@ hal_status_t hal_led_set_state(hal_led_t led, hal_led_state_t state)
         return HAL_INVALID_PARAM;
     }
 
-    value = (state == HAL_LED_ON) ? "1" : "0";
-    status = write_sysfs_file(led_paths[led], value);
-    
-    if (status == HAL_OK) {
-        led_states[led] = state;
-        printf("LED %d set to %s\n", led, (state == HAL_LED_ON) ? "ON" : "OFF");
+    /* A static state replaces any running animation */
+    if (led_anims[led] != LED_ANIM_NONE) {
+        stop_animation(led);
     }
-    
-    return status;
+
+    return write_led(led, state);
 }
 
-hal_status_t hal_led_get_state(hal_led_t led, hal_led_state_t *state)
+static hal_status_t led_get_state(hal_led_t led, hal_led_state_t *state)
 {
-    char buffer[16];
     hal_status_t status;
     
-    if (!gpio_initialized) {
-        return HAL_ERROR;
-    }
-    
     if (led >= HAL_LED_COUNT || state == NULL) {
         return HAL_INVALID_PARAM;
     }
 
-    status = read_sysfs_file(led_paths[led], buffer, sizeof(buffer));
+    status = read_led(led, state);
     if (status != HAL_OK) {
         return status;
     }
 
-    /* Parse the brightness value */
-    int brightness = atoi(buffer);
-    *state = (brightness > 0) ? HAL_LED_ON : HAL_LED_OFF;
-    led_states[led] = *state;
-    
+    __atomic_store_n(&led_states[led], *state, __ATOMIC_RELAXED);
     return HAL_OK;
 }
 
-hal_status_t hal_led_toggle(hal_led_t led)
+static hal_status_t led_toggle(hal_led_t led)
 {
-    hal_led_state_t current_state;
-    hal_status_t status;
-    
-    if (!gpio_initialized) {
-        return HAL_ERROR;
-    }
-
     if (led >= HAL_LED_COUNT) {
         return HAL_INVALID_PARAM;
     }
     
-    status = hal_led_get_state(led, &current_state);
-    if (status != HAL_OK) {
-        return status;
+    if (led_anims[led] != LED_ANIM_NONE) {
+        stop_animation(led);
     }
-    
-    /* Toggle the state */
-    hal_led_state_t new_state = (current_state == HAL_LED_ON) ? HAL_LED_OFF : HAL_LED_ON;
-    return hal_led_set_state(led, new_state);
+
+    /* Every write goes through led_states, no need to read sysfs back */
+    hal_led_state_t current = __atomic_load_n(&led_states[led], __ATOMIC_RELAXED);
+    hal_led_state_t new_state = (current == HAL_LED_ON) ? HAL_LED_OFF : HAL_LED_ON;
+    return write_led(led, new_state);
 }
 
-hal_status_t hal_led_set_pattern(uint8_t pattern)
+static hal_status_t led_set_pattern(uint8_t pattern)
 {
     hal_status_t status;
     
-    if (!gpio_initialized) {
-        return HAL_ERROR;
-    }
-    
-    printf("Setting LED pattern: 0x%02X\n", pattern);
-    
-    /* Set each LED based on the corresponding bit */
+    /* Set each LED based on the corresponding bit, leaving unchanged ones alone */
     for (int i = 0; i < HAL_LED_COUNT; i++) {
         hal_led_state_t state = (pattern & (1 << i)) ? HAL_LED_ON : HAL_LED_OFF;
-        status = hal_led_set_state((hal_led_t)i, state);
+        if (led_anims[i] != LED_ANIM_NONE) {
+            stop_animation((hal_led_t)i);
+        } else if (state == __atomic_load_n(&led_states[i], __ATOMIC_RELAXED)) {
+            continue;
+        }
+
+        status = write_led((hal_led_t)i, state);
         if (status != HAL_OK) {
-            printf("Error setting LED %d\n", i);
+            LOGE("Cannot set LED %d", i);
             return status;
         }
     }
@@ -230,16 +334,403 @@ hal_status_t hal_led_set_pattern(uint8_t pattern)
     return HAL_OK;
 }
 
-/* Button functions - placeholder implementations */
-hal_status_t hal_button_init(void)
+static hal_status_t led_blink(hal_led_t led, uint32_t on_ms, uint32_t off_ms)
+{
+    char value[16];
+
+    if (led >= HAL_LED_COUNT || on_ms == 0 || off_ms == 0) {
+        return HAL_INVALID_PARAM;
+    }
+
+    stop_animation(led);
+
+    /* delay_on/delay_off only exist once the timer trigger is active */
+    if (write_attr(led, "trigger", "timer") == HAL_OK) {
+        snprintf(value, sizeof(value), "%u", on_ms);
+        hal_status_t status = write_attr(led, "delay_on", value);
+        snprintf(value, sizeof(value), "%u", off_ms);
+        if (status == HAL_OK) {
+            status = write_attr(led, "delay_off", value);
+        }
+        if (status == HAL_OK) {
+            led_anims[led] = LED_ANIM_TRIGGER;
+            return HAL_OK;
+        }
+        write_attr(led, "trigger", "none");
+    }
+
+    const hal_led_step_t steps[] = {
+        { HAL_LED_ON,  on_ms },
+        { HAL_LED_OFF, off_ms },
+    };
+    return start_software(led, steps, 2, -1);
+}
+
+static hal_status_t led_pattern_sequence(hal_led_t led, const hal_led_step_t *steps, int count, int repeat)
+{
+    if (led >= HAL_LED_COUNT || steps == NULL || count <= 0 || count > HAL_LED_MAX_STEPS || repeat == 0) {
+        return HAL_INVALID_PARAM;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (steps[i].duration_ms == 0) {
+            return HAL_INVALID_PARAM;
+        }
+    }
+
+    stop_animation(led);
+
+    /*
+     * The pattern trigger ramps linearly between entries, so each step is
+     * written twice (hold for its duration, then jump in 0 ms) to get
+     * square transitions.
+     */
+    if (write_attr(led, "trigger", "pattern") == HAL_OK) {
+        char pattern[HAL_LED_MAX_STEPS * 32];
+        char value[16];
+        size_t len = 0;
+
+        for (int i = 0; i < count; i++) {
+            int brightness = (steps[i].state == HAL_LED_ON) ? 1 : 0;
+            len += snprintf(pattern + len, sizeof(pattern) - len, "%d %u %d 0 ",
+                            brightness, steps[i].duration_ms, brightness);
+        }
+        snprintf(value, sizeof(value), "%d", repeat);
+
+        /* repeat must be set before pattern, writing pattern restarts it */
+        if (write_attr(led, "repeat", value) == HAL_OK && write_attr(led, "pattern", pattern) == HAL_OK) {
+            led_anims[led] = LED_ANIM_TRIGGER;
+            return HAL_OK;
+        }
+        write_attr(led, "trigger", "none");
+    }
+
+    return start_software(led, steps, count, repeat);
+}
+
+static hal_status_t led_flash(hal_led_t led, uint32_t on_ms)
+{
+    char value[16];
+
+    if (led >= HAL_LED_COUNT || on_ms == 0) {
+        return HAL_INVALID_PARAM;
+    }
+
+    snprintf(value, sizeof(value), "%u", on_ms);
+
+    /* Re-arming an active oneshot trigger is a single write, two when the time changes */
+    if (led_anims[led] == LED_ANIM_ONESHOT &&
+        (on_ms == led_shot_ms[led] || write_attr(led, "delay_on", value) == HAL_OK) &&
+        write_attr(led, "shot", "1") == HAL_OK) {
+        led_shot_ms[led] = on_ms;
+        return HAL_OK;
+    }
+
+    stop_animation(led);
+
+    if (write_attr(led, "trigger", "oneshot") == HAL_OK &&
+        write_attr(led, "delay_on", value) == HAL_OK &&
+        write_attr(led, "delay_off", "1") == HAL_OK &&
+        write_attr(led, "shot", "1") == HAL_OK) {
+        led_anims[led] = LED_ANIM_ONESHOT;
+        led_shot_ms[led] = on_ms;
+        return HAL_OK;
+    }
+    write_attr(led, "trigger", "none");
+
+    const hal_led_step_t step = { HAL_LED_ON, on_ms };
+    return start_software(led, &step, 1, 1);
+}
+
+hal_status_t hal_led_set_state(hal_led_t led, hal_led_state_t state)
+{
+    pthread_mutex_lock(&led_lock);
+    hal_status_t status = gpio_initialized ? led_set_state(led, state) : HAL_ERROR;
+    pthread_mutex_unlock(&led_lock);
+    return status;
+}
+
+hal_status_t hal_led_get_state(hal_led_t led, hal_led_state_t *state)
+{
+    pthread_mutex_lock(&led_lock);
+    hal_status_t status = gpio_initialized ? led_get_state(led, state) : HAL_ERROR;
+    pthread_mutex_unlock(&led_lock);
+    return status;
+}
+
+hal_status_t hal_led_toggle(hal_led_t led)
+{
+    pthread_mutex_lock(&led_lock);
+    hal_status_t status = gpio_initialized ? led_toggle(led) : HAL_ERROR;
+    pthread_mutex_unlock(&led_lock);
+    return status;
+}
+
+hal_status_t hal_led_set_pattern(uint8_t pattern)
+{
+    pthread_mutex_lock(&led_lock);
+    hal_status_t status = gpio_initialized ? led_set_pattern(pattern) : HAL_ERROR;
+    pthread_mutex_unlock(&led_lock);
+    return status;
+}
+
+hal_status_t hal_led_blink(hal_led_t led, uint32_t on_ms, uint32_t off_ms)
+{
+    pthread_mutex_lock(&led_lock);
+    hal_status_t status = gpio_initialized ? led_blink(led, on_ms, off_ms) : HAL_ERROR;
+    pthread_mutex_unlock(&led_lock);
+    return status;
+}
+
+hal_status_t hal_led_pattern_sequence(hal_led_t led, const hal_led_step_t *steps, int count, int repeat)
+{
+    pthread_mutex_lock(&led_lock);
+    hal_status_t status = gpio_initialized ? led_pattern_sequence(led, steps, count, repeat) : HAL_ERROR;
+    pthread_mutex_unlock(&led_lock);
+    return status;
+}
+
+hal_status_t hal_led_flash(hal_led_t led, uint32_t on_ms)
+{
+    pthread_mutex_lock(&led_lock);
+    hal_status_t status = gpio_initialized ? led_flash(led, on_ms) : HAL_ERROR;
+    pthread_mutex_unlock(&led_lock);
+    return status;
+}
+
+hal_status_t hal_led_stop(hal_led_t led)
+{
+    if (led >= HAL_LED_COUNT) {
+        return HAL_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&led_lock);
+    hal_status_t status = gpio_initialized ? stop_animation(led) : HAL_ERROR;
+    pthread_mutex_unlock(&led_lock);
+    return status;
+}
+
+static hal_status_t stop_animation(hal_led_t led)
+{
+    if (led_anims[led] == LED_ANIM_TRIGGER || led_anims[led] == LED_ANIM_ONESHOT) {
+        write_attr(led, "trigger", "none");
+    } else if (led_anims[led] == LED_ANIM_SOFTWARE) {
+        pthread_mutex_lock(&soft_lock);
+        soft_sequences[led].count = 0;
+        pthread_mutex_unlock(&soft_lock);
+    }
+
+    led_anims[led] = LED_ANIM_NONE;
+
+    /* Leave the LED off, the trigger may have stopped it either way */
+    return write_led(led, HAL_LED_OFF);
+}
+
+static void add_ms(struct timespec *ts, uint32_t ms)
 {
-    printf("Button subsystem initialized (placeholder)\n");
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static bool before(const struct timespec *a, const struct timespec *b)
+{
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+static hal_status_t start_software(hal_led_t led, const hal_led_step_t *steps, int count, int repeat)
+{
+    if (!soft_running) {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&soft_cond, &attr);
+        pthread_condattr_destroy(&attr);
+
+        soft_stop = false;
+        if (pthread_create(&soft_thread, NULL, soft_main, NULL) != 0) {
+            LOGE("Cannot start LED animation thread");
+            pthread_cond_destroy(&soft_cond);
+            return HAL_ERROR;
+        }
+        soft_running = true;
+    }
+
+    pthread_mutex_lock(&soft_lock);
+    led_sequence_t *seq = &soft_sequences[led];
+    memcpy(seq->steps, steps, count * sizeof(hal_led_step_t));
+    seq->count = count;
+    seq->repeat = repeat;
+    seq->index = 0;
+    clock_gettime(CLOCK_MONOTONIC, &seq->deadline);
+    write_led(led, steps[0].state);
+    add_ms(&seq->deadline, steps[0].duration_ms);
+    led_anims[led] = LED_ANIM_SOFTWARE;
+    pthread_cond_signal(&soft_cond);
+    pthread_mutex_unlock(&soft_lock);
     return HAL_OK;
 }
 
+/* Sleeps until the earliest step deadline of any software animation */
+static void *soft_main(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&soft_lock);
+    while (!soft_stop) {
+        struct timespec now, next = {0, 0};
+        bool pending = false;
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        for (int i = 0; i < HAL_LED_COUNT; i++) {
+            led_sequence_t *seq = &soft_sequences[i];
+            if (seq->count == 0) {
+                continue;
+            }
+
+            if (!before(&now, &seq->deadline)) {
+                if (++seq->index == seq->count) {
+                    seq->index = 0;
+                    if (seq->repeat > 0 && --seq->repeat == 0) {
+                        /* Finished, leave the LED off */
+                        seq->count = 0;
+                        write_led((hal_led_t)i, HAL_LED_OFF);
+                        continue;
+                    }
+                }
+                write_led((hal_led_t)i, seq->steps[seq->index].state);
+                add_ms(&seq->deadline, seq->steps[seq->index].duration_ms);
+            }
+
+            if (!pending || before(&seq->deadline, &next)) {
+                next = seq->deadline;
+                pending = true;
+            }
+        }
+
+        if (pending) {
+            pthread_cond_timedwait(&soft_cond, &soft_lock, &next);
+        } else {
+            pthread_cond_wait(&soft_cond, &soft_lock);
+        }
+    }
+    pthread_mutex_unlock(&soft_lock);
+    return NULL;
+}
+
+/* Button functions */
+
+/* Request both lines as debounced, edge-reporting inputs */
+static int open_button_lines(void)
+{
+    int chip = open(BUTTON_GPIO_CHIP, O_RDWR | O_CLOEXEC);
+    if (chip < 0) {
+        return -1;
+    }
+
+    struct gpio_v2_line_request req;
+    memset(&req, 0, sizeof(req));
+    for (int i = 0; i < HAL_BUTTON_COUNT; i++) {
+        req.offsets[i] = button_offsets[i];
+    }
+    req.num_lines = HAL_BUTTON_COUNT;
+    snprintf(req.consumer, sizeof(req.consumer), "hal-buttons");
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_ACTIVE_LOW |
+                       GPIO_V2_LINE_FLAG_BIAS_PULL_UP |
+                       GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    req.config.num_attrs = 1;
+    req.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+    req.config.attrs[0].attr.debounce_period_us = BUTTON_DEBOUNCE_US;
+    req.config.attrs[0].mask = (1u << HAL_BUTTON_COUNT) - 1;
+
+    int rc = ioctl(chip, GPIO_V2_GET_LINE_IOCTL, &req);
+    close(chip);
+    if (rc < 0) {
+        LOGI("Button lines on %s not available: %s", BUTTON_GPIO_CHIP, strerror(errno));
+        return -1;
+    }
+
+    return req.fd;
+}
+
+/* Find the gpio-keys input device by name in sysfs */
+static int open_button_keys(void)
+{
+    DIR *dir = opendir("/sys/class/input");
+    if (dir == NULL) {
+        return -1;
+    }
+
+    int fd = -1;
+    struct dirent *entry;
+    while (fd < 0 && (entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, "event", 5) != 0) {
+            continue;
+        }
+
+        char path[128], name[64] = {0};
+        snprintf(path, sizeof(path), "/sys/class/input/%.32s/device/name", entry->d_name);
+        int name_fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (name_fd < 0) {
+            continue;
+        }
+        ssize_t n = read(name_fd, name, sizeof(name) - 1);
+        close(name_fd);
+        if (n <= 0 || strncmp(name, BUTTON_KEYS_NAME "\n", sizeof(BUTTON_KEYS_NAME)) != 0) {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/dev/input/%.32s", entry->d_name);
+        fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    }
+    closedir(dir);
+
+    if (fd >= 0) {
+        /* Same clock as GPIO line events */
+        int clock = CLOCK_MONOTONIC;
+        ioctl(fd, EVIOCSCLOCKID, &clock);
+    }
+    return fd;
+}
+
+hal_status_t hal_button_init(void)
+{
+    if (button_backend != BUTTON_BACKEND_NONE) {
+        return HAL_OK;
+    }
+
+    button_fd = open_button_lines();
+    if (button_fd >= 0) {
+        /* Line request fds are blocking by default */
+        fcntl(button_fd, F_SETFL, fcntl(button_fd, F_GETFL) | O_NONBLOCK);
+        button_backend = BUTTON_BACKEND_GPIO;
+        LOGI("Button subsystem initialized (GPIO lines, %d us debounce)", BUTTON_DEBOUNCE_US);
+        return HAL_OK;
+    }
+
+    button_fd = open_button_keys();
+    if (button_fd >= 0) {
+        button_backend = BUTTON_BACKEND_EVDEV;
+        LOGI("Button subsystem initialized (%s input device)", BUTTON_KEYS_NAME);
+        return HAL_OK;
+    }
+
+    LOGE("No button lines or %s device found", BUTTON_KEYS_NAME);
+    return HAL_ERROR;
+}
+
 hal_status_t hal_button_deinit(void)
 {
-    printf("Button subsystem deinitialized (placeholder)\n");
+    if (button_fd >= 0) {
+        close(button_fd);
+        button_fd = -1;
+    }
+
+    button_backend = BUTTON_BACKEND_NONE;
+    LOGI("Button subsystem deinitialized");
     return HAL_OK;
 }
 
@@ -248,10 +739,119 @@ hal_status_t hal_button_get_state(hal_button_t button, hal_button_state_t *state
     if (button >= HAL_BUTTON_COUNT || state == NULL) {
         return HAL_INVALID_PARAM;
     }
-    
-    /* Placeholder - always return not pressed */
-    *state = HAL_BUTTON_RELEASED;
-    return HAL_OK;
+
+    /* Current levels, queued edge events are left for hal_button_read_events() */
+    if (button_backend == BUTTON_BACKEND_GPIO) {
+        struct gpio_v2_line_values values = { .bits = 0, .mask = 1u << button };
+        if (ioctl(button_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) {
+            return HAL_ERROR;
+        }
+        *state = (values.bits & (1u << button)) ? HAL_BUTTON_PRESSED : HAL_BUTTON_RELEASED;
+        return HAL_OK;
+    }
+
+    if (button_backend == BUTTON_BACKEND_EVDEV) {
+        unsigned long keys[(KEY_MAX + 1) / (8 * sizeof(unsigned long)) + 1] = {0};
+        if (ioctl(button_fd, EVIOCGKEY(sizeof(keys)), keys) < 0) {
+            return HAL_ERROR;
+        }
+        unsigned int code = button_codes[button];
+        bool down = (keys[code / (8 * sizeof(unsigned long))] >> (code % (8 * sizeof(unsigned long)))) & 1;
+        *state = down ? HAL_BUTTON_PRESSED : HAL_BUTTON_RELEASED;
+        return HAL_OK;
+    }
+
+    return HAL_ERROR;
+}
+
+int hal_button_get_fd(void)
+{
+    return button_fd;
+}
+
+int hal_button_read_events(hal_button_event_t *events, int max)
+{
+    if (button_backend == BUTTON_BACKEND_NONE) {
+        return -1;
+    }
+
+    if (events == NULL || max <= 0) {
+        return -1;
+    }
+
+    int count = 0;
+
+    if (button_backend == BUTTON_BACKEND_GPIO) {
+        struct gpio_v2_line_event raw[16];
+        while (count < max) {
+            size_t want = (size_t)(max - count) < 16 ? (size_t)(max - count) : 16;
+            ssize_t n = read(button_fd, raw, want * sizeof(raw[0]));
+            if (n <= 0) {
+                break;
+            }
+
+            for (size_t i = 0; i < (size_t)n / sizeof(raw[0]); i++) {
+                int button = (raw[i].offset == button_offsets[0]) ? 0 : 1;
+                events[count].button = (hal_button_t)button;
+                /* Active low: the rising edge of the logical value is the press */
+                events[count].state = (raw[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE) ?
+                                      HAL_BUTTON_PRESSED : HAL_BUTTON_RELEASED;
+                events[count].timestamp_ns = raw[i].timestamp_ns;
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /*
+     * At most one edge per event read, so nothing read is left unstored.
+     * SYN and MSC events only take up room, they cost extra reads.
+     */
+    struct input_event raw[16];
+    while (count < max) {
+        size_t want = (size_t)(max - count) < 16 ? (size_t)(max - count) : 16;
+        ssize_t n = read(button_fd, raw, want * sizeof(raw[0]));
+        if (n <= 0) {
+            break;
+        }
+
+        for (size_t i = 0; i < (size_t)n / sizeof(raw[0]); i++) {
+            /* value 2 is autorepeat, not an edge */
+            if (raw[i].type != EV_KEY || raw[i].value > 1) {
+                continue;
+            }
+            for (int b = 0; b < HAL_BUTTON_COUNT; b++) {
+                if (raw[i].code == button_codes[b]) {
+                    events[count].button = (hal_button_t)b;
+                    events[count].state = raw[i].value ? HAL_BUTTON_PRESSED : HAL_BUTTON_RELEASED;
+                    events[count].timestamp_ns = (uint64_t)raw[i].time.tv_sec * 1000000000u +
+                                                 (uint64_t)raw[i].time.tv_usec * 1000u;
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+hal_status_t hal_button_wait(int timeout_ms)
+{
+    if (button_fd < 0) {
+        return HAL_ERROR;
+    }
+
+    struct pollfd pfd = { .fd = button_fd, .events = POLLIN };
+    int rc;
+
+    do {
+        rc = poll(&pfd, 1, timeout_ms);
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc < 0) {
+        return HAL_ERROR;
+    }
+
+    return (rc > 0) ? HAL_OK : HAL_TIMEOUT;
 }
 
 /* GPIO module initialization functions */
@@ -259,34 +859,32 @@ hal_status_t hal_gpio_init(void)
 {
     hal_status_t status;
     
-    printf("Initializing GPIO subsystems...\n");
+    LOGI("Initializing GPIO subsystems...");
     
     status = hal_led_init();
     if (status != HAL_OK) {
-        printf("Failed to initialize LED subsystem\n");
+        LOGE("Failed to initialize LED subsystem");
         return status;
     }
     
+    /* Buttons are optional: LEDs stay usable when the lines are unavailable */
     status = hal_button_init();
     if (status != HAL_OK) {
-        printf("Failed to initialize button subsystem\n");
-        return status;
+        LOGW("Button subsystem unavailable");
     }
     
-    gpio_initialized = true;
-    printf("GPIO subsystem initialization complete\n");
+    LOGI("GPIO subsystem initialization complete");
     return HAL_OK;
 }
 
 hal_status_t hal_gpio_deinit(void)
 {
-    printf("Deinitializing GPIO subsystems...\n");
+    LOGI("Deinitializing GPIO subsystems...");
     
     hal_led_deinit();
     hal_button_deinit();
     
-    gpio_initialized = false;
-    printf("GPIO subsystem deinitialization complete\n");
+    LOGI("GPIO subsystem deinitialization complete");
     return HAL_OK;
 }
 
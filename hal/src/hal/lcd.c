@@ -1,15 +1,22 @@
 #define _GNU_SOURCE
 #include "../../include/hal.h"
+#include "../../include/hal_ui.h"
+#include "pixel.h"
+#include "lcd_stats.h"
+#include "log.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
 #include <errno.h>
+#include <time.h>
 #include <drm/drm.h>
 #include <drm/drm_mode.h>
+#include <drm/drm_fourcc.h>
 
 /* DRM device path */
 #define DRM_DEVICE "/dev/dri/card0"
@@ -19,470 +26,474 @@
 #define DRM_MODE_CONNECTED     1
 #define DRM_MODE_UNKNOWNCONNECTION 2
 
+/* Upper bound for waiting on a flip event (several vblanks at 50 Hz) */
+#define LCD_FLIP_TIMEOUT_MS     100
+
+/* Damage rectangles kept per frame before neighbours get merged */
+#define LCD_MAX_DAMAGE_RECTS    16
+
+/* Overlay layers get their own double buffer */
+#define LCD_LAYER_BUFFERS       2
+
+/* Resource IDs read by the full probe, more than any STM32MP1 board exposes */
+#define LCD_MAX_RESOURCES       16
+
+/* Modes a cached connector may list and still be validated in one ioctl */
+#define LCD_CACHE_MODES         8
+#define LCD_CACHE_MAGIC         0x314D4C48  /* "HLM1" */
+
+/* Info level messages that fast start leaves out */
+#define LCD_INFO(...) do { if (!lcd_config.fast_start) LOGI(__VA_ARGS__); } while (0)
+
+/* Property slots in one atomic request */
+#define LCD_ATOMIC_MAX_PROPS    96
+#define LCD_ATOMIC_MAX_OBJS     (HAL_LCD_MAX_LAYERS + 3)
+
+/* One dumb buffer of the swap chain */
+typedef struct {
+    uint32_t handle;
+    uint32_t pitch;
+    uint64_t size;
+    uint32_t fb_id;
+    uint32_t *map;
+} lcd_buffer_t;
+
+/* Damage list, rectangles in pixels with exclusive x2/y2 (DIRTYFB clip layout) */
+typedef struct {
+    struct drm_clip_rect rects[LCD_MAX_DAMAGE_RECTS];
+    int count;
+} lcd_damage_t;
+
+/* Overlay plane driven as a layer */
+typedef struct {
+    bool used;
+    uint32_t plane_id;
+    uint32_t zpos_prop;                    /* 0 if the plane has a fixed z-order */
+    lcd_buffer_t buffers[LCD_LAYER_BUFFERS];
+    int back;                              /* Buffer being drawn */
+    int front;                             /* Buffer shown while visible */
+    hal_lcd_fb_t fb;                       /* Draw target, the back buffer */
+    int x, y;                              /* Position on the CRTC, may be off screen */
+    int zpos;                              /* -1 until set */
+    bool visible;
+    bool staged;                           /* Atomic: change waits for the next commit */
+    bool inflight;                         /* Atomic: change is in the pending commit */
+    bool busy;                             /* Back buffer on screen until the change lands */
+} lcd_layer_t;
+
+/* Atomic request, properties grouped per object as DRM_IOCTL_MODE_ATOMIC expects */
+typedef struct {
+    uint32_t objs[LCD_ATOMIC_MAX_OBJS];
+    uint32_t counts[LCD_ATOMIC_MAX_OBJS];
+    uint32_t props[LCD_ATOMIC_MAX_PROPS];
+    uint64_t values[LCD_ATOMIC_MAX_PROPS];
+    int nobjs;
+    int nprops;
+} lcd_atomic_req_t;
+
+/* Core KMS property IDs, shared by all objects of a type */
+typedef struct {
+    uint32_t conn_crtc_id;
+    uint32_t crtc_mode_id;
+    uint32_t crtc_active;
+    uint32_t crtc_out_fence;
+    uint32_t fb_id;
+    uint32_t crtc_id;
+    uint32_t src_x, src_y, src_w, src_h;
+    uint32_t crtc_x, crtc_y, crtc_w, crtc_h;
+} lcd_atomic_props_t;
+
+/* Fast start cache file: the probe result and the request it answered */
+typedef struct {
+    uint32_t magic;
+    uint32_t connector_id;
+    uint32_t crtc_id;
+    int32_t crtc_index;
+    uint16_t width;                        /* lcd_config request */
+    uint16_t height;
+    uint32_t refresh;
+    struct drm_mode_modeinfo mode;
+} lcd_mode_cache_t;
+
 /* Internal state */
 static bool lcd_initialized = false;
 static int drm_fd = -1;
-static uint32_t *fb_buffer = NULL;
-static struct drm_mode_create_dumb create_req;
-static struct drm_mode_map_dumb map_req;
-static uint32_t fb_id;
+static hal_lcd_fb_t fb;                    /* Draw target: back buffer or shadow */
+static hal_lcd_config_t lcd_config;        /* Requested mode and format */
 static size_t buffer_size = 0;
 
+/* Swap chain state */
+static lcd_buffer_t buffers[HAL_LCD_MAX_BUFFERS];
+static int buffer_count = HAL_LCD_DEFAULT_BUFFERS;  /* Requested chain length */
+static int active_buffers = 0;             /* Buffers actually created */
+static int draw_index = 0;                 /* Back buffer */
+static int scanout_index = -1;             /* Buffer on screen */
+static int pending_index = -1;             /* Buffer with a flip in flight */
+static bool draw_busy = false;             /* Back buffer still on screen until the flip lands */
+static bool page_flip_supported = true;
+static hal_lcd_swap_mode_t swap_mode = HAL_LCD_SWAP_BLOCKING;
+
+/* Shadow framebuffer state */
+static bool shadow_requested = false;
+static uint8_t *shadow_buffer = NULL;      /* Cached system RAM copy all drawing goes to */
+static uint8_t *shadow_copy = NULL;        /* Last presented frame, used to refine damage */
+static size_t shadow_pitch = 0;            /* Packed rows in the scanout format */
+static lcd_damage_t frame_damage;          /* Drawn since the last swap */
+static lcd_damage_t buffer_damage[HAL_LCD_MAX_BUFFERS];  /* Not yet copied into each buffer */
+static uint16_t pixel_x1, pixel_y1, pixel_x2, pixel_y2;  /* Bounding box of pixel writes */
+static bool dirtyfb_supported = true;
+static size_t last_flush_bytes = 0;
+
 /* Display configuration */
 static uint32_t connector_id = 0;
 static uint32_t crtc_id = 0;
 static struct drm_mode_modeinfo mode;
-
-#if 1
-hal_lcd_status_t hal_lcd_init(void)
+static int crtc_index = 0;                 /* Bit in possible_crtcs */
+
+/* Cold start */
+static hal_lcd_init_stats_t init_stats;
+static uint64_t init_start = 0;            /* hal_lcd_init_ex() entry, us */
+static char mode_cache_path[128];          /* Empty when not caching */
+static bool mode_cached = false;           /* Display setup came from the cache */
+static bool modeset_pending = false;       /* Fast start: first swap sets the mode */
+
+/* Overlay planes usable on our CRTC and the layers using them */
+static uint32_t planes[HAL_LCD_MAX_LAYERS];
+static int plane_count = 0;
+static lcd_layer_t layers[HAL_LCD_MAX_LAYERS];
+
+/* Atomic KMS state, legacy ioctls when unavailable */
+static bool atomic_supported = false;
+static uint32_t primary_plane_id = 0;
+static uint32_t mode_blob_id = 0;
+static lcd_atomic_props_t atomic_props;
+static bool out_fence_requested = false;
+static int out_fence_fd = -1;              /* Fence of the last flip, until the caller takes it */
+
+/* Function prototypes */
+static hal_lcd_status_t create_buffer(lcd_buffer_t *buf, uint16_t width, uint16_t height,
+                                      hal_lcd_format_t format);
+static void destroy_buffer(lcd_buffer_t *buf);
+static hal_lcd_status_t set_crtc(int index);
+static hal_lcd_status_t swap_frame(void);
+static hal_lcd_status_t submit_flip(int index);
+static int process_events(int timeout_ms);
+static void wait_flip(void);
+static int find_free_buffer(void);
+static void set_draw_buffer(int index, bool busy);
+static int select_mode(const struct drm_mode_modeinfo *modes, int count);
+static hal_lcd_status_t probe_display(bool *found);
+static bool read_modes(uint32_t id, uint32_t count);
+static bool load_mode_cache(void);
+static void save_mode_cache(void);
+static hal_lcd_status_t first_modeset(int index);
+static hal_lcd_status_t create_shadow(void);
+static void destroy_shadow(void);
+static void damage_add(lcd_damage_t *damage, int x1, int y1, int x2, int y2);
+static void flush_shadow(int index);
+static uint32_t find_property(uint32_t obj_id, uint32_t obj_type, const char *name, uint64_t *value);
+static void discover_planes(void);
+static bool plane_supports(uint32_t plane_id, hal_lcd_format_t format);
+static lcd_layer_t *get_layer(hal_lcd_layer_t layer);
+static hal_lcd_status_t update_plane(lcd_layer_t *l, int index);
+static hal_lcd_status_t apply_layer(lcd_layer_t *l);
+static void layer_wait(lcd_layer_t *l);
+static bool atomic_init(void);
+static void atomic_add(lcd_atomic_req_t *req, uint32_t obj, uint32_t prop, uint64_t value);
+static void atomic_add_plane(lcd_atomic_req_t *req, uint32_t plane_id, uint32_t fb_id,
+                             int x, int y, uint16_t width, uint16_t height);
+static bool atomic_add_layers(lcd_atomic_req_t *req);
+static bool atomic_test_layer(const lcd_layer_t *l);
+static hal_lcd_status_t atomic_commit(lcd_atomic_req_t *req, uint32_t flags, uint64_t user_data);
+static void atomic_fallback(void);
+
+static uint64_t lcd_now_us(void)
 {
-    if (lcd_initialized) {
-        return HAL_LCD_OK;
-    }
-
-    printf("Initializing LCD via DRM...\n");
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
 
-    /* Open DRM device */
-    drm_fd = open(DRM_DEVICE, O_RDWR);
-    if (drm_fd < 0) {
-        printf("Error: Cannot open DRM device %s: %s\n", DRM_DEVICE, strerror(errno));
-        return HAL_LCD_ERROR;
-    }
+/* Address of pixel (x, y) in the draw target */
+static inline uint8_t *fb_pixel(int x, int y)
+{
+    return (uint8_t *)fb.base + (size_t)y * fb.pitch + (size_t)x * (fb.bpp / 8);
+}
 
-    /* First, get the count of resources */
-    struct drm_mode_card_res resources = {0};
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_GETRESOURCES, &resources) < 0) {
-        printf("Error: Cannot get DRM resource counts: %s\n", strerror(errno));
-        close(drm_fd);
-        return HAL_LCD_ERROR;
-    }
+static inline uint8_t format_bpp(hal_lcd_format_t format)
+{
+    return (format == HAL_LCD_FORMAT_RGB565) ? 16 : 32;
+}
 
-    printf("DRM Resources: %d connectors, %d crtcs, %d encoders, %d fbs\n", 
-           resources.count_connectors, resources.count_crtcs, 
-           resources.count_encoders, resources.count_fbs);
+/* ARGB8888 API color in the framebuffer format, packed once per call */
+static inline uint32_t native_color(hal_lcd_format_t format, uint32_t color)
+{
+    return (format == HAL_LCD_FORMAT_RGB565) ? hal_pixel_rgb565(color) : color;
+}
 
-    if (resources.count_connectors == 0 || resources.count_crtcs == 0) {
-        printf("Error: Insufficient DRM resources\n");
-        close(drm_fd);
-        return HAL_LCD_ERROR;
+static void fill_native(hal_lcd_format_t format, void *dst, size_t pitch, int width, int height,
+                        uint32_t native)
+{
+    if (format == HAL_LCD_FORMAT_RGB565) {
+        hal_pixel_fill_rect16(dst, pitch, width, height, (uint16_t)native);
+    } else {
+        hal_pixel_fill_rect(dst, pitch, width, height, native);
     }
+}
 
-    /* Allocate arrays for resource IDs */
-    uint32_t *connectors = malloc(resources.count_connectors * sizeof(uint32_t));
-    uint32_t *crtcs = malloc(resources.count_crtcs * sizeof(uint32_t));
-    uint32_t *encoders = malloc(resources.count_encoders * sizeof(uint32_t));
-    uint32_t *fbs = malloc(resources.count_fbs * sizeof(uint32_t));
-    
-    if (!connectors || !crtcs || !encoders || !fbs) {
-        printf("Error: Cannot allocate memory for DRM resources\n");
-        free(connectors);
-        free(crtcs);
-        free(encoders);
-        free(fbs);
-        close(drm_fd);
-        return HAL_LCD_ERROR;
-    }
+/* Extend the pixel-write bounding box, folded into the damage list on swap */
+static inline void mark_pixel(uint16_t x, uint16_t y)
+{
+    if (x < pixel_x1) pixel_x1 = x;
+    if (y < pixel_y1) pixel_y1 = y;
+    if (x >= pixel_x2) pixel_x2 = x + 1;
+    if (y >= pixel_y2) pixel_y2 = y + 1;
+}
 
-    /* Set up pointers for the second call */
-    resources.connector_id_ptr = (uint64_t)connectors;
-    resources.crtc_id_ptr = (uint64_t)crtcs;
-    resources.encoder_id_ptr = (uint64_t)encoders;
-    resources.fb_id_ptr = (uint64_t)fbs;
+hal_lcd_status_t hal_lcd_init(void)
+{
+    return hal_lcd_init_ex(NULL);
+}
 
-    /* Second call to get actual resource IDs */
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_GETRESOURCES, &resources) < 0) {
-        printf("Error: Cannot get DRM resource IDs: %s\n", strerror(errno));
-        free(connectors);
-        free(crtcs);
-        free(encoders);
-        free(fbs);
-        close(drm_fd);
-        return HAL_LCD_ERROR;
+hal_lcd_status_t hal_lcd_init_ex(const hal_lcd_config_t *config)
+{
+    if (lcd_initialized) {
+        return HAL_LCD_OK;
     }
 
-    printf("Found %d connectors, %d CRTCs\n", resources.count_connectors, resources.count_crtcs);
-
-    /* Use first CRTC */
-    crtc_id = crtcs[0];
-    printf("Using CRTC ID: %d\n", crtc_id);
-
-    /* Find a connected connector with modes */
-    bool found_connector = false;
-    for (int i = 0; i < resources.count_connectors; i++) {
-        struct drm_mode_get_connector conn = {0};
-        conn.connector_id = connectors[i];
-        
-        /* First call to get connector info and mode count */
-        if (ioctl(drm_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) == 0) {
-            printf("Connector %d: type=%d, connection=%d, modes=%d\n", 
-                   connectors[i], conn.connector_type, conn.connection, conn.count_modes);
-                   
-            /* Use connected connector with available modes */
-            if (conn.connection == DRM_MODE_CONNECTED && conn.count_modes > 0) {
-                connector_id = connectors[i];
-                printf("Using connected connector ID: %d\n", connector_id);
-                
-                /* Allocate space for modes and get them */
-                struct drm_mode_modeinfo *modes = malloc(conn.count_modes * sizeof(struct drm_mode_modeinfo));
-                if (modes) {
-                    /* Clear the connector structure and set it up for second call */
-                    memset(&conn, 0, sizeof(conn));
-                    conn.connector_id = connectors[i];
-                    conn.modes_ptr = (uint64_t)modes;
-                    
-                    /* Second call to get actual modes */
-                    if (ioctl(drm_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) == 0 && conn.count_modes > 0) {
-                        mode = modes[0];  /* Use first mode (usually preferred) */
-                        found_connector = true;
-                        printf("Using display mode: %dx%d@%dHz\n", 
-                               mode.hdisplay, mode.vdisplay, mode.vrefresh);
-                        printf("Mode details: hsync_start=%d, hsync_end=%d, htotal=%d\n",
-                               mode.hsync_start, mode.hsync_end, mode.htotal);
-                        printf("Mode details: vsync_start=%d, vsync_end=%d, vtotal=%d\n",
-                               mode.vsync_start, mode.vsync_end, mode.vtotal);
-                        printf("Mode clock: %d, flags: 0x%x\n", mode.clock, mode.flags);
-                    } else {
-                        printf("Error: Failed to get modes for connector %d\n", connectors[i]);
-                    }
-                    
-                    free(modes);
-                }
-                
-                if (found_connector) break;
-            }
+    memset(&lcd_config, 0, sizeof(lcd_config));
+    if (config != NULL) {
+        if (config->format != HAL_LCD_FORMAT_XRGB8888 && config->format != HAL_LCD_FORMAT_RGB565) {
+            LOGE("Pixel format %d not supported", config->format);
+            return HAL_LCD_INVALID_PARAM;
         }
-    }
-
-    /* If no connected connector found, try any connector with modes */
-    if (!found_connector) {
-        printf("No connected connector found, trying fallback...\n");
-        for (int i = 0; i < resources.count_connectors; i++) {
-            struct drm_mode_get_connector conn = {0};
-            conn.connector_id = connectors[i];
-            
-            if (ioctl(drm_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) == 0) {
-                if (conn.count_modes > 0) {
-                    connector_id = connectors[i];
-                    printf("Using fallback connector ID: %d (not connected but has modes)\n", connector_id);
-                    
-                    struct drm_mode_modeinfo *modes = malloc(conn.count_modes * sizeof(struct drm_mode_modeinfo));
-                    if (modes) {
-                        memset(&conn, 0, sizeof(conn));
-                        conn.connector_id = connectors[i];
-                        conn.modes_ptr = (uint64_t)modes;
-                        
-                        if (ioctl(drm_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) == 0 && conn.count_modes > 0) {
-                            mode = modes[0];
-                            found_connector = true;
-                            printf("Using display mode: %dx%d@%dHz\n", 
-                                   mode.hdisplay, mode.vdisplay, mode.vrefresh);
-                        }
-                        
-                        free(modes);
-                    }
-                    
-                    if (found_connector) break;
-                }
-            }
+        if (config->buffer_count < 0 || config->buffer_count > HAL_LCD_MAX_BUFFERS) {
+            return HAL_LCD_INVALID_PARAM;
         }
+        lcd_config = *config;
+        if (config->buffer_count > 0) {
+            buffer_count = config->buffer_count;
+        }
+        shadow_requested = config->shadow;
     }
-
-    /* If still no mode found, use hardcoded values */
-    if (!found_connector || mode.hdisplay == 0 || mode.vdisplay == 0) {
-        printf("Warning: No valid mode found, using hardcoded 480x800@50Hz\n");
-        memset(&mode, 0, sizeof(mode));
-        mode.hdisplay = 480;
-        mode.vdisplay = 800;
-        mode.vrefresh = 50;
-        mode.hsync_start = 578;
-        mode.hsync_end = 610;
-        mode.htotal = 708;
-        mode.vsync_start = 815;
-        mode.vsync_end = 825;
-        mode.vtotal = 839;
-        mode.clock = 29700;
-        strcpy(mode.name, "480x800");
-        
-        /* Use the first connector if none was selected */
-        if (connector_id == 0 && resources.count_connectors > 0) {
-            connector_id = connectors[0];
-        }
-        
-        found_connector = true;
-        printf("Using hardcoded mode: %dx%d@%dHz\n", 
-               mode.hdisplay, mode.vdisplay, mode.vrefresh);
-    }
-
-    printf("DEBUG: Mode before buffer creation: %dx%d\n", mode.hdisplay, mode.vdisplay);
-    
-    /* Validate mode dimensions */
-    if (mode.hdisplay == 0 || mode.vdisplay == 0) {
-        printf("ERROR: Invalid mode dimensions, using fallback\n");
-        mode.hdisplay = 480;
-        mode.vdisplay = 800;
-    }
-
-    /* Create dumb buffer for framebuffer using actual display mode */
-    memset(&create_req, 0, sizeof(create_req));
-    create_req.width = mode.hdisplay;   /* Use actual display width */
-    create_req.height = mode.vdisplay;  /* Use actual display height */
-    create_req.bpp = LCD_BPP;
-
-    printf("Creating buffer: %dx%d@%dbpp\n", create_req.width, create_req.height, create_req.bpp);
-    printf("DEBUG: create_req sizes: width=%u, height=%u, bpp=%u\n", 
-           create_req.width, create_req.height, create_req.bpp);
-
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_CREATE_DUMB, &create_req) < 0) {
-        printf("Error: Cannot create dumb buffer: %s\n", strerror(errno));
-        close(drm_fd);
-        drm_fd = -1;
-        return HAL_LCD_ERROR;
+    fb.format = lcd_config.format;
+    fb.bpp = format_bpp(fb.format);
+
+    memset(&init_stats, 0, sizeof(init_stats));
+    init_start = lcd_now_us();
+    mode_cache_path[0] = '\0';
+    if (lcd_config.fast_start) {
+        const char *path = lcd_config.mode_cache ? lcd_config.mode_cache : HAL_LCD_MODE_CACHE;
+        snprintf(mode_cache_path, sizeof(mode_cache_path), "%s", path);
     }
+    lcd_config.mode_cache = NULL;          /* Caller's string, copied above */
 
-    printf("Created dumb buffer: handle=%u, pitch=%u, size=%llu\n", 
-           create_req.handle, create_req.pitch, create_req.size);
-
-    /* Create framebuffer object using actual mode dimensions */
-    struct drm_mode_fb_cmd fb_cmd = {0};
-    fb_cmd.width = mode.hdisplay;
-    fb_cmd.height = mode.vdisplay;
-    fb_cmd.pitch = create_req.pitch;
-    fb_cmd.bpp = LCD_BPP;
-    fb_cmd.depth = 24;
-    fb_cmd.handle = create_req.handle;
-
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_ADDFB, &fb_cmd) < 0) {
-        printf("Warning: Cannot create framebuffer object: %s\n", strerror(errno));
-        printf("Continuing without framebuffer object...\n");
-        fb_id = 0;
-    } else {
-        fb_id = fb_cmd.fb_id;
-        printf("Created framebuffer: ID=%u\n", fb_id);
-    }
+    LCD_INFO("Initializing LCD via DRM...");
 
-    /* Map the buffer */
-    memset(&map_req, 0, sizeof(map_req));
-    map_req.handle = create_req.handle;
+    /* Pick the fastest pixel kernels this CPU supports */
+    hal_pixel_select(true);
+    LOGD("Pixel kernels: %s", hal_pixel->name);
 
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_MAP_DUMB, &map_req) < 0) {
-        printf("Error: Cannot map dumb buffer: %s\n", strerror(errno));
-        if (fb_id) ioctl(drm_fd, DRM_IOCTL_MODE_RMFB, &fb_id);
-        struct drm_mode_destroy_dumb destroy_req = { .handle = create_req.handle };
-        ioctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy_req);
-        close(drm_fd);
-        drm_fd = -1;
+    /* Open DRM device */
+    drm_fd = open(DRM_DEVICE, O_RDWR);
+    if (drm_fd < 0) {
+        LOGE("Cannot open DRM device %s: %s", DRM_DEVICE, strerror(errno));
         return HAL_LCD_ERROR;
     }
 
-    printf("Map buffer: offset=%llu\n", map_req.offset);
-
-    buffer_size = create_req.size;
-    fb_buffer = (uint32_t *)mmap(0, buffer_size, PROT_READ | PROT_WRITE, MAP_SHARED, drm_fd, map_req.offset);
-    
-    if (fb_buffer == MAP_FAILED) {
-        printf("Error: Cannot mmap buffer: %s\n", strerror(errno));
-        if (fb_id) ioctl(drm_fd, DRM_IOCTL_MODE_RMFB, &fb_id);
-        struct drm_mode_destroy_dumb destroy_req = { .handle = create_req.handle };
-        ioctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy_req);
-        close(drm_fd);
-        drm_fd = -1;
-        return HAL_LCD_ERROR;
+    /* Atomic KMS (implies universal planes), the legacy path stays the fallback */
+    atomic_supported = false;
+    if (!lcd_config.legacy) {
+        struct drm_set_client_cap cap = { .capability = DRM_CLIENT_CAP_ATOMIC, .value = 1 };
+        atomic_supported = (ioctl(drm_fd, DRM_IOCTL_SET_CLIENT_CAP, &cap) == 0);
     }
 
-    /* Try to set the display mode (this may fail but we continue) */
-    if (fb_id > 0) {
-        struct drm_mode_crtc crtc = {0};
-        crtc.crtc_id = crtc_id;
-        crtc.fb_id = fb_id;
-        crtc.set_connectors_ptr = (uint64_t)&connector_id;
-        crtc.count_connectors = 1;
-        crtc.mode = mode;
-        crtc.mode_valid = 1;
-
-        if (ioctl(drm_fd, DRM_IOCTL_MODE_SETCRTC, &crtc) < 0) {
-            printf("Warning: Cannot set CRTC mode: %s\n", strerror(errno));
-            printf("Display might not show on screen\n");
-        } else {
-            printf("Successfully set display mode\n");
+    init_stats.open_us = (uint32_t)(lcd_now_us() - init_start);
+
+    /* Connector, CRTC and mode: the previous run's choice if it still holds */
+    uint64_t phase = lcd_now_us();
+    mode_cached = lcd_config.fast_start && mode_cache_path[0] && load_mode_cache();
+    if (!mode_cached) {
+        bool found = false;
+        if (probe_display(&found) != HAL_LCD_OK) {
+            close(drm_fd);
+            drm_fd = -1;
+            return HAL_LCD_ERROR;
         }
-    }
-
-    lcd_initialized = true;
-    printf("LCD DRM initialized successfully (%dx%d, %d bpp, buffer size: %zu)\n", 
-           LCD_WIDTH, LCD_HEIGHT, LCD_BPP, buffer_size);
 
-    /* Clear screen to red to test */
-    hal_lcd_clear(LCD_COLOR_RED);
+        if (found && lcd_config.fast_start && mode_cache_path[0]) {
+            save_mode_cache();
+        }
 
-    return HAL_LCD_OK;
-}
-#else
-hal_lcd_status_t hal_lcd_init(void)
-{
-    if (lcd_initialized) {
-        return HAL_LCD_OK;
+        /* No mode at all, use hardcoded values */
+        if (!found || mode.hdisplay == 0 || mode.vdisplay == 0) {
+            LOGW("No valid mode found, using hardcoded 480x800@50Hz");
+            memset(&mode, 0, sizeof(mode));
+            mode.hdisplay = 480;
+            mode.vdisplay = 800;
+            mode.vrefresh = 50;
+            mode.hsync_start = 578;
+            mode.hsync_end = 610;
+            mode.htotal = 708;
+            mode.vsync_start = 815;
+            mode.vsync_end = 825;
+            mode.vtotal = 839;
+            mode.clock = 29700;
+            strcpy(mode.name, "480x800");
+        }
     }
-
-    printf("Initializing LCD via DRM...\n");
-
-    /* Open DRM device */
-    drm_fd = open(DRM_DEVICE, O_RDWR);
-    if (drm_fd < 0) {
-        printf("Error: Cannot open DRM device %s: %s\n", DRM_DEVICE, strerror(errno));
-        return HAL_LCD_ERROR;
+    init_stats.mode_cached = mode_cached;
+    init_stats.probe_us = (uint32_t)(lcd_now_us() - phase);
+
+    /* Create the swap chain: one dumb buffer + framebuffer object each */
+    phase = lcd_now_us();
+    memset(buffers, 0, sizeof(buffers));
+    active_buffers = 0;
+    for (int i = 0; i < buffer_count; i++) {
+        if (create_buffer(&buffers[i], mode.hdisplay, mode.vdisplay, fb.format) != HAL_LCD_OK) {
+            break;
+        }
+        active_buffers++;
+        /* Without a framebuffer object there is nothing to flip to */
+        if (buffers[i].fb_id == 0) {
+            break;
+        }
     }
 
-    /* Use known working mode from modetest output */
-    memset(&mode, 0, sizeof(mode));
-    mode.hdisplay = 480;        /* Horizontal display size */
-    mode.vdisplay = 800;        /* Vertical display size */
-    mode.vrefresh = 60;         /* Refresh rate in Hz */
-    mode.hsync_start = 578;     /* Horizontal sync start */
-    mode.hsync_end = 610;       /* Horizontal sync end */
-    mode.htotal = 708;          /* Total horizontal pixels */
-    mode.vsync_start = 815;     /* Vertical sync start */
-    mode.vsync_end = 825;       /* Vertical sync end */
-    mode.vtotal = 839;          /* Total vertical lines */
-    mode.clock = 29700;         /* Pixel clock in kHz */
-    mode.flags = 0;             /* Mode flags (nhsync, nvsync) */
-    strcpy(mode.name, "480x800");
-    
-    /* Use DSI connector and CRTC directly from modetest output */
-    connector_id = 34;          /* DSI-1 connector from modetest */
-    crtc_id = 41;               /* CRTC ID from modetest */
-    
-    printf("Using hardcoded working configuration:\n");
-    printf("  Connector: %d (DSI-1)\n", connector_id);
-    printf("  CRTC: %d\n", crtc_id);
-    printf("  Mode: %dx%d@%dHz\n", mode.hdisplay, mode.vdisplay, mode.vrefresh);
-
-    /* Create dumb buffer for framebuffer */
-    memset(&create_req, 0, sizeof(create_req));
-    create_req.width = mode.hdisplay;   /* 480 pixels */
-    create_req.height = mode.vdisplay;  /* 800 pixels */
-    create_req.bpp = LCD_BPP;           /* 32 bits per pixel */
-
-    printf("Creating buffer: %dx%d@%dbpp\n", 
-           create_req.width, create_req.height, create_req.bpp);
-
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_CREATE_DUMB, &create_req) < 0) {
-        printf("Error: Cannot create dumb buffer: %s\n", strerror(errno));
+    if (active_buffers == 0) {
         close(drm_fd);
         drm_fd = -1;
         return HAL_LCD_ERROR;
     }
 
-    printf("Created dumb buffer: handle=%u, pitch=%u, size=%llu\n", 
-           create_req.handle, create_req.pitch, create_req.size);
-
-    /* Create framebuffer object */
-    struct drm_mode_fb_cmd fb_cmd = {0};
-    fb_cmd.width = mode.hdisplay;    /* 480 */
-    fb_cmd.height = mode.vdisplay;   /* 800 */
-    fb_cmd.pitch = create_req.pitch; /* Bytes per line */
-    fb_cmd.bpp = LCD_BPP;            /* 32 */
-    fb_cmd.depth = 24;               /* Color depth */
-    fb_cmd.handle = create_req.handle;
-
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_ADDFB, &fb_cmd) < 0) {
-        printf("Error: Cannot create framebuffer object: %s\n", strerror(errno));
-        struct drm_mode_destroy_dumb destroy_req = { .handle = create_req.handle };
-        ioctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy_req);
-        close(drm_fd);
-        drm_fd = -1;
-        return HAL_LCD_ERROR;
+    if (active_buffers < buffer_count) {
+        LOGW("Swap chain reduced to %d buffer(s)", active_buffers);
     }
 
-    fb_id = fb_cmd.fb_id;
-    printf("Created framebuffer: ID=%u\n", fb_id);
-
-    /* Map the buffer to user space */
-    memset(&map_req, 0, sizeof(map_req));
-    map_req.handle = create_req.handle;
-
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_MAP_DUMB, &map_req) < 0) {
-        printf("Error: Cannot map dumb buffer: %s\n", strerror(errno));
-        ioctl(drm_fd, DRM_IOCTL_MODE_RMFB, &fb_id);
-        struct drm_mode_destroy_dumb destroy_req = { .handle = create_req.handle };
-        ioctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy_req);
-        close(drm_fd);
-        drm_fd = -1;
-        return HAL_LCD_ERROR;
+    buffer_size = buffers[0].size;
+    fb.width = mode.hdisplay;
+    fb.height = mode.vdisplay;
+    scanout_index = -1;
+    pending_index = -1;
+    page_flip_supported = true;
+    init_stats.buffers_us = (uint32_t)(lcd_now_us() - phase);
+
+    /* Overlay planes for hal_lcd_layer_create(), and the primary plane for atomic */
+    phase = lcd_now_us();
+    discover_planes();
+    if (atomic_supported && !atomic_init()) {
+        LOGI("Atomic KMS incomplete, using legacy ioctls");
+        atomic_supported = false;
+    }
+    LCD_INFO("KMS path: %s", atomic_supported ? "atomic" : "legacy");
+    init_stats.planes_us = (uint32_t)(lcd_now_us() - phase);
+
+    /*
+     * Fast start leaves whatever is on screen (boot splash, previous run)
+     * up until the first swap, which then sets the mode with its frame.
+     */
+    modeset_pending = lcd_config.fast_start;
+    if (!modeset_pending && buffers[0].fb_id > 0) {
+        phase = lcd_now_us();
+        if (set_crtc(0) != HAL_LCD_OK) {
+            LOGW("Display might not show on screen");
+        } else {
+            LCD_INFO("Successfully set display mode");
+        }
+        init_stats.modeset_us = (uint32_t)(lcd_now_us() - phase);
     }
 
-    printf("Map buffer: offset=%llu\n", map_req.offset);
-
-    /* Memory map the framebuffer */
-    buffer_size = create_req.size;
-    fb_buffer = (uint32_t *)mmap(0, buffer_size, PROT_READ | PROT_WRITE, 
-                                MAP_SHARED, drm_fd, map_req.offset);
-    
-    if (fb_buffer == MAP_FAILED) {
-        printf("Error: Cannot mmap buffer: %s\n", strerror(errno));
-        ioctl(drm_fd, DRM_IOCTL_MODE_RMFB, &fb_id);
-        struct drm_mode_destroy_dumb destroy_req = { .handle = create_req.handle };
-        ioctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy_req);
-        close(drm_fd);
-        drm_fd = -1;
-        return HAL_LCD_ERROR;
+    /* Optional cached shadow buffer, flushed by damage on swap */
+    phase = lcd_now_us();
+    if (shadow_requested && create_shadow() != HAL_LCD_OK) {
+        /*
+         * Shadow users repaint only what changed, which a back buffer one
+         * or two frames old does not hold: draw to the scanout buffer.
+         */
+        LOGW("No shadow framebuffer, drawing to a single buffer");
+        while (active_buffers > 1) {
+            destroy_buffer(&buffers[--active_buffers]);
+        }
     }
 
-    /* Set the display mode and connect framebuffer to display */
-    struct drm_mode_crtc crtc = {0};
-    crtc.crtc_id = crtc_id;                          /* CRTC 41 */
-    crtc.fb_id = fb_id;                              /* Our framebuffer */
-    crtc.set_connectors_ptr = (uint64_t)&connector_id; /* DSI connector 34 */
-    crtc.count_connectors = 1;                       /* Only one connector */
-    crtc.mode = mode;                                /* Our display mode */
-    crtc.mode_valid = 1;                             /* Mode is valid */
+    /* Draw into the first buffer that is not on screen */
+    set_draw_buffer(active_buffers > 1 ? 1 : 0, false);
 
-    if (ioctl(drm_fd, DRM_IOCTL_MODE_SETCRTC, &crtc) < 0) {
-        printf("Warning: Cannot set CRTC mode: %s\n", strerror(errno));
-        printf("Display might not show on screen\n");
+    if (lcd_config.fast_start) {
+        /* Dumb buffers start out zeroed, the shadow only has to match them */
+        if (shadow_buffer) {
+            memset(shadow_buffer, 0, shadow_pitch * fb.height);
+            memset(shadow_copy, 0, shadow_pitch * fb.height);
+        }
     } else {
-        printf("Successfully set display mode\n");
+        /* Clear screen to red to test */
+        uint32_t red = native_color(fb.format, LCD_COLOR_RED);
+        for (int i = 0; i < active_buffers; i++) {
+            fill_native(fb.format, buffers[i].map, buffers[i].pitch, fb.width, fb.height, red);
+        }
+        if (shadow_buffer) {
+            fill_native(fb.format, shadow_buffer, shadow_pitch, fb.width, fb.height, red);
+            fill_native(fb.format, shadow_copy, shadow_pitch, fb.width, fb.height, red);
+        }
     }
+    init_stats.clear_us = (uint32_t)(lcd_now_us() - phase);
 
+    lcd_stats_reset(mode.vrefresh);
     lcd_initialized = true;
-    printf("LCD DRM initialized successfully (%dx%d, %d bpp, buffer size: %zu)\n", 
-           mode.hdisplay, mode.vdisplay, LCD_BPP, buffer_size);
-
-    /* Clear screen to red to test */
-    hal_lcd_clear(LCD_COLOR_BLACK);
+    init_stats.total_us = (uint32_t)(lcd_now_us() - init_start);
+    LCD_INFO("LCD DRM initialized successfully (%dx%d, %d bpp, buffer size: %zu, %d buffer(s)%s)",
+             fb.width, fb.height, fb.bpp, buffer_size, active_buffers,
+             shadow_buffer ? ", shadow" : "");
 
     return HAL_LCD_OK;
 }
 
-#endif
-
 hal_lcd_status_t hal_lcd_deinit(void)
 {
     if (!lcd_initialized) {
         return HAL_LCD_OK;
     }
     
-    printf("Deinitializing LCD DRM...\n");
-    
-    /* Clear screen */
-    hal_lcd_clear(LCD_COLOR_BLACK);
-    
-    /* Unmap buffer */
-    if (fb_buffer != NULL && fb_buffer != MAP_FAILED) {
-        munmap(fb_buffer, buffer_size);
-        fb_buffer = NULL;
+    LCD_INFO("Deinitializing LCD DRM...");
+
+    lcd_stats_shutdown();
+
+    /* Let the in-flight flip land before tearing buffers down */
+    wait_flip();
+
+    for (int i = 0; i < HAL_LCD_MAX_LAYERS; i++) {
+        if (layers[i].used) {
+            hal_lcd_layer_destroy(i);
+        }
     }
+    plane_count = 0;
 
-    /* Remove framebuffer */
-    if (fb_id) {
-        ioctl(drm_fd, DRM_IOCTL_MODE_RMFB, &fb_id);
-        fb_id = 0;
+    if (out_fence_fd >= 0) {
+        close(out_fence_fd);
+        out_fence_fd = -1;
     }
+    if (mode_blob_id) {
+        struct drm_mode_destroy_blob blob = { .blob_id = mode_blob_id };
+        ioctl(drm_fd, DRM_IOCTL_MODE_DESTROYPROPBLOB, &blob);
+        mode_blob_id = 0;
+    }
+    
+    /* Clear screen */
+    int blank = (scanout_index >= 0) ? scanout_index : draw_index;
+    fill_native(fb.format, buffers[blank].map, buffers[blank].pitch, fb.width, fb.height,
+                native_color(fb.format, LCD_COLOR_BLACK));
 
-    /* Destroy dumb buffer */
-    struct drm_mode_destroy_dumb destroy_req;
-    memset(&destroy_req, 0, sizeof(destroy_req));
-    destroy_req.handle = create_req.handle;
-    ioctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy_req);
+    destroy_shadow();
+    
+    /* Unmap buffers, remove framebuffers and destroy dumb buffers */
+    for (int i = 0; i < active_buffers; i++) {
+        destroy_buffer(&buffers[i]);
+    }
+    active_buffers = 0;
+    fb.base = NULL;
+    draw_busy = false;
+    scanout_index = -1;
+    modeset_pending = false;
 
     /* Close DRM device */
     if (drm_fd >= 0) {
@@ -491,22 +502,28 @@ hal_lcd_status_t hal_lcd_deinit(void)
     }
 
     lcd_initialized = false;
-    printf("LCD DRM deinitialized\n");
+    LCD_INFO("LCD DRM deinitialized");
     return HAL_LCD_OK;
 }
 
 hal_lcd_status_t hal_lcd_clear(uint32_t color)
 {
-    if (!lcd_initialized || fb_buffer == NULL) {
+    if (!lcd_initialized || fb.base == NULL) {
         return HAL_LCD_NOT_INITIALIZED;
     }
+
+    /* Back buffer may still be on screen until the pending flip lands */
+    if (draw_busy && shadow_buffer == NULL) {
+        wait_flip();
+    }
     
-    printf("Clearing screen with color 0x%08X\n", color);
+    LOGD("Clearing screen with color 0x%08X", color);
     
     /* Fill entire buffer with color using actual mode dimensions */
-    int pixels = mode.hdisplay * mode.vdisplay;
-    for (int i = 0; i < pixels; i++) {
-        fb_buffer[i] = color;
+    fill_native(fb.format, fb.base, fb.pitch, fb.width, fb.height, native_color(fb.format, color));
+
+    if (shadow_buffer) {
+        damage_add(&frame_damage, 0, 0, fb.width, fb.height);
     }
     
     return HAL_LCD_OK;
@@ -514,108 +531,1838 @@ hal_lcd_status_t hal_lcd_clear(uint32_t color)
 
 hal_lcd_status_t hal_lcd_set_pixel(uint16_t x, uint16_t y, uint32_t color)
 {
-    if (!lcd_initialized || fb_buffer == NULL) {
+    if (!lcd_initialized || fb.base == NULL) {
         return HAL_LCD_NOT_INITIALIZED;
     }
+
+    /* Back buffer may still be on screen until the pending flip lands */
+    if (draw_busy && shadow_buffer == NULL) {
+        wait_flip();
+    }
     
-    if (x >= LCD_WIDTH || y >= LCD_HEIGHT) {
+    if (x >= fb.width || y >= fb.height) {
         return HAL_LCD_INVALID_PARAM;
     }
     
-    fb_buffer[y * LCD_WIDTH + x] = color;
+    if (fb.format == HAL_LCD_FORMAT_RGB565) {
+        *(uint16_t *)fb_pixel(x, y) = hal_pixel_rgb565(color);
+    } else {
+        *(uint32_t *)fb_pixel(x, y) = color;
+    }
+
+    if (shadow_buffer) {
+        mark_pixel(x, y);
+    }
     return HAL_LCD_OK;
 }
 
 hal_lcd_status_t hal_lcd_draw_rectangle(hal_lcd_rect_t rect, uint32_t color, bool filled)
 {
-    if (!lcd_initialized || fb_buffer == NULL) {
+    if (!lcd_initialized || fb.base == NULL) {
         return HAL_LCD_NOT_INITIALIZED;
     }
+
+    /* Back buffer may still be on screen until the pending flip lands */
+    if (draw_busy && shadow_buffer == NULL) {
+        wait_flip();
+    }
     
-    if (rect.x >= LCD_WIDTH || rect.y >= LCD_HEIGHT) {
+    if (rect.x >= fb.width || rect.y >= fb.height) {
         return HAL_LCD_INVALID_PARAM;
     }
     
     /* Clamp rectangle to screen bounds */
-    uint16_t end_x = (rect.x + rect.width > LCD_WIDTH) ? LCD_WIDTH : rect.x + rect.width;
-    uint16_t end_y = (rect.y + rect.height > LCD_HEIGHT) ? LCD_HEIGHT : rect.y + rect.height;
+    uint16_t end_x = (rect.x + rect.width > fb.width) ? fb.width : rect.x + rect.width;
+    uint16_t end_y = (rect.y + rect.height > fb.height) ? fb.height : rect.y + rect.height;
+    int w = end_x - rect.x;
+    int h = end_y - rect.y;
+    if (w == 0 || h == 0) {
+        return HAL_LCD_OK;
+    }
+
+    uint32_t native = native_color(fb.format, color);
     
     if (filled) {
         /* Fill rectangle */
-        for (uint16_t y = rect.y; y < end_y; y++) {
-            for (uint16_t x = rect.x; x < end_x; x++) {
-                fb_buffer[y * LCD_WIDTH + x] = color;
-            }
-        }
+        fill_native(fb.format, fb_pixel(rect.x, rect.y), fb.pitch, w, h, native);
     } else {
         /* Draw rectangle outline */
         /* Top and bottom lines */
-        for (uint16_t x = rect.x; x < end_x; x++) {
-            if (rect.y < LCD_HEIGHT) fb_buffer[rect.y * LCD_WIDTH + x] = color;
-            if (end_y - 1 < LCD_HEIGHT) fb_buffer[(end_y - 1) * LCD_WIDTH + x] = color;
-        }
+        fill_native(fb.format, fb_pixel(rect.x, rect.y), fb.pitch, w, 1, native);
+        fill_native(fb.format, fb_pixel(rect.x, end_y - 1), fb.pitch, w, 1, native);
         /* Left and right lines */
-        for (uint16_t y = rect.y; y < end_y; y++) {
-            if (rect.x < LCD_WIDTH) fb_buffer[y * LCD_WIDTH + rect.x] = color;
-            if (end_x - 1 < LCD_WIDTH) fb_buffer[y * LCD_WIDTH + (end_x - 1)] = color;
-        }
+        fill_native(fb.format, fb_pixel(rect.x, rect.y), fb.pitch, 1, h, native);
+        fill_native(fb.format, fb_pixel(end_x - 1, rect.y), fb.pitch, 1, h, native);
+    }
+
+    if (shadow_buffer) {
+        damage_add(&frame_damage, rect.x, rect.y, end_x, end_y);
     }
     
     return HAL_LCD_OK;
 }
 
-/**
- * @brief Shutdown the LCD subsystem
- * @return HAL_LCD_OK on success, error code otherwise
- */
-hal_lcd_status_t hal_lcd_shutdown(void)
+/* Shared by blit and blend: clip to the screen, return false if nothing is left */
+static bool clip_image_rect(hal_lcd_rect_t *rect)
 {
-    /* Call deinit function */
-    return hal_lcd_deinit();
+    if (rect->x >= fb.width || rect->y >= fb.height) {
+        return false;
+    }
+    if (rect->x + rect->width > fb.width) {
+        rect->width = fb.width - rect->x;
+    }
+    if (rect->y + rect->height > fb.height) {
+        rect->height = fb.height - rect->y;
+    }
+    return rect->width > 0 && rect->height > 0;
 }
 
-/**
- * @brief Get LCD information
- * @param info Pointer to structure to fill with LCD info
- * @return HAL_LCD_OK on success, error code otherwise
- */
-hal_lcd_status_t hal_lcd_get_info(void *info)
+hal_lcd_status_t hal_lcd_blit(hal_lcd_rect_t rect, const uint32_t *src, uint32_t src_pitch)
 {
-    if (!lcd_initialized) {
+    if (!lcd_initialized || fb.base == NULL) {
         return HAL_LCD_NOT_INITIALIZED;
     }
-    
-    if (info == NULL) {
+
+    if (src == NULL || src_pitch < rect.width * sizeof(uint32_t)) {
         return HAL_LCD_INVALID_PARAM;
     }
-    
-    /* Assume info is hal_ui_info_t structure */
-    typedef struct {
-        int w, h;
-        int bpp;
-        int pitch;
-    } hal_ui_info_t;
-    
-    hal_ui_info_t *lcd_info = (hal_ui_info_t *)info;
-    lcd_info->w = LCD_WIDTH;
-    lcd_info->h = LCD_HEIGHT;
-    lcd_info->bpp = LCD_BPP;
-    lcd_info->pitch = LCD_WIDTH * (LCD_BPP / 8);
-    
+
+    /* Back buffer may still be on screen until the pending flip lands */
+    if (draw_busy && shadow_buffer == NULL) {
+        wait_flip();
+    }
+
+    if (!clip_image_rect(&rect)) {
+        return HAL_LCD_OK;
+    }
+
+    if (fb.format == HAL_LCD_FORMAT_RGB565) {
+        hal_pixel_convert_rect565((uint16_t *)fb_pixel(rect.x, rect.y), fb.pitch,
+                                  src, src_pitch, rect.width, rect.height);
+    } else {
+        hal_pixel_copy_rect((uint32_t *)fb_pixel(rect.x, rect.y), fb.pitch,
+                            src, src_pitch, rect.width, rect.height);
+    }
+
+    if (shadow_buffer) {
+        damage_add(&frame_damage, rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+    }
+
     return HAL_LCD_OK;
 }
 
-/**
- * @brief Swap/refresh the LCD display buffer
- * @return HAL_LCD_OK on success, error code otherwise
- */
-hal_lcd_status_t hal_lcd_swap(void)
+hal_lcd_status_t hal_lcd_blend_rect(hal_lcd_rect_t rect, const uint32_t *src, uint32_t src_pitch)
+{
+    if (!lcd_initialized || fb.base == NULL) {
+        return HAL_LCD_NOT_INITIALIZED;
+    }
+
+    if (src == NULL || src_pitch < rect.width * sizeof(uint32_t)) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    /* Back buffer may still be on screen until the pending flip lands */
+    if (draw_busy && shadow_buffer == NULL) {
+        wait_flip();
+    }
+
+    if (!clip_image_rect(&rect)) {
+        return HAL_LCD_OK;
+    }
+
+    if (fb.format == HAL_LCD_FORMAT_RGB565) {
+        hal_pixel_blend_rect565((uint16_t *)fb_pixel(rect.x, rect.y), fb.pitch,
+                                src, src_pitch, rect.width, rect.height);
+    } else {
+        hal_pixel_blend_rect((uint32_t *)fb_pixel(rect.x, rect.y), fb.pitch,
+                             src, src_pitch, rect.width, rect.height);
+    }
+
+    if (shadow_buffer) {
+        damage_add(&frame_damage, rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+    }
+
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_get_framebuffer(hal_lcd_fb_t *out)
 {
     if (!lcd_initialized) {
         return HAL_LCD_NOT_INITIALIZED;
     }
-    
-    /* For framebuffer-based LCD, no explicit swap needed */
-    /* The buffer is automatically displayed */
+
+    if (out == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    *out = fb;
     return HAL_LCD_OK;
 }
+
+hal_lcd_status_t hal_lcd_mark_dirty(hal_lcd_rect_t rect)
+{
+    if (!lcd_initialized) {
+        return HAL_LCD_NOT_INITIALIZED;
+    }
+
+    if (shadow_buffer) {
+        damage_add(&frame_damage, rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+    }
+
+    return HAL_LCD_OK;
+}
+
+int hal_lcd_get_layer_count(void)
+{
+    return lcd_initialized ? plane_count : 0;
+}
+
+hal_lcd_status_t hal_lcd_layer_create(hal_lcd_rect_t rect, hal_lcd_format_t format, hal_lcd_layer_t *layer)
+{
+    if (!lcd_initialized) {
+        return HAL_LCD_NOT_INITIALIZED;
+    }
+
+    if (layer == NULL || rect.width == 0 || rect.height == 0 || format > HAL_LCD_FORMAT_ARGB8888) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    /* Layer slot i drives planes[i] */
+    int slot = -1;
+    for (int i = 0; i < plane_count; i++) {
+        if (!layers[i].used && plane_supports(planes[i], format)) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        LOGE("No free overlay plane for format %d", format);
+        return HAL_LCD_BUSY;
+    }
+
+    lcd_layer_t *l = &layers[slot];
+    memset(l, 0, sizeof(*l));
+    l->plane_id = planes[slot];
+
+    for (int i = 0; i < LCD_LAYER_BUFFERS; i++) {
+        if (create_buffer(&l->buffers[i], rect.width, rect.height, format) != HAL_LCD_OK ||
+            l->buffers[i].fb_id == 0) {
+            for (int j = 0; j <= i; j++) {
+                destroy_buffer(&l->buffers[j]);
+            }
+            return HAL_LCD_ERROR;
+        }
+        /* Transparent for ARGB8888, black otherwise */
+        fill_native(format, l->buffers[i].map, l->buffers[i].pitch, rect.width, rect.height,
+                    (format == HAL_LCD_FORMAT_ARGB8888) ? 0 : native_color(format, LCD_COLOR_BLACK));
+    }
+
+    l->zpos_prop = find_property(l->plane_id, DRM_MODE_OBJECT_PLANE, "zpos", NULL);
+    l->zpos = -1;
+    l->x = rect.x;
+    l->y = rect.y;
+    l->back = 0;
+    l->front = 1;
+    l->fb.base = l->buffers[0].map;
+    l->fb.pitch = l->buffers[0].pitch;
+    l->fb.width = rect.width;
+    l->fb.height = rect.height;
+    l->fb.format = format;
+    l->fb.bpp = format_bpp(format);
+    l->used = true;
+
+    LCD_INFO("Layer %d on plane %u (%ux%u%s)", slot, l->plane_id, rect.width, rect.height,
+             l->zpos_prop ? ", zpos" : "");
+    *layer = slot;
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_layer_destroy(hal_lcd_layer_t layer)
+{
+    lcd_layer_t *l = get_layer(layer);
+    if (l == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    hal_lcd_layer_hide(layer);
+
+    /* The plane must be off before its buffers go away */
+    l->busy = true;
+    layer_wait(l);
+    for (int i = 0; i < LCD_LAYER_BUFFERS; i++) {
+        destroy_buffer(&l->buffers[i]);
+    }
+    l->used = false;
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_layer_get_framebuffer(hal_lcd_layer_t layer, hal_lcd_fb_t *out)
+{
+    lcd_layer_t *l = get_layer(layer);
+    if (l == NULL || out == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    layer_wait(l);
+    *out = l->fb;
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_layer_fill(hal_lcd_layer_t layer, hal_lcd_rect_t rect, uint32_t color)
+{
+    lcd_layer_t *l = get_layer(layer);
+    if (l == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    if (rect.x >= l->fb.width || rect.y >= l->fb.height) {
+        return HAL_LCD_OK;
+    }
+    int w = (rect.x + rect.width > l->fb.width) ? l->fb.width - rect.x : rect.width;
+    int h = (rect.y + rect.height > l->fb.height) ? l->fb.height - rect.y : rect.height;
+
+    layer_wait(l);
+    uint8_t *origin = (uint8_t *)l->fb.base + (size_t)rect.y * l->fb.pitch + (size_t)rect.x * (l->fb.bpp / 8);
+    fill_native(l->fb.format, origin, l->fb.pitch, w, h, native_color(l->fb.format, color));
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_layer_blit(hal_lcd_layer_t layer, hal_lcd_rect_t rect,
+                                    const uint32_t *src, uint32_t src_pitch)
+{
+    lcd_layer_t *l = get_layer(layer);
+    if (l == NULL || src == NULL || src_pitch < rect.width * sizeof(uint32_t)) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    if (rect.x >= l->fb.width || rect.y >= l->fb.height) {
+        return HAL_LCD_OK;
+    }
+    int w = (rect.x + rect.width > l->fb.width) ? l->fb.width - rect.x : rect.width;
+    int h = (rect.y + rect.height > l->fb.height) ? l->fb.height - rect.y : rect.height;
+
+    layer_wait(l);
+    /* Straight copy keeps the source alpha for the plane blender */
+    uint8_t *origin = (uint8_t *)l->fb.base + (size_t)rect.y * l->fb.pitch + (size_t)rect.x * (l->fb.bpp / 8);
+    if (l->fb.format == HAL_LCD_FORMAT_RGB565) {
+        hal_pixel_convert_rect565((uint16_t *)origin, l->fb.pitch, src, src_pitch, w, h);
+    } else {
+        hal_pixel_copy_rect((uint32_t *)origin, l->fb.pitch, src, src_pitch, w, h);
+    }
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_layer_commit(hal_lcd_layer_t layer)
+{
+    lcd_layer_t *l = get_layer(layer);
+    if (l == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    /* Finish the previous change before the buffers trade places again */
+    layer_wait(l);
+
+    bool was_visible = l->visible;
+    int front = l->front;
+    l->front = l->back;
+    l->visible = true;
+    if (apply_layer(l) != HAL_LCD_OK) {
+        l->front = front;
+        l->visible = was_visible;
+        return HAL_LCD_ERROR;
+    }
+
+    /*
+     * SETPLANE returns once the new buffer is latched, so the previous
+     * one is free to draw; an atomic change keeps it busy until the
+     * commit lands. Like the primary chain it holds an older frame:
+     * redraw the layer fully before the next commit.
+     */
+    l->busy = atomic_supported && was_visible;
+    l->back = front;
+    l->fb.base = l->buffers[l->back].map;
+    l->fb.pitch = l->buffers[l->back].pitch;
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_layer_move(hal_lcd_layer_t layer, int x, int y)
+{
+    lcd_layer_t *l = get_layer(layer);
+    if (l == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    int old_x = l->x;
+    int old_y = l->y;
+    l->x = x;
+    l->y = y;
+    if (!l->visible) {
+        return HAL_LCD_OK;
+    }
+
+    /* Same content at the new position, no redraw or upload */
+    if (apply_layer(l) != HAL_LCD_OK) {
+        l->x = old_x;
+        l->y = old_y;
+        return HAL_LCD_ERROR;
+    }
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_layer_set_zpos(hal_lcd_layer_t layer, int zpos)
+{
+    lcd_layer_t *l = get_layer(layer);
+    if (l == NULL || zpos < 0) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    if (l->zpos_prop == 0) {
+        return HAL_LCD_ERROR;
+    }
+
+    if (atomic_supported) {
+        int old = l->zpos;
+        l->zpos = zpos;
+        if (!atomic_test_layer(l)) {
+            l->zpos = old;
+            return HAL_LCD_ERROR;
+        }
+        l->staged = true;
+        return HAL_LCD_OK;
+    }
+    l->zpos = zpos;
+
+    struct drm_mode_obj_set_property prop = {0};
+    prop.obj_id = l->plane_id;
+    prop.obj_type = DRM_MODE_OBJECT_PLANE;
+    prop.prop_id = l->zpos_prop;
+    prop.value = (uint64_t)zpos;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_OBJ_SETPROPERTY, &prop) < 0) {
+        LOGE("Cannot set zpos %d on plane %u: %s", zpos, l->plane_id, strerror(errno));
+        return HAL_LCD_ERROR;
+    }
+
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_layer_hide(hal_lcd_layer_t layer)
+{
+    lcd_layer_t *l = get_layer(layer);
+    if (l == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    if (!l->visible) {
+        return HAL_LCD_OK;
+    }
+
+    l->visible = false;
+    if (apply_layer(l) != HAL_LCD_OK) {
+        l->visible = true;
+        return HAL_LCD_ERROR;
+    }
+
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_commit_layers(void)
+{
+    if (!lcd_initialized) {
+        return HAL_LCD_NOT_INITIALIZED;
+    }
+
+    if (!atomic_supported) {
+        return HAL_LCD_OK;
+    }
+
+    process_events(0);
+    if (pending_index >= 0) {
+        if (swap_mode == HAL_LCD_SWAP_NONBLOCKING) {
+            return HAL_LCD_BUSY;
+        }
+        wait_flip();
+    }
+
+    lcd_atomic_req_t req = {0};
+    if (!atomic_add_layers(&req)) {
+        return HAL_LCD_OK;
+    }
+
+    /* Without a scanout buffer there is no flip to track, commit synchronously */
+    if (scanout_index < 0) {
+        return atomic_commit(&req, 0, 0);
+    }
+
+    hal_lcd_status_t status = atomic_commit(&req, DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT,
+                                            (uint64_t)scanout_index);
+    if (status == HAL_LCD_OK) {
+        /* The primary buffer stays, completion only releases the layers */
+        pending_index = scanout_index;
+    }
+    return status;
+}
+
+bool hal_lcd_is_atomic(void)
+{
+    return lcd_initialized && atomic_supported;
+}
+
+hal_lcd_status_t hal_lcd_set_out_fence(bool enable)
+{
+    if (enable && lcd_initialized && !atomic_supported) {
+        return HAL_LCD_ERROR;
+    }
+
+    out_fence_requested = enable;
+    return HAL_LCD_OK;
+}
+
+int hal_lcd_take_out_fence(void)
+{
+    int fd = out_fence_fd;
+    out_fence_fd = -1;
+    return fd;
+}
+
+hal_lcd_status_t hal_lcd_set_neon(bool enable)
+{
+    if (hal_pixel_select(enable) != enable) {
+        /* Requested NEON on a CPU without it, scalar kernels stay selected */
+        return HAL_LCD_ERROR;
+    }
+
+    return HAL_LCD_OK;
+}
+
+/**
+ * @brief Shutdown the LCD subsystem
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_shutdown(void)
+{
+    /* Call deinit function */
+    return hal_lcd_deinit();
+}
+
+/**
+ * @brief Get LCD information
+ * @param info Pointer to structure to fill with LCD info
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_get_info(void *info)
+{
+    if (!lcd_initialized) {
+        return HAL_LCD_NOT_INITIALIZED;
+    }
+    
+    if (info == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+    
+    /* Assume info is hal_ui_info_t structure */
+    hal_ui_info_t *lcd_info = (hal_ui_info_t *)info;
+    lcd_info->w = fb.width;
+    lcd_info->h = fb.height;
+    lcd_info->bpp = fb.bpp;
+    lcd_info->pitch = fb.pitch;
+    
+    return HAL_LCD_OK;
+}
+
+/**
+ * @brief Swap/refresh the LCD display buffer
+ * @return HAL_LCD_OK on success, error code otherwise
+ */
+hal_lcd_status_t hal_lcd_swap(void)
+{
+    if (!lcd_initialized) {
+        return HAL_LCD_NOT_INITIALIZED;
+    }
+
+    lcd_stats_swap_begin();
+    hal_lcd_status_t status = swap_frame();
+    if (status == HAL_LCD_OK) {
+        lcd_stats_swap_end(last_flush_bytes);
+        if (init_stats.first_frame_us == 0) {
+            init_stats.first_frame_us = (uint32_t)(lcd_now_us() - init_start);
+        }
+    }
+
+    return status;
+}
+
+static hal_lcd_status_t swap_frame(void)
+{
+    /* Single buffer: the buffer is scanned out directly, no swap needed */
+    if (active_buffers < 2) {
+        if (shadow_buffer) {
+            flush_shadow(0);
+        }
+        return modeset_pending ? first_modeset(0) : HAL_LCD_OK;
+    }
+
+    /* Fast start: this frame replaces the boot splash through the mode set */
+    if (modeset_pending) {
+        if (shadow_buffer) {
+            flush_shadow(draw_index);
+        }
+        hal_lcd_status_t status = first_modeset(draw_index);
+        if (status == HAL_LCD_OK) {
+            set_draw_buffer(find_free_buffer(), false);
+        }
+        return status;
+    }
+
+    /* Pick up flips that completed since the last call */
+    process_events(0);
+
+    if (swap_mode == HAL_LCD_SWAP_NONBLOCKING) {
+        /* A flip cannot be queued behind another, with any buffer count: retry after it */
+        if (pending_index >= 0) {
+            return HAL_LCD_BUSY;
+        }
+    } else if (draw_busy) {
+        wait_flip();
+    }
+
+    /* With a spare buffer the flush overlaps the flip still in flight */
+    if (shadow_buffer) {
+        flush_shadow(draw_index);
+    }
+
+    if (pending_index >= 0) {
+        wait_flip();
+    }
+
+    int released = scanout_index;
+    hal_lcd_status_t status = submit_flip(draw_index);
+    if (status != HAL_LCD_OK) {
+        return status;
+    }
+
+    int next = find_free_buffer();
+    if (next >= 0) {
+        set_draw_buffer(next, false);
+    } else {
+        /* Double buffering: the old front becomes the back buffer once the flip lands */
+        set_draw_buffer(released, true);
+        if (swap_mode == HAL_LCD_SWAP_BLOCKING && shadow_buffer == NULL) {
+            wait_flip();
+        }
+    }
+
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_set_buffer_count(int count)
+{
+    if (lcd_initialized) {
+        return HAL_LCD_ERROR;
+    }
+
+    if (count < 1 || count > HAL_LCD_MAX_BUFFERS) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    buffer_count = count;
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_set_shadow(bool enable)
+{
+    if (lcd_initialized) {
+        return HAL_LCD_ERROR;
+    }
+
+    shadow_requested = enable;
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_set_swap_mode(hal_lcd_swap_mode_t swap)
+{
+    if (swap != HAL_LCD_SWAP_BLOCKING && swap != HAL_LCD_SWAP_NONBLOCKING) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    swap_mode = swap;
+    return HAL_LCD_OK;
+}
+
+size_t hal_lcd_get_flush_bytes(void)
+{
+    return __atomic_load_n(&last_flush_bytes, __ATOMIC_RELAXED);
+}
+
+hal_lcd_status_t hal_lcd_get_init_stats(hal_lcd_init_stats_t *stats)
+{
+    if (stats == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+    if (init_start == 0) {
+        return HAL_LCD_NOT_INITIALIZED;
+    }
+
+    *stats = init_stats;
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_get_stats(hal_lcd_stats_t *stats)
+{
+#if HAL_LCD_STATS
+    if (stats == NULL) {
+        return HAL_LCD_INVALID_PARAM;
+    }
+
+    lcd_stats_get(stats);
+    return HAL_LCD_OK;
+#else
+    (void)stats;
+    return HAL_LCD_ERROR;
+#endif
+}
+
+hal_lcd_status_t hal_lcd_reset_stats(void)
+{
+    /* Applied by the render thread at the next swap */
+    lcd_stats_request_reset();
+    return HAL_LCD_OK;
+}
+
+hal_lcd_status_t hal_lcd_set_stats_file(const char *path, uint32_t period_ms)
+{
+#if HAL_LCD_STATS
+    if (!lcd_stats_set_file(path, period_ms)) {
+        LOGE("Failed to start the stats file writer");
+        return HAL_LCD_ERROR;
+    }
+    return HAL_LCD_OK;
+#else
+    (void)path;
+    (void)period_ms;
+    return HAL_LCD_ERROR;
+#endif
+}
+
+int hal_lcd_get_fd(void)
+{
+    return lcd_initialized ? drm_fd : -1;
+}
+
+hal_lcd_status_t hal_lcd_handle_events(int timeout_ms)
+{
+    if (!lcd_initialized) {
+        return HAL_LCD_NOT_INITIALIZED;
+    }
+
+    /* Nothing to wait for, but still drain a late event so the fd stops polling readable */
+    if (pending_index < 0) {
+        timeout_ms = 0;
+    }
+
+    return (process_events(timeout_ms) < 0) ? HAL_LCD_ERROR : HAL_LCD_OK;
+}
+
+bool hal_lcd_flip_pending(void)
+{
+    return lcd_initialized && pending_index >= 0;
+}
+
+/* Internal helper functions */
+
+static hal_lcd_status_t create_buffer(lcd_buffer_t *buf, uint16_t width, uint16_t height,
+                                      hal_lcd_format_t format)
+{
+    struct drm_mode_create_dumb create_req = {0};
+    create_req.width = width;
+    create_req.height = height;
+    create_req.bpp = format_bpp(format);
+
+    LOGD("Creating buffer: %dx%d@%dbpp", create_req.width, create_req.height, create_req.bpp);
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_CREATE_DUMB, &create_req) < 0) {
+        LOGE("Cannot create dumb buffer: %s", strerror(errno));
+        return HAL_LCD_ERROR;
+    }
+
+    LOGD("Created dumb buffer: handle=%u, pitch=%u, size=%llu",
+         create_req.handle, create_req.pitch, create_req.size);
+
+    buf->handle = create_req.handle;
+    buf->pitch = create_req.pitch;
+    buf->size = create_req.size;
+
+    /* Create framebuffer object, the legacy bpp/depth pair selects the format */
+    struct drm_mode_fb_cmd fb_cmd = {0};
+    fb_cmd.width = width;
+    fb_cmd.height = height;
+    fb_cmd.pitch = create_req.pitch;
+    fb_cmd.bpp = create_req.bpp;
+    fb_cmd.depth = (format == HAL_LCD_FORMAT_RGB565) ? 16 :
+                   (format == HAL_LCD_FORMAT_ARGB8888) ? 32 : 24;
+    fb_cmd.handle = create_req.handle;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_ADDFB, &fb_cmd) < 0) {
+        LOGW("Cannot create framebuffer object: %s", strerror(errno));
+        LOGI("Continuing without framebuffer object...");
+        buf->fb_id = 0;
+    } else {
+        buf->fb_id = fb_cmd.fb_id;
+        LOGD("Created framebuffer: ID=%u", buf->fb_id);
+    }
+
+    /* Map the buffer */
+    struct drm_mode_map_dumb map_req = {0};
+    map_req.handle = create_req.handle;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_MAP_DUMB, &map_req) < 0) {
+        LOGE("Cannot map dumb buffer: %s", strerror(errno));
+        destroy_buffer(buf);
+        return HAL_LCD_ERROR;
+    }
+
+    buf->map = (uint32_t *)mmap(0, buf->size, PROT_READ | PROT_WRITE, MAP_SHARED, drm_fd, map_req.offset);
+    if (buf->map == MAP_FAILED) {
+        LOGE("Cannot mmap buffer: %s", strerror(errno));
+        buf->map = NULL;
+        destroy_buffer(buf);
+        return HAL_LCD_ERROR;
+    }
+
+    return HAL_LCD_OK;
+}
+
+static void destroy_buffer(lcd_buffer_t *buf)
+{
+    if (buf->map != NULL) {
+        munmap(buf->map, buf->size);
+        buf->map = NULL;
+    }
+
+    if (buf->fb_id) {
+        ioctl(drm_fd, DRM_IOCTL_MODE_RMFB, &buf->fb_id);
+        buf->fb_id = 0;
+    }
+
+    struct drm_mode_destroy_dumb destroy_req = { .handle = buf->handle };
+    ioctl(drm_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy_req);
+    buf->handle = 0;
+}
+
+static hal_lcd_status_t set_crtc(int index)
+{
+    if (atomic_supported) {
+        lcd_atomic_req_t req = {0};
+        atomic_add(&req, connector_id, atomic_props.conn_crtc_id, crtc_id);
+        atomic_add(&req, crtc_id, atomic_props.crtc_mode_id, mode_blob_id);
+        atomic_add(&req, crtc_id, atomic_props.crtc_active, 1);
+        atomic_add_plane(&req, primary_plane_id, buffers[index].fb_id, 0, 0, fb.width, fb.height);
+        atomic_add_layers(&req);
+
+        if (atomic_commit(&req, DRM_MODE_ATOMIC_ALLOW_MODESET, 0) == HAL_LCD_OK) {
+            scanout_index = index;
+            return HAL_LCD_OK;
+        }
+
+        /* A first mode set that fails means atomic does not work here, later ones are retried */
+        if (atomic_supported && scanout_index >= 0) {
+            return HAL_LCD_ERROR;
+        }
+        atomic_fallback();
+    }
+
+    struct drm_mode_crtc crtc = {0};
+    crtc.crtc_id = crtc_id;
+    crtc.fb_id = buffers[index].fb_id;
+    crtc.set_connectors_ptr = (uint64_t)(uintptr_t)&connector_id;
+    crtc.count_connectors = 1;
+    crtc.mode = mode;
+    crtc.mode_valid = 1;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_SETCRTC, &crtc) < 0) {
+        LOG_RATELIMIT(HAL_LOG_WARN, 1000, "Cannot set CRTC mode: %s", strerror(errno));
+        return HAL_LCD_ERROR;
+    }
+
+    scanout_index = index;
+    return HAL_LCD_OK;
+}
+
+static hal_lcd_status_t submit_flip(int index)
+{
+    if (atomic_supported) {
+        /* Primary buffer and every staged layer change land in the same vblank */
+        lcd_atomic_req_t req = {0};
+        atomic_add(&req, primary_plane_id, atomic_props.fb_id, buffers[index].fb_id);
+        atomic_add_layers(&req);
+
+        if (atomic_commit(&req, DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT,
+                          (uint64_t)index) == HAL_LCD_OK) {
+            pending_index = index;
+            lcd_stats_flip_submitted();
+            return HAL_LCD_OK;
+        }
+
+        /* Still atomic: the commit itself failed, the next swap retries it */
+        if (atomic_supported) {
+            return HAL_LCD_ERROR;
+        }
+    }
+
+    if (page_flip_supported) {
+        struct drm_mode_crtc_page_flip flip = {0};
+        flip.crtc_id = crtc_id;
+        flip.fb_id = buffers[index].fb_id;
+        flip.flags = DRM_MODE_PAGE_FLIP_EVENT;
+        flip.user_data = (uint64_t)index;
+
+        if (ioctl(drm_fd, DRM_IOCTL_MODE_PAGE_FLIP, &flip) == 0) {
+            pending_index = index;
+            lcd_stats_flip_submitted();
+            return HAL_LCD_OK;
+        }
+
+        LOGW("Page flip failed (%s), falling back to SETCRTC", strerror(errno));
+        page_flip_supported = false;
+    }
+
+    /* Synchronous fallback, the buffer is on screen when this returns */
+    return set_crtc(index);
+}
+
+static void on_flip_complete(int index)
+{
+    if (index != pending_index) {
+        return;
+    }
+
+    int released = scanout_index;
+    scanout_index = index;
+    pending_index = -1;
+
+    if (draw_busy && draw_index == released) {
+        draw_busy = false;
+    }
+
+    for (int i = 0; i < HAL_LCD_MAX_LAYERS; i++) {
+        if (layers[i].inflight) {
+            layers[i].inflight = false;
+            layers[i].busy = false;
+        }
+    }
+}
+
+static int process_events(int timeout_ms)
+{
+    struct pollfd pfd = { .fd = drm_fd, .events = POLLIN };
+    int rc;
+
+    do {
+        rc = poll(&pfd, 1, timeout_ms);
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc <= 0) {
+        return rc;
+    }
+
+    char buf[1024];
+    ssize_t len = read(drm_fd, buf, sizeof(buf));
+    if (len < 0) {
+        return (errno == EINTR || errno == EAGAIN) ? 0 : -1;
+    }
+
+    for (ssize_t off = 0; off + (ssize_t)sizeof(struct drm_event) <= len; ) {
+        struct drm_event *event = (struct drm_event *)(buf + off);
+        if (event->length < sizeof(struct drm_event)) {
+            break;
+        }
+
+        if (event->type == DRM_EVENT_FLIP_COMPLETE) {
+            struct drm_event_vblank *vblank = (struct drm_event_vblank *)event;
+            if ((int)vblank->user_data == pending_index) {
+                lcd_stats_flip_complete(vblank->tv_sec, vblank->tv_usec);
+            }
+            on_flip_complete((int)vblank->user_data);
+        }
+
+        off += event->length;
+    }
+
+    return 1;
+}
+
+static void wait_flip(void)
+{
+    while (pending_index >= 0) {
+        int rc = process_events(LCD_FLIP_TIMEOUT_MS);
+        if (rc < 0) {
+            LOG_RATELIMIT(HAL_LOG_ERROR, 1000, "Cannot read DRM events: %s", strerror(errno));
+            on_flip_complete(pending_index);
+        } else if (rc == 0) {
+            /* Event never arrived, assume the flip landed so we cannot deadlock */
+            LOG_RATELIMIT(HAL_LOG_WARN, 1000, "Page flip event timed out");
+            on_flip_complete(pending_index);
+        }
+    }
+}
+
+static int find_free_buffer(void)
+{
+    for (int i = 0; i < active_buffers; i++) {
+        if (i != scanout_index && i != pending_index && i != draw_index) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void set_draw_buffer(int index, bool busy)
+{
+    draw_index = index;
+    draw_busy = busy;
+    if (shadow_buffer) {
+        fb.base = shadow_buffer;
+        fb.pitch = shadow_pitch;
+    } else {
+        fb.base = buffers[index].map;
+        fb.pitch = buffers[index].pitch;
+    }
+}
+
+static int select_mode(const struct drm_mode_modeinfo *modes, int count)
+{
+    int preferred = 0;
+
+    for (int i = count - 1; i >= 0; i--) {
+        if (modes[i].type & DRM_MODE_TYPE_PREFERRED) {
+            preferred = i;
+        }
+    }
+
+    if (lcd_config.width == 0 && lcd_config.height == 0) {
+        return preferred;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (modes[i].hdisplay == lcd_config.width && modes[i].vdisplay == lcd_config.height &&
+            (lcd_config.refresh == 0 || modes[i].vrefresh == lcd_config.refresh)) {
+            return i;
+        }
+    }
+
+    LOGW("Mode %ux%u not offered, using %ux%u",
+         lcd_config.width, lcd_config.height, modes[preferred].hdisplay, modes[preferred].vdisplay);
+    return preferred;
+}
+
+/*
+ * Full probe: the first connected connector with modes, else the first one
+ * with modes at all. One GETRESOURCES into fixed arrays (the kernel fills
+ * up to the counts passed in), one probing GETCONNECTOR per connector and a
+ * second one only for the connector that is picked.
+ */
+static hal_lcd_status_t probe_display(bool *found)
+{
+    uint32_t connectors[LCD_MAX_RESOURCES] = {0};
+    uint32_t crtcs[LCD_MAX_RESOURCES] = {0};
+    struct drm_mode_card_res resources = {0};
+
+    resources.connector_id_ptr = (uint64_t)(uintptr_t)connectors;
+    resources.crtc_id_ptr = (uint64_t)(uintptr_t)crtcs;
+    resources.count_connectors = LCD_MAX_RESOURCES;
+    resources.count_crtcs = LCD_MAX_RESOURCES;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_GETRESOURCES, &resources) < 0) {
+        LOGE("Cannot get DRM resources: %s", strerror(errno));
+        return HAL_LCD_ERROR;
+    }
+
+    LOGD("DRM Resources: %d connectors, %d crtcs, %d encoders, %d fbs",
+         resources.count_connectors, resources.count_crtcs,
+         resources.count_encoders, resources.count_fbs);
+
+    if (resources.count_connectors == 0 || resources.count_crtcs == 0) {
+        LOGE("Insufficient DRM resources");
+        return HAL_LCD_ERROR;
+    }
+
+    uint32_t count = resources.count_connectors < LCD_MAX_RESOURCES ?
+                     resources.count_connectors : LCD_MAX_RESOURCES;
+
+    /* Use first CRTC */
+    crtc_index = 0;
+    crtc_id = crtcs[crtc_index];
+    connector_id = connectors[0];
+    LOGD("Using CRTC ID: %d", crtc_id);
+
+    uint32_t fallback = 0, fallback_modes = 0;
+    *found = false;
+    for (uint32_t i = 0; i < count && !*found; i++) {
+        struct drm_mode_get_connector conn = {0};
+        conn.connector_id = connectors[i];
+
+        /* count_modes == 0 makes the kernel probe the connector */
+        if (ioctl(drm_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) < 0) {
+            continue;
+        }
+        LOGD("Connector %d: type=%d, connection=%d, modes=%d",
+             connectors[i], conn.connector_type, conn.connection, conn.count_modes);
+        if (conn.count_modes == 0) {
+            continue;
+        }
+
+        if (conn.connection == DRM_MODE_CONNECTED) {
+            *found = read_modes(connectors[i], conn.count_modes);
+        } else if (fallback == 0) {
+            fallback = connectors[i];
+            fallback_modes = conn.count_modes;
+        }
+    }
+
+    if (!*found && fallback != 0) {
+        LCD_INFO("Using fallback connector ID: %d (not connected but has modes)", fallback);
+        *found = read_modes(fallback, fallback_modes);
+    }
+
+    return HAL_LCD_OK;
+}
+
+/* Second GETCONNECTOR with room for the modes; count != 0 so it does not probe again */
+static bool read_modes(uint32_t id, uint32_t count)
+{
+    struct drm_mode_modeinfo *modes = malloc(count * sizeof(struct drm_mode_modeinfo));
+    if (modes == NULL) {
+        return false;
+    }
+
+    struct drm_mode_get_connector conn = {0};
+    conn.connector_id = id;
+    conn.count_modes = count;
+    conn.modes_ptr = (uint64_t)(uintptr_t)modes;
+
+    bool ok = (ioctl(drm_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) == 0 &&
+               conn.count_modes > 0 && conn.count_modes <= count);
+    if (ok) {
+        connector_id = id;
+        mode = modes[select_mode(modes, conn.count_modes)];
+        LCD_INFO("Using connector %u, display mode: %dx%d@%dHz",
+                 id, mode.hdisplay, mode.vdisplay, mode.vrefresh);
+        LOGD("Mode details: hsync_start=%d, hsync_end=%d, htotal=%d",
+             mode.hsync_start, mode.hsync_end, mode.htotal);
+        LOGD("Mode details: vsync_start=%d, vsync_end=%d, vtotal=%d",
+             mode.vsync_start, mode.vsync_end, mode.vtotal);
+        LOGD("Mode clock: %d, flags: 0x%x", mode.clock, mode.flags);
+    } else {
+        LOGE("Failed to get modes for connector %u", id);
+    }
+
+    free(modes);
+    return ok;
+}
+
+/*
+ * Fast start: take the connector, CRTC and mode from the last full probe.
+ * One non-probing GETCONNECTOR checks that the connector is still there,
+ * still connected and still lists the exact mode; anything else probes.
+ */
+static bool load_mode_cache(void)
+{
+    lcd_mode_cache_t cache;
+    int fd = open(mode_cache_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    ssize_t len = read(fd, &cache, sizeof(cache));
+    close(fd);
+
+    if (len != (ssize_t)sizeof(cache) || cache.magic != LCD_CACHE_MAGIC ||
+        cache.width != lcd_config.width || cache.height != lcd_config.height ||
+        cache.refresh != lcd_config.refresh) {
+        return false;
+    }
+
+    struct drm_mode_modeinfo modes[LCD_CACHE_MODES];
+    struct drm_mode_get_connector conn = {0};
+    conn.connector_id = cache.connector_id;
+    conn.count_modes = LCD_CACHE_MODES;
+    conn.modes_ptr = (uint64_t)(uintptr_t)modes;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_GETCONNECTOR, &conn) < 0 ||
+        conn.connection != DRM_MODE_CONNECTED ||
+        conn.count_modes == 0 || conn.count_modes > LCD_CACHE_MODES) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < conn.count_modes; i++) {
+        if (memcmp(&modes[i], &cache.mode, sizeof(cache.mode)) == 0) {
+            connector_id = cache.connector_id;
+            crtc_id = cache.crtc_id;
+            crtc_index = cache.crtc_index;
+            mode = cache.mode;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Written next to the target and renamed over it, a torn cache just fails to load */
+static void save_mode_cache(void)
+{
+    lcd_mode_cache_t cache = {
+        .magic = LCD_CACHE_MAGIC,
+        .connector_id = connector_id,
+        .crtc_id = crtc_id,
+        .crtc_index = crtc_index,
+        .width = lcd_config.width,
+        .height = lcd_config.height,
+        .refresh = lcd_config.refresh,
+        .mode = mode,
+    };
+    char tmp[sizeof(mode_cache_path) + 4];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", mode_cache_path);
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return;
+    }
+    bool ok = (write(fd, &cache, sizeof(cache)) == (ssize_t)sizeof(cache));
+    close(fd);
+
+    if (!ok || rename(tmp, mode_cache_path) < 0) {
+        unlink(tmp);
+    }
+}
+
+/* Mode set deferred by fast start, done once with the first frame */
+static hal_lcd_status_t first_modeset(int index)
+{
+    modeset_pending = false;
+    if (buffers[index].fb_id == 0) {
+        return HAL_LCD_OK;
+    }
+
+    uint64_t start = lcd_now_us();
+    hal_lcd_status_t status = set_crtc(index);
+    init_stats.modeset_us = (uint32_t)(lcd_now_us() - start);
+
+    /* A stale cache must not fail the next start the same way */
+    if (status != HAL_LCD_OK && mode_cached) {
+        unlink(mode_cache_path);
+    }
+
+    return status;
+}
+
+static hal_lcd_status_t create_shadow(void)
+{
+    size_t pitch = (size_t)fb.width * (fb.bpp / 8);
+    size_t size = pitch * fb.height;
+    void *draw = NULL;
+    void *copy = NULL;
+
+    /* Cache-line aligned so row copies stay on wide aligned accesses */
+    if (posix_memalign(&draw, 64, size) != 0 || posix_memalign(&copy, 64, size) != 0) {
+        LOGE("Cannot allocate shadow framebuffer: %s", strerror(ENOMEM));
+        free(draw);
+        return HAL_LCD_ERROR;
+    }
+
+    shadow_buffer = draw;
+    shadow_copy = copy;
+    shadow_pitch = pitch;
+    memset(&frame_damage, 0, sizeof(frame_damage));
+    memset(buffer_damage, 0, sizeof(buffer_damage));
+    pixel_x1 = pixel_y1 = UINT16_MAX;
+    pixel_x2 = pixel_y2 = 0;
+    dirtyfb_supported = true;
+    return HAL_LCD_OK;
+}
+
+static void destroy_shadow(void)
+{
+    free(shadow_buffer);
+    free(shadow_copy);
+    shadow_buffer = NULL;
+    shadow_copy = NULL;
+}
+
+static void damage_add(lcd_damage_t *damage, int x1, int y1, int x2, int y2)
+{
+    if (x1 < 0) x1 = 0;
+    if (y1 < 0) y1 = 0;
+    if (x2 > fb.width) x2 = fb.width;
+    if (y2 > fb.height) y2 = fb.height;
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    /* Grow a rectangle the new one overlaps */
+    for (int i = 0; i < damage->count; i++) {
+        struct drm_clip_rect *r = &damage->rects[i];
+        if (x1 < r->x2 && x2 > r->x1 && y1 < r->y2 && y2 > r->y1) {
+            if (x1 < r->x1) r->x1 = x1;
+            if (y1 < r->y1) r->y1 = y1;
+            if (x2 > r->x2) r->x2 = x2;
+            if (y2 > r->y2) r->y2 = y2;
+            return;
+        }
+    }
+
+    if (damage->count < LCD_MAX_DAMAGE_RECTS) {
+        struct drm_clip_rect *r = &damage->rects[damage->count++];
+        r->x1 = x1;
+        r->y1 = y1;
+        r->x2 = x2;
+        r->y2 = y2;
+        return;
+    }
+
+    /* List full: merge into the rectangle whose area grows the least */
+    int best = 0;
+    long best_growth = -1;
+    for (int i = 0; i < damage->count; i++) {
+        struct drm_clip_rect *r = &damage->rects[i];
+        long ux1 = (x1 < r->x1) ? x1 : r->x1;
+        long uy1 = (y1 < r->y1) ? y1 : r->y1;
+        long ux2 = (x2 > r->x2) ? x2 : r->x2;
+        long uy2 = (y2 > r->y2) ? y2 : r->y2;
+        long growth = (ux2 - ux1) * (uy2 - uy1) - (long)(r->x2 - r->x1) * (r->y2 - r->y1);
+        if (best_growth < 0 || growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+
+    struct drm_clip_rect *r = &damage->rects[best];
+    if (x1 < r->x1) r->x1 = x1;
+    if (y1 < r->y1) r->y1 = y1;
+    if (x2 > r->x2) r->x2 = x2;
+    if (y2 > r->y2) r->y2 = y2;
+}
+
+/*
+ * Shrink the frame damage to the pixels that really changed since the last
+ * presented frame. Runs of rows with the same changed span become one
+ * rectangle each, so a full clear followed by a similar redraw only
+ * flushes the difference.
+ */
+static void refine_damage(lcd_damage_t *out)
+{
+    const size_t px = fb.bpp / 8;
+
+    out->count = 0;
+    for (int i = 0; i < frame_damage.count; i++) {
+        const struct drm_clip_rect *r = &frame_damage.rects[i];
+        int band_x1 = 0, band_x2 = 0, band_y1 = -1;
+
+        for (int y = r->y1; y < r->y2; y++) {
+            uint8_t *draw = shadow_buffer + (size_t)y * shadow_pitch;
+            uint8_t *copy = shadow_copy + (size_t)y * shadow_pitch;
+            int x1 = r->x1;
+            int x2 = r->x2;
+
+            if (memcmp(draw + x1 * px, copy + x1 * px, (x2 - x1) * px) == 0) {
+                if (band_y1 >= 0) {
+                    damage_add(out, band_x1, band_y1, band_x2, y);
+                    band_y1 = -1;
+                }
+                continue;
+            }
+
+            while (memcmp(draw + x1 * px, copy + x1 * px, px) == 0) x1++;
+            while (memcmp(draw + (x2 - 1) * px, copy + (x2 - 1) * px, px) == 0) x2--;
+            memcpy(copy + x1 * px, draw + x1 * px, (x2 - x1) * px);
+
+            /* Rows with the same changed span extend the current band */
+            if (band_y1 >= 0 && (x1 != band_x1 || x2 != band_x2)) {
+                damage_add(out, band_x1, band_y1, band_x2, y);
+                band_y1 = -1;
+            }
+            if (band_y1 < 0) {
+                band_y1 = y;
+                band_x1 = x1;
+                band_x2 = x2;
+            }
+        }
+
+        if (band_y1 >= 0) {
+            damage_add(out, band_x1, band_y1, band_x2, r->y2);
+        }
+    }
+}
+
+static void flush_shadow(int index)
+{
+    lcd_buffer_t *buf = &buffers[index];
+    lcd_damage_t changed;
+
+    /* Fold single pixel writes into the frame damage */
+    if (pixel_x1 < pixel_x2) {
+        damage_add(&frame_damage, pixel_x1, pixel_y1, pixel_x2, pixel_y2);
+        pixel_x1 = pixel_y1 = UINT16_MAX;
+        pixel_x2 = pixel_y2 = 0;
+    }
+
+    refine_damage(&changed);
+    frame_damage.count = 0;
+
+    /* Every buffer of the chain has to catch up with this frame's changes */
+    for (int i = 0; i < active_buffers; i++) {
+        for (int j = 0; j < changed.count; j++) {
+            const struct drm_clip_rect *r = &changed.rects[j];
+            damage_add(&buffer_damage[i], r->x1, r->y1, r->x2, r->y2);
+        }
+    }
+
+    /* Row-wise sequential copies into the write-combined scanout memory */
+    lcd_damage_t *pending = &buffer_damage[index];
+    size_t flushed = 0;
+    const size_t px = fb.bpp / 8;
+    for (int j = 0; j < pending->count; j++) {
+        const struct drm_clip_rect *r = &pending->rects[j];
+        size_t row = (size_t)(r->x2 - r->x1) * px;
+        int h = r->y2 - r->y1;
+        hal_pixel_copy_rows((uint8_t *)buf->map + (size_t)r->y1 * buf->pitch + r->x1 * px, buf->pitch,
+                            shadow_buffer + (size_t)r->y1 * shadow_pitch + r->x1 * px, shadow_pitch,
+                            row, h);
+        flushed += row * h;
+    }
+    pending->count = 0;
+    __atomic_store_n(&last_flush_bytes, flushed, __ATOMIC_RELAXED);
+
+    /* Command-mode panels only need to be sent the damaged regions */
+    if (dirtyfb_supported && buf->fb_id && changed.count > 0) {
+        struct drm_mode_fb_dirty_cmd dirty = {0};
+        dirty.fb_id = buf->fb_id;
+        dirty.num_clips = changed.count;
+        dirty.clips_ptr = (uint64_t)(uintptr_t)changed.rects;
+
+        if (ioctl(drm_fd, DRM_IOCTL_MODE_DIRTYFB, &dirty) < 0 &&
+            (errno == ENOSYS || errno == EOPNOTSUPP || errno == EINVAL)) {
+            dirtyfb_supported = false;
+        }
+    }
+}
+
+/* Property ID by name on a KMS object, 0 if the object does not have it */
+static uint32_t find_property(uint32_t obj_id, uint32_t obj_type, const char *name, uint64_t *value)
+{
+    struct drm_mode_obj_get_properties props = {0};
+    props.obj_id = obj_id;
+    props.obj_type = obj_type;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_OBJ_GETPROPERTIES, &props) < 0 || props.count_props == 0) {
+        return 0;
+    }
+
+    uint32_t *ids = malloc(props.count_props * sizeof(uint32_t));
+    uint64_t *values = malloc(props.count_props * sizeof(uint64_t));
+    uint32_t found = 0;
+
+    if (ids && values) {
+        props.props_ptr = (uint64_t)(uintptr_t)ids;
+        props.prop_values_ptr = (uint64_t)(uintptr_t)values;
+
+        if (ioctl(drm_fd, DRM_IOCTL_MODE_OBJ_GETPROPERTIES, &props) == 0) {
+            for (uint32_t i = 0; i < props.count_props && found == 0; i++) {
+                struct drm_mode_get_property prop = {0};
+                prop.prop_id = ids[i];
+                if (ioctl(drm_fd, DRM_IOCTL_MODE_GETPROPERTY, &prop) == 0 &&
+                    strncmp(prop.name, name, DRM_PROP_NAME_LEN) == 0) {
+                    found = ids[i];
+                    if (value) {
+                        *value = values[i];
+                    }
+                }
+            }
+        }
+    }
+
+    free(ids);
+    free(values);
+    return found;
+}
+
+/* Collect the overlay planes that can scan out on our CRTC */
+static void discover_planes(void)
+{
+    struct drm_mode_get_plane_res res = {0};
+
+    plane_count = 0;
+    primary_plane_id = 0;
+    memset(layers, 0, sizeof(layers));
+
+    /* Without the atomic (universal planes) cap only overlays are listed */
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_GETPLANERESOURCES, &res) < 0 || res.count_planes == 0) {
+        LOGI("No overlay planes available");
+        return;
+    }
+
+    uint32_t *ids = malloc(res.count_planes * sizeof(uint32_t));
+    if (ids == NULL) {
+        return;
+    }
+
+    res.plane_id_ptr = (uint64_t)(uintptr_t)ids;
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_GETPLANERESOURCES, &res) == 0) {
+        for (uint32_t i = 0; i < res.count_planes; i++) {
+            struct drm_mode_get_plane plane = {0};
+            plane.plane_id = ids[i];
+            if (ioctl(drm_fd, DRM_IOCTL_MODE_GETPLANE, &plane) < 0 ||
+                !(plane.possible_crtcs & (1u << crtc_index))) {
+                continue;
+            }
+
+            uint64_t type = DRM_PLANE_TYPE_OVERLAY;
+            find_property(ids[i], DRM_MODE_OBJECT_PLANE, "type", &type);
+            if (type == DRM_PLANE_TYPE_PRIMARY && primary_plane_id == 0) {
+                primary_plane_id = ids[i];
+            } else if (type == DRM_PLANE_TYPE_OVERLAY && plane_count < HAL_LCD_MAX_LAYERS) {
+                planes[plane_count++] = ids[i];
+            }
+        }
+    }
+
+    free(ids);
+    LCD_INFO("Overlay planes for CRTC %u: %d", crtc_id, plane_count);
+}
+
+static bool plane_supports(uint32_t plane_id, hal_lcd_format_t format)
+{
+    static const uint32_t fourcc[] = {
+        [HAL_LCD_FORMAT_XRGB8888] = DRM_FORMAT_XRGB8888,
+        [HAL_LCD_FORMAT_RGB565] = DRM_FORMAT_RGB565,
+        [HAL_LCD_FORMAT_ARGB8888] = DRM_FORMAT_ARGB8888,
+    };
+    struct drm_mode_get_plane plane = {0};
+    plane.plane_id = plane_id;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_GETPLANE, &plane) < 0 || plane.count_format_types == 0) {
+        return false;
+    }
+
+    uint32_t *formats = malloc(plane.count_format_types * sizeof(uint32_t));
+    bool found = false;
+
+    if (formats) {
+        plane.format_type_ptr = (uint64_t)(uintptr_t)formats;
+        if (ioctl(drm_fd, DRM_IOCTL_MODE_GETPLANE, &plane) == 0) {
+            for (uint32_t i = 0; i < plane.count_format_types && !found; i++) {
+                found = (formats[i] == fourcc[format]);
+            }
+        }
+        free(formats);
+    }
+
+    return found;
+}
+
+static lcd_layer_t *get_layer(hal_lcd_layer_t layer)
+{
+    if (!lcd_initialized || layer < 0 || layer >= HAL_LCD_MAX_LAYERS || !layers[layer].used) {
+        return NULL;
+    }
+    return &layers[layer];
+}
+
+/* Show buffer index of the layer at its position, full buffer as source */
+static hal_lcd_status_t update_plane(lcd_layer_t *l, int index)
+{
+    struct drm_mode_set_plane plane = {0};
+    plane.plane_id = l->plane_id;
+    plane.crtc_id = crtc_id;
+    plane.fb_id = l->buffers[index].fb_id;
+    plane.crtc_x = l->x;
+    plane.crtc_y = l->y;
+    plane.crtc_w = l->fb.width;
+    plane.crtc_h = l->fb.height;
+    plane.src_w = (uint32_t)l->fb.width << 16;   /* 16.16 fixed point */
+    plane.src_h = (uint32_t)l->fb.height << 16;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_SETPLANE, &plane) < 0) {
+        LOGE("Cannot update plane %u: %s", l->plane_id, strerror(errno));
+        return HAL_LCD_ERROR;
+    }
+
+    return HAL_LCD_OK;
+}
+
+/* Push a layer's buffer, position or visibility: now with legacy, with the next commit with atomic */
+static hal_lcd_status_t apply_layer(lcd_layer_t *l)
+{
+    if (atomic_supported) {
+        if (!atomic_test_layer(l)) {
+            return HAL_LCD_ERROR;
+        }
+        l->staged = true;
+        return HAL_LCD_OK;
+    }
+
+    if (l->visible) {
+        return update_plane(l, l->front);
+    }
+
+    struct drm_mode_set_plane plane = {0};
+    plane.plane_id = l->plane_id;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_SETPLANE, &plane) < 0) {
+        LOGE("Cannot disable plane %u: %s", l->plane_id, strerror(errno));
+        return HAL_LCD_ERROR;
+    }
+
+    return HAL_LCD_OK;
+}
+
+/* Block until the layer's busy back buffer has left the screen */
+static void layer_wait(lcd_layer_t *l)
+{
+    while (l->busy && (l->staged || l->inflight)) {
+        if (l->inflight || pending_index >= 0) {
+            wait_flip();
+            continue;
+        }
+
+        /* Staged but never committed: push the layers out on their own */
+        lcd_atomic_req_t req = {0};
+        atomic_add_layers(&req);
+        if (atomic_commit(&req, 0, 0) != HAL_LCD_OK && atomic_supported) {
+            break;
+        }
+    }
+    l->busy = false;
+}
+
+/* Look up the primary plane and core properties, create the mode blob */
+static bool atomic_init(void)
+{
+    lcd_atomic_props_t *p = &atomic_props;
+
+    if (primary_plane_id == 0) {
+        return false;
+    }
+
+    p->conn_crtc_id = find_property(connector_id, DRM_MODE_OBJECT_CONNECTOR, "CRTC_ID", NULL);
+    p->crtc_mode_id = find_property(crtc_id, DRM_MODE_OBJECT_CRTC, "MODE_ID", NULL);
+    p->crtc_active = find_property(crtc_id, DRM_MODE_OBJECT_CRTC, "ACTIVE", NULL);
+    p->crtc_out_fence = find_property(crtc_id, DRM_MODE_OBJECT_CRTC, "OUT_FENCE_PTR", NULL);
+    p->fb_id = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "FB_ID", NULL);
+    p->crtc_id = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_ID", NULL);
+    p->src_x = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "SRC_X", NULL);
+    p->src_y = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "SRC_Y", NULL);
+    p->src_w = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "SRC_W", NULL);
+    p->src_h = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "SRC_H", NULL);
+    p->crtc_x = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_X", NULL);
+    p->crtc_y = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_Y", NULL);
+    p->crtc_w = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_W", NULL);
+    p->crtc_h = find_property(primary_plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_H", NULL);
+
+    /* OUT_FENCE_PTR is optional, flip events still report completion */
+    const uint32_t required[] = {
+        p->conn_crtc_id, p->crtc_mode_id, p->crtc_active, p->fb_id, p->crtc_id,
+        p->src_x, p->src_y, p->src_w, p->src_h, p->crtc_x, p->crtc_y, p->crtc_w, p->crtc_h
+    };
+    for (size_t i = 0; i < sizeof(required) / sizeof(required[0]); i++) {
+        if (required[i] == 0) {
+            return false;
+        }
+    }
+
+    struct drm_mode_create_blob blob = {0};
+    blob.data = (uint64_t)(uintptr_t)&mode;
+    blob.length = sizeof(mode);
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_CREATEPROPBLOB, &blob) < 0) {
+        LOGW("Cannot create mode blob: %s", strerror(errno));
+        return false;
+    }
+
+    mode_blob_id = blob.blob_id;
+    return true;
+}
+
+static void atomic_add(lcd_atomic_req_t *req, uint32_t obj, uint32_t prop, uint64_t value)
+{
+    if (req->nprops == LCD_ATOMIC_MAX_PROPS) {
+        return;
+    }
+
+    if (req->nobjs == 0 || req->objs[req->nobjs - 1] != obj) {
+        if (req->nobjs == LCD_ATOMIC_MAX_OBJS) {
+            return;
+        }
+        req->objs[req->nobjs] = obj;
+        req->counts[req->nobjs] = 0;
+        req->nobjs++;
+    }
+
+    req->counts[req->nobjs - 1]++;
+    req->props[req->nprops] = prop;
+    req->values[req->nprops] = value;
+    req->nprops++;
+}
+
+/* Full plane state, fb_id 0 disables the plane */
+static void atomic_add_plane(lcd_atomic_req_t *req, uint32_t plane_id, uint32_t fb_id,
+                             int x, int y, uint16_t width, uint16_t height)
+{
+    const lcd_atomic_props_t *p = &atomic_props;
+
+    atomic_add(req, plane_id, p->fb_id, fb_id);
+    atomic_add(req, plane_id, p->crtc_id, fb_id ? crtc_id : 0);
+    if (fb_id == 0) {
+        return;
+    }
+
+    atomic_add(req, plane_id, p->src_x, 0);
+    atomic_add(req, plane_id, p->src_y, 0);
+    atomic_add(req, plane_id, p->src_w, (uint64_t)width << 16);    /* 16.16 fixed point */
+    atomic_add(req, plane_id, p->src_h, (uint64_t)height << 16);
+    atomic_add(req, plane_id, p->crtc_x, (uint64_t)(int64_t)x);
+    atomic_add(req, plane_id, p->crtc_y, (uint64_t)(int64_t)y);
+    atomic_add(req, plane_id, p->crtc_w, width);
+    atomic_add(req, plane_id, p->crtc_h, height);
+}
+
+static void atomic_add_layer(lcd_atomic_req_t *req, const lcd_layer_t *l)
+{
+    atomic_add_plane(req, l->plane_id, l->visible ? l->buffers[l->front].fb_id : 0,
+                     l->x, l->y, l->fb.width, l->fb.height);
+    if (l->zpos >= 0 && l->zpos_prop) {
+        atomic_add(req, l->plane_id, l->zpos_prop, (uint64_t)l->zpos);
+    }
+}
+
+/* Add every staged layer change, false if there was none */
+static bool atomic_add_layers(lcd_atomic_req_t *req)
+{
+    bool any = false;
+
+    for (int i = 0; i < HAL_LCD_MAX_LAYERS; i++) {
+        lcd_layer_t *l = &layers[i];
+        if (!l->used || !l->staged) {
+            continue;
+        }
+
+        atomic_add_layer(req, l);
+        any = true;
+    }
+
+    return any;
+}
+
+/*
+ * Check a layer change with the driver before it is staged, so a bad
+ * position or size fails the layer call rather than every later commit.
+ * Before the first mode set the CRTC is off and the commit itself checks.
+ */
+static bool atomic_test_layer(const lcd_layer_t *l)
+{
+    if (scanout_index < 0) {
+        return true;
+    }
+
+    lcd_atomic_req_t req = {0};
+    atomic_add_layer(&req, l);
+
+    struct drm_mode_atomic atomic = {0};
+    atomic.flags = DRM_MODE_ATOMIC_TEST_ONLY;
+    atomic.count_objs = req.nobjs;
+    atomic.objs_ptr = (uint64_t)(uintptr_t)req.objs;
+    atomic.count_props_ptr = (uint64_t)(uintptr_t)req.counts;
+    atomic.props_ptr = (uint64_t)(uintptr_t)req.props;
+    atomic.prop_values_ptr = (uint64_t)(uintptr_t)req.values;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_ATOMIC, &atomic) < 0) {
+        LOGW("Plane %u rejects layer at %d,%d %ux%u: %s", l->plane_id, l->x, l->y,
+             l->fb.width, l->fb.height, strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Commit a request built with atomic_add_layers(). Non-blocking commits
+ * complete with a flip event carrying user_data; the staged layers then
+ * stay in flight until it arrives. A failed commit leaves them staged for
+ * the next one; only a driver that refuses atomic altogether (or a lost
+ * DRM master) switches to the legacy ioctls.
+ */
+static hal_lcd_status_t atomic_commit(lcd_atomic_req_t *req, uint32_t flags, uint64_t user_data)
+{
+    int32_t fence = -1;
+
+    if ((flags & DRM_MODE_ATOMIC_NONBLOCK) && out_fence_requested && atomic_props.crtc_out_fence) {
+        atomic_add(req, crtc_id, atomic_props.crtc_out_fence, (uint64_t)(uintptr_t)&fence);
+    }
+
+    struct drm_mode_atomic atomic = {0};
+    atomic.flags = flags;
+    atomic.count_objs = req->nobjs;
+    atomic.objs_ptr = (uint64_t)(uintptr_t)req->objs;
+    atomic.count_props_ptr = (uint64_t)(uintptr_t)req->counts;
+    atomic.props_ptr = (uint64_t)(uintptr_t)req->props;
+    atomic.prop_values_ptr = (uint64_t)(uintptr_t)req->values;
+    atomic.user_data = user_data;
+
+    if (ioctl(drm_fd, DRM_IOCTL_MODE_ATOMIC, &atomic) < 0) {
+        int err = errno;
+        if (err == EOPNOTSUPP || err == ENOSYS || err == EACCES) {
+            LOGW("Atomic commits unavailable: %s", strerror(err));
+            atomic_fallback();
+        } else {
+            LOG_RATELIMIT(HAL_LOG_WARN, 1000, "Atomic commit failed: %s", strerror(err));
+        }
+        return HAL_LCD_ERROR;
+    }
+
+    /* The caller owns the fence once taken, an untaken one is replaced */
+    if (fence >= 0) {
+        if (out_fence_fd >= 0) {
+            close(out_fence_fd);
+        }
+        out_fence_fd = fence;
+    }
+
+    for (int i = 0; i < HAL_LCD_MAX_LAYERS; i++) {
+        lcd_layer_t *l = &layers[i];
+        if (l->used && l->staged) {
+            l->staged = false;
+            if (flags & DRM_MODE_ATOMIC_NONBLOCK) {
+                l->inflight = true;
+            } else {
+                l->busy = false;
+            }
+        }
+    }
+
+    return HAL_LCD_OK;
+}
+
+/* Continue on legacy ioctls, staged layer changes are applied right away */
+static void atomic_fallback(void)
+{
+    if (!atomic_supported) {
+        return;
+    }
+
+    LOGI("Falling back to legacy KMS ioctls");
+    atomic_supported = false;
+
+    for (int i = 0; i < HAL_LCD_MAX_LAYERS; i++) {
+        lcd_layer_t *l = &layers[i];
+        if (!l->used) {
+            continue;
+        }
+        if (l->staged) {
+            apply_layer(l);
+            if (l->zpos >= 0) {
+                hal_lcd_layer_set_zpos(i, l->zpos);
+            }
+        }
+        l->staged = false;
+        l->inflight = false;
+        l->busy = false;
+    }
+}
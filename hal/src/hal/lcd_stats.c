@@ -0,0 +1,367 @@
+/**
+ * @file lcd_stats.c
+ * @brief Frame timing counters for the LCD subsystem
+ * 
+ * Each frame records four samples into a ring covering the last
+ * LCD_STATS_WINDOW frames:
+ *   - draw: render thread CPU time from the previous hal_lcd_swap()
+ *     returning to the next call (CLOCK_THREAD_CPUTIME_ID)
+ *   - draw_wall: wall time over the same span, sleeps and waits included
+ *   - swap: time spent inside hal_lcd_swap() (flush and flip waits)
+ *   - latency: flip submission to the vblank timestamp of the event
+ * Averages, maxima and histograms are computed from the ring on request,
+ * so recording stays two clock reads and a few stores per frame.
+ * 
+ * The hooks run on the render thread only. Everything lcd_stats_get()
+ * reads is updated inside a seqlock write section with relaxed atomic
+ * stores, so a telemetry thread can read the counters without ever
+ * blocking the swap path. Resets from other threads are deferred to the
+ * next swap.
+ *
+ * The optional stats file is written by its own thread from an
+ * lcd_stats_get() snapshot, so the swap path never touches the
+ * filesystem.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "lcd_stats.h"
+#include "seqlock.h"
+
+#if HAL_LCD_STATS
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    uint32_t draw_us;
+    uint32_t draw_wall_us;
+    uint32_t swap_us;
+    uint32_t latency_us;                   /* 0 until the flip event arrives */
+} lcd_frame_sample_t;
+
+static lcd_frame_sample_t samples[LCD_STATS_WINDOW];
+static uint32_t sample_count = 0;          /* Total frames recorded */
+static uint32_t missed_vblanks = 0;
+static uint32_t period_us = 20000;         /* One vblank at the current refresh */
+static uint64_t swap_return_us = 0;        /* End of the previous swap, 0 before the first */
+static uint64_t swap_enter_us = 0;
+static uint64_t swap_return_cpu_us = 0;    /* Render thread CPU clock at the same points */
+static uint64_t swap_enter_cpu_us = 0;
+static uint64_t flip_submit_us = 0;        /* 0 when no flip is waiting for its event */
+static uint32_t flip_sample = 0;           /* Ring slot the pending flip reports into */
+static size_t flush_bytes_last = 0;
+static seqlock_t stats_lock;               /* Covers samples, sample_count, missed_vblanks, flush_bytes_last */
+static bool reset_pending = false;         /* hal_lcd_reset_stats() since the last swap */
+
+/* Optional periodic dump, dump_lock guards dump_stop */
+static char dump_path[128];
+static uint32_t dump_period_ms = 0;
+static pthread_mutex_t dump_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dump_cond;
+static pthread_t dump_thread;
+static bool dump_running = false;
+static bool dump_stop = false;
+
+static void write_dump(uint64_t now);
+static void *dump_main(void *arg);
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+static uint64_t thread_cpu_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+static uint32_t clamp_us(uint64_t us)
+{
+    return (us > UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+}
+
+void lcd_stats_reset(uint32_t refresh_hz)
+{
+    seqlock_write_begin(&stats_lock);
+    for (int i = 0; i < LCD_STATS_WINDOW; i++) {
+        __atomic_store_n(&samples[i].draw_us, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&samples[i].draw_wall_us, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&samples[i].swap_us, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&samples[i].latency_us, 0, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&sample_count, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&missed_vblanks, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&flush_bytes_last, 0, __ATOMIC_RELAXED);
+    seqlock_write_end(&stats_lock);
+
+    if (refresh_hz) {
+        period_us = 1000000u / refresh_hz;
+    }
+    swap_return_us = 0;
+    flip_submit_us = 0;
+    __atomic_store_n(&reset_pending, false, __ATOMIC_RELEASE);
+}
+
+void lcd_stats_request_reset(void)
+{
+    __atomic_store_n(&reset_pending, true, __ATOMIC_RELEASE);
+}
+
+void lcd_stats_swap_begin(void)
+{
+    if (__atomic_load_n(&reset_pending, __ATOMIC_ACQUIRE)) {
+        lcd_stats_reset(0);
+    }
+
+    swap_enter_us = now_us();
+    swap_enter_cpu_us = thread_cpu_us();
+
+    /* Filled in by the flip event, which may arrive after this swap returns */
+    seqlock_write_begin(&stats_lock);
+    __atomic_store_n(&samples[sample_count % LCD_STATS_WINDOW].latency_us, 0, __ATOMIC_RELAXED);
+    seqlock_write_end(&stats_lock);
+}
+
+void lcd_stats_swap_end(size_t flush_bytes)
+{
+    uint64_t now = now_us();
+    uint64_t cpu = thread_cpu_us();
+    lcd_frame_sample_t *s = &samples[sample_count % LCD_STATS_WINDOW];
+
+    /* A draw under 1 us of CPU still counts, 0 marks an empty slot */
+    uint32_t draw = clamp_us(swap_enter_cpu_us - swap_return_cpu_us);
+
+    seqlock_write_begin(&stats_lock);
+    __atomic_store_n(&s->draw_us, swap_return_us ? (draw ? draw : 1) : 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s->draw_wall_us, swap_return_us ? clamp_us(swap_enter_us - swap_return_us) : 0,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&s->swap_us, clamp_us(now - swap_enter_us), __ATOMIC_RELAXED);
+    __atomic_store_n(&flush_bytes_last, flush_bytes, __ATOMIC_RELAXED);
+    __atomic_store_n(&sample_count, sample_count + 1, __ATOMIC_RELAXED);
+    seqlock_write_end(&stats_lock);
+    swap_return_us = now;
+    swap_return_cpu_us = cpu;
+}
+
+void lcd_stats_flip_submitted(void)
+{
+    flip_submit_us = now_us();
+    flip_sample = sample_count % LCD_STATS_WINDOW;
+}
+
+void lcd_stats_flip_complete(uint32_t tv_sec, uint32_t tv_usec)
+{
+    if (flip_submit_us == 0) {
+        return;
+    }
+
+    /* Flip events carry CLOCK_MONOTONIC vblank timestamps */
+    uint64_t vblank_us = (uint64_t)tv_sec * 1000000u + tv_usec;
+    uint64_t submit_us = flip_submit_us;
+    uint32_t slot = flip_sample;
+    flip_submit_us = 0;
+
+    /* Timestamps from another clock or from before the submit are not usable */
+    if (vblank_us < submit_us || vblank_us - submit_us > 1000000u) {
+        return;
+    }
+
+    uint32_t latency = (uint32_t)(vblank_us - submit_us);
+    seqlock_write_begin(&stats_lock);
+    __atomic_store_n(&samples[slot].latency_us, latency ? latency : 1, __ATOMIC_RELAXED);
+
+    /* Landing later than the first vblank after submission means we missed some */
+    __atomic_store_n(&missed_vblanks, missed_vblanks + latency / period_us, __ATOMIC_RELAXED);
+    seqlock_write_end(&stats_lock);
+}
+
+static void summarize(const uint32_t *values, uint32_t count, uint32_t *avg, uint32_t *max,
+                      uint32_t *hist)
+{
+    uint64_t sum = 0;
+    uint32_t used = 0;
+
+    *max = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t v = values[i];
+        if (v == 0) {
+            continue;
+        }
+        uint32_t bucket = v / HAL_LCD_STATS_BUCKET_US;
+        hist[bucket < HAL_LCD_STATS_BUCKETS ? bucket : HAL_LCD_STATS_BUCKETS - 1]++;
+        if (v > *max) {
+            *max = v;
+        }
+        sum += v;
+        used++;
+    }
+    *avg = used ? (uint32_t)(sum / used) : 0;
+}
+
+void lcd_stats_get(hal_lcd_stats_t *out)
+{
+    uint32_t draw[LCD_STATS_WINDOW], draw_wall[LCD_STATS_WINDOW];
+    uint32_t swap[LCD_STATS_WINDOW], latency[LCD_STATS_WINDOW];
+    uint32_t frames, missed, count, seq;
+    size_t flush;
+
+    memset(out, 0, sizeof(*out));
+    if (__atomic_load_n(&reset_pending, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    /* Copy the raw ring, retrying if a swap or flip event updated it meanwhile */
+    do {
+        seq = seqlock_read_begin(&stats_lock);
+        frames = __atomic_load_n(&sample_count, __ATOMIC_RELAXED);
+        missed = __atomic_load_n(&missed_vblanks, __ATOMIC_RELAXED);
+        flush = __atomic_load_n(&flush_bytes_last, __ATOMIC_RELAXED);
+        count = (frames < LCD_STATS_WINDOW) ? frames : LCD_STATS_WINDOW;
+        for (uint32_t i = 0; i < count; i++) {
+            draw[i] = __atomic_load_n(&samples[i].draw_us, __ATOMIC_RELAXED);
+            draw_wall[i] = __atomic_load_n(&samples[i].draw_wall_us, __ATOMIC_RELAXED);
+            swap[i] = __atomic_load_n(&samples[i].swap_us, __ATOMIC_RELAXED);
+            latency[i] = __atomic_load_n(&samples[i].latency_us, __ATOMIC_RELAXED);
+        }
+    } while (seqlock_read_retry(&stats_lock, seq));
+
+    out->frames = frames;
+    out->window = count;
+    out->missed_vblanks = missed;
+    out->flush_bytes = flush;
+
+    uint32_t last = (frames + LCD_STATS_WINDOW - 1) % LCD_STATS_WINDOW;
+    if (frames > 0) {
+        out->draw_us.last = draw[last];
+        out->draw_wall_us.last = draw_wall[last];
+        out->swap_us.last = swap[last];
+        out->latency_us.last = latency[last];
+    }
+
+    summarize(draw, count, &out->draw_us.avg, &out->draw_us.max, out->draw_us.hist);
+    summarize(draw_wall, count, &out->draw_wall_us.avg, &out->draw_wall_us.max, out->draw_wall_us.hist);
+    summarize(swap, count, &out->swap_us.avg, &out->swap_us.max, out->swap_us.hist);
+    summarize(latency, count, &out->latency_us.avg, &out->latency_us.max, out->latency_us.hist);
+}
+
+bool lcd_stats_set_file(const char *path, uint32_t period_ms)
+{
+    lcd_stats_shutdown();
+    if (path == NULL || period_ms == 0) {
+        return true;
+    }
+
+    snprintf(dump_path, sizeof(dump_path), "%s", path);
+    dump_period_ms = period_ms;
+    dump_stop = false;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&dump_cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    if (pthread_create(&dump_thread, NULL, dump_main, NULL) != 0) {
+        pthread_cond_destroy(&dump_cond);
+        return false;
+    }
+    dump_running = true;
+    return true;
+}
+
+void lcd_stats_shutdown(void)
+{
+    if (!dump_running) {
+        return;
+    }
+
+    pthread_mutex_lock(&dump_lock);
+    dump_stop = true;
+    pthread_cond_signal(&dump_cond);
+    pthread_mutex_unlock(&dump_lock);
+
+    pthread_join(dump_thread, NULL);
+    pthread_cond_destroy(&dump_cond);
+    dump_running = false;
+}
+
+/* Sleeps a period, snapshots with lcd_stats_get() and rewrites the file */
+static void *dump_main(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&dump_lock);
+    while (!dump_stop) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += dump_period_ms / 1000;
+        deadline.tv_nsec += (long)(dump_period_ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        while (!dump_stop && pthread_cond_timedwait(&dump_cond, &dump_lock, &deadline) != ETIMEDOUT) {
+        }
+        if (dump_stop) {
+            break;
+        }
+
+        pthread_mutex_unlock(&dump_lock);
+        write_dump(now_us());
+        pthread_mutex_lock(&dump_lock);
+    }
+    pthread_mutex_unlock(&dump_lock);
+    return NULL;
+}
+
+/* One key=value line set, rewritten each period so readers always see a whole snapshot */
+static void write_dump(uint64_t now)
+{
+    char tmp[sizeof(dump_path) + 8];
+    hal_lcd_stats_t st;
+
+    lcd_stats_get(&st);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", dump_path);
+
+    FILE *f = fopen(tmp, "w");
+    if (f == NULL) {
+        return;
+    }
+
+    fprintf(f, "time_ms=%llu\nframes=%u\nwindow=%u\nmissed_vblanks=%u\nflush_bytes=%zu\n",
+            (unsigned long long)(now / 1000), st.frames, st.window, st.missed_vblanks, st.flush_bytes);
+
+    const struct {
+        const char *name;
+        const hal_lcd_timing_t *t;
+    } timings[] = {
+        {"draw", &st.draw_us},
+        {"draw_wall", &st.draw_wall_us},
+        {"swap", &st.swap_us},
+        {"latency", &st.latency_us},
+    };
+    for (size_t i = 0; i < sizeof(timings) / sizeof(timings[0]); i++) {
+        const hal_lcd_timing_t *t = timings[i].t;
+        fprintf(f, "%s_us=%u/%u/%u\n%s_hist=", timings[i].name, t->last, t->avg, t->max, timings[i].name);
+        for (int b = 0; b < HAL_LCD_STATS_BUCKETS; b++) {
+            fprintf(f, "%s%u", b ? "," : "", t->hist[b]);
+        }
+        fputc('\n', f);
+    }
+
+    fclose(f);
+    rename(tmp, dump_path);
+}
+
+#endif /* HAL_LCD_STATS */
@@ -0,0 +1,52 @@
+/**
+ * @file lcd_stats.h
+ * @brief Internal frame timing counters for the LCD subsystem
+ * 
+ * lcd.c calls these hooks around hal_lcd_swap() and on flip events, all
+ * from the render thread. lcd_stats_get() and lcd_stats_request_reset()
+ * may be called from any thread. lcd_stats_set_file() starts a writer
+ * thread, lcd_stats_shutdown() stops it.
+ * Building with HAL_LCD_STATS=0 turns every hook into an empty inline
+ * function, so the counters cost nothing.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#ifndef HAL_LCD_STATS_H
+#define HAL_LCD_STATS_H
+
+#include "../../include/hal.h"
+
+#ifndef HAL_LCD_STATS
+#define HAL_LCD_STATS           1
+#endif
+
+/* Frames kept for averages, maxima and histograms */
+#define LCD_STATS_WINDOW        128
+
+#if HAL_LCD_STATS
+
+void lcd_stats_reset(uint32_t refresh_hz);
+void lcd_stats_request_reset(void);
+void lcd_stats_swap_begin(void);
+void lcd_stats_swap_end(size_t flush_bytes);
+void lcd_stats_flip_submitted(void);
+void lcd_stats_flip_complete(uint32_t tv_sec, uint32_t tv_usec);
+void lcd_stats_get(hal_lcd_stats_t *out);
+bool lcd_stats_set_file(const char *path, uint32_t period_ms);
+void lcd_stats_shutdown(void);
+
+#else
+
+static inline void lcd_stats_reset(uint32_t refresh_hz) { (void)refresh_hz; }
+static inline void lcd_stats_request_reset(void) {}
+static inline void lcd_stats_swap_begin(void) {}
+static inline void lcd_stats_swap_end(size_t flush_bytes) { (void)flush_bytes; }
+static inline void lcd_stats_flip_submitted(void) {}
+static inline void lcd_stats_flip_complete(uint32_t tv_sec, uint32_t tv_usec) { (void)tv_sec; (void)tv_usec; }
+static inline void lcd_stats_shutdown(void) {}
+
+#endif /* HAL_LCD_STATS */
+
+#endif /* HAL_LCD_STATS_H */
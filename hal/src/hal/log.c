@@ -0,0 +1,189 @@
+/**
+ * @file log.c
+ * @brief HAL message log: runtime level, console echo and in-memory ring
+ *
+ * Every message that passes the level check is stored in a ring of the
+ * last HAL_LOG_RING_ENTRIES messages with its CLOCK_MONOTONIC time, and
+ * echoed to stdout unless that was turned off. The runtime level and the
+ * echo come from the HAL_LOG_LEVEL and HAL_LOG_STDOUT environment
+ * variables on first use, and can be changed with hal_log_set_level() and
+ * hal_log_set_stdout().
+ *
+ * Writers from any thread are serialized by a mutex held only for the
+ * copy into the ring; formatting and console output happen outside it.
+ *
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "log.h"
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    uint64_t time_us;
+    hal_log_level_t level;
+    char text[HAL_LOG_MSG_MAX];
+} log_entry_t;
+
+int log_level = -1;
+static int log_stdout = -1;                /* -1 until read from HAL_LOG_STDOUT */
+
+static log_entry_t ring[HAL_LOG_RING_ENTRIES];
+static uint32_t ring_head = 0;             /* Messages written so far */
+static pthread_mutex_t ring_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char level_tag[] = "EWIDT";
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Level name or number, HAL_LOG_INFO for anything else */
+int log_level_init(void)
+{
+    static const char *names[] = { "error", "warn", "info", "debug", "trace" };
+    const char *env = getenv("HAL_LOG_LEVEL");
+    int level = HAL_LOG_INFO;
+
+    if (env != NULL && env[0] >= '0' && env[0] <= '4' && env[1] == '\0') {
+        level = env[0] - '0';
+    } else if (env != NULL) {
+        for (int i = 0; i <= HAL_LOG_TRACE; i++) {
+            if (strcasecmp(env, names[i]) == 0) {
+                level = i;
+            }
+        }
+    }
+
+    /* A level set through the API meanwhile wins */
+    int unset = -1;
+    __atomic_compare_exchange_n(&log_level, &unset, level, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    return __atomic_load_n(&log_level, __ATOMIC_RELAXED);
+}
+
+static bool stdout_enabled(void)
+{
+    int echo = __atomic_load_n(&log_stdout, __ATOMIC_RELAXED);
+    if (echo < 0) {
+        const char *env = getenv("HAL_LOG_STDOUT");
+        int value = !(env != NULL && strcmp(env, "0") == 0);
+        int unset = -1;
+        __atomic_compare_exchange_n(&log_stdout, &unset, value, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        echo = __atomic_load_n(&log_stdout, __ATOMIC_RELAXED);
+    }
+    return echo != 0;
+}
+
+bool log_ratelimit(log_ratelimit_t *state, hal_log_level_t level, uint32_t interval_ms)
+{
+    uint64_t now = now_us();
+    uint64_t next = __atomic_load_n(&state->next_us, __ATOMIC_RELAXED);
+
+    /* One caller per interval wins the slot, everyone else counts as dropped */
+    if (now < next ||
+        !__atomic_compare_exchange_n(&state->next_us, &next, now + (uint64_t)interval_ms * 1000,
+                                     false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        __atomic_fetch_add(&state->dropped, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    uint32_t dropped = __atomic_exchange_n(&state->dropped, 0, __ATOMIC_RELAXED);
+    if (dropped) {
+        log_write(level, "%u similar messages suppressed", dropped);
+    }
+    return true;
+}
+
+void log_write(hal_log_level_t level, const char *format, ...)
+{
+    log_entry_t entry;
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(entry.text, sizeof(entry.text), format, args);
+    va_end(args);
+    entry.time_us = now_us();
+    entry.level = level;
+
+    pthread_mutex_lock(&ring_lock);
+    ring[ring_head % HAL_LOG_RING_ENTRIES] = entry;
+    ring_head++;
+    pthread_mutex_unlock(&ring_lock);
+
+    if (stdout_enabled()) {
+        /* One stdio call per line, so concurrent messages do not interleave */
+        const char *prefix = (level == HAL_LOG_ERROR) ? "Error: " :
+                             (level == HAL_LOG_WARN) ? "Warning: " : "";
+        printf("%s%s\n", prefix, entry.text);
+    }
+}
+
+void hal_log_set_level(hal_log_level_t level)
+{
+    if ((int)level < HAL_LOG_ERROR || level > HAL_LOG_TRACE) {
+        return;
+    }
+    __atomic_store_n(&log_level, (int)level, __ATOMIC_RELAXED);
+}
+
+hal_log_level_t hal_log_get_level(void)
+{
+    int level = __atomic_load_n(&log_level, __ATOMIC_RELAXED);
+    return (hal_log_level_t)(level < 0 ? log_level_init() : level);
+}
+
+void hal_log_set_stdout(bool enable)
+{
+    __atomic_store_n(&log_stdout, enable ? 1 : 0, __ATOMIC_RELAXED);
+}
+
+int hal_log_dump(int fd)
+{
+    pthread_mutex_lock(&ring_lock);
+    uint32_t end = ring_head;
+    pthread_mutex_unlock(&ring_lock);
+
+    uint32_t start = end > HAL_LOG_RING_ENTRIES ? end - HAL_LOG_RING_ENTRIES : 0;
+    int written = 0;
+
+    /* One entry at a time, so writes to a slow fd never hold up loggers */
+    for (uint32_t i = start; i < end; i++) {
+        log_entry_t entry;
+        bool valid;
+
+        pthread_mutex_lock(&ring_lock);
+        valid = (ring_head - i <= HAL_LOG_RING_ENTRIES);
+        if (valid) {
+            entry = ring[i % HAL_LOG_RING_ENTRIES];
+        }
+        pthread_mutex_unlock(&ring_lock);
+        if (!valid) {
+            continue;
+        }
+
+        char line[HAL_LOG_MSG_MAX + 32];
+        int len = snprintf(line, sizeof(line), "[%5u.%06u] %c %s\n",
+                           (unsigned int)(entry.time_us / 1000000), (unsigned int)(entry.time_us % 1000000),
+                           level_tag[entry.level], entry.text);
+        if (len > (int)sizeof(line) - 1) {
+            len = (int)sizeof(line) - 1;
+        }
+        if (write(fd, line, (size_t)len) != len) {
+            return -1;
+        }
+        written++;
+    }
+
+    return written;
+}
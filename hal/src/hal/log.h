@@ -0,0 +1,75 @@
+/**
+ * @file log.h
+ * @brief Internal logging macros for the HAL subsystems
+ *
+ * LOGE/LOGW/LOGI/LOGD/LOGT take a printf format without the trailing
+ * newline. A message is kept only if its level is at most
+ * HAL_LOG_MAX_LEVEL (compile time) and at most the runtime level (see
+ * hal_log_set_level()). Levels above HAL_LOG_MAX_LEVEL fold to a constant
+ * false condition, so the call, its arguments and the format string are
+ * dropped from the build; below it a disabled message costs one relaxed
+ * load and a compare.
+ *
+ * LOG_RATELIMIT() is for messages that can repeat at frame or event rate.
+ * It keeps at most one per interval per call site, and the next one that
+ * passes is preceded by a count of those dropped.
+ *
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#ifndef HAL_LOG_H
+#define HAL_LOG_H
+
+#include "../../include/hal.h"
+
+/* Highest level compiled in, 2 (HAL_LOG_INFO) unless the build says otherwise */
+#ifndef HAL_LOG_MAX_LEVEL
+#define HAL_LOG_MAX_LEVEL       2
+#endif
+
+/* Per call site state of LOG_RATELIMIT() */
+typedef struct {
+    uint64_t next_us;
+    uint32_t dropped;
+} log_ratelimit_t;
+
+extern int log_level;                      /* -1 until read from HAL_LOG_LEVEL */
+
+int log_level_init(void);
+bool log_ratelimit(log_ratelimit_t *state, hal_log_level_t level, uint32_t interval_ms);
+void log_write(hal_log_level_t level, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static inline bool log_enabled(hal_log_level_t level)
+{
+    int current = __atomic_load_n(&log_level, __ATOMIC_RELAXED);
+    if (current < 0) {
+        current = log_level_init();
+    }
+    return (int)level <= current;
+}
+
+#define LOG_AT(level, ...) \
+    do { \
+        if ((int)(level) <= HAL_LOG_MAX_LEVEL && log_enabled(level)) { \
+            log_write(level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOGE(...)   LOG_AT(HAL_LOG_ERROR, __VA_ARGS__)
+#define LOGW(...)   LOG_AT(HAL_LOG_WARN, __VA_ARGS__)
+#define LOGI(...)   LOG_AT(HAL_LOG_INFO, __VA_ARGS__)
+#define LOGD(...)   LOG_AT(HAL_LOG_DEBUG, __VA_ARGS__)
+#define LOGT(...)   LOG_AT(HAL_LOG_TRACE, __VA_ARGS__)
+
+#define LOG_RATELIMIT(level, interval_ms, ...) \
+    do { \
+        static log_ratelimit_t log_rl_; \
+        if ((int)(level) <= HAL_LOG_MAX_LEVEL && log_enabled(level) && \
+            log_ratelimit(&log_rl_, level, interval_ms)) { \
+            log_write(level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#endif /* HAL_LOG_H */
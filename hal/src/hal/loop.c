@@ -0,0 +1,558 @@
+/**
+ * @file loop.c
+ * @brief Single-threaded event loop for STM32MP157F-DK2 HAL
+ *
+ * One epoll instance multiplexes the touchscreen, the button lines, DRM
+ * page-flip events, timers and application descriptors. The loop sleeps
+ * in epoll_wait() until the next registered source is ready, so an
+ * application needs no fixed-interval polling at all.
+ *
+ * Every watch lives in a fixed table. Watch IDs carry a generation
+ * count, so a stale ID (or an event for a watch removed earlier in the same
+ * batch) is never dispatched to whatever reused the slot.
+ *
+ * Callbacks run on the thread calling hal_loop_run(). Only hal_loop_stop()
+ * may be called from other threads or signal handlers.
+ *
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "../../include/hal.h"
+#include "log.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#define LOOP_MAX_EVENTS     16
+#define LOOP_INDEX_BITS     8                       /* Low bits of a watch ID */
+#define LOOP_WAKE_TAG       UINT64_MAX              /* epoll data for the stop eventfd */
+
+typedef enum {
+    WATCH_FREE = 0,
+    WATCH_FD,
+    WATCH_TIMER,
+    WATCH_TOUCH,
+    WATCH_TOUCH_HOTPLUG,
+    WATCH_BUTTONS,
+    WATCH_LCD
+} watch_kind_t;
+
+typedef struct {
+    watch_kind_t kind;
+    uint32_t generation;
+    int fd;                     /* -1 while not in the epoll set */
+    uint32_t events;            /* epoll events requested (WATCH_FD) */
+    bool repeat;                /* WATCH_TIMER */
+    int link;                   /* Touch <-> hotplug partner slot, -1 if none */
+    union {
+        hal_loop_fd_cb_t fd;
+        hal_loop_timer_cb_t timer;
+        hal_loop_touch_cb_t touch;
+        hal_loop_button_cb_t button;
+        hal_loop_flip_cb_t flip;
+    } cb;
+    void *user;
+} loop_watch_t;
+
+static loop_watch_t watches[HAL_LOOP_MAX_WATCHES];
+static int epoll_fd = -1;
+static int wake_fd = -1;
+static volatile bool stop_requested = false;
+static bool loop_initialized = false;
+
+/* Static function prototypes */
+static int alloc_watch(watch_kind_t kind, void *user);
+static void free_watch(int index);
+static int watch_id(int index);
+static int watch_index(int id);
+static hal_status_t watch_attach(int index, int fd, uint32_t events);
+static void watch_detach(int index);
+static void dispatch(int index, uint32_t revents);
+static void dispatch_touch(int index, uint32_t revents);
+static void dispatch_hotplug(int index);
+
+hal_status_t hal_loop_init(void)
+{
+    if (loop_initialized) {
+        return HAL_OK;
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        LOGE("Cannot create event loop: %s", strerror(errno));
+        goto fail;
+    }
+
+    struct epoll_event ev = { .events = EPOLLIN, .data.u64 = LOOP_WAKE_TAG };
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev) < 0) {
+        LOGE("Cannot register loop wakeup: %s", strerror(errno));
+        goto fail;
+    }
+
+    memset(watches, 0, sizeof(watches));
+    for (int i = 0; i < HAL_LOOP_MAX_WATCHES; i++) {
+        watches[i].fd = -1;
+        watches[i].link = -1;
+    }
+
+    stop_requested = false;
+    loop_initialized = true;
+    return HAL_OK;
+
+fail:
+    if (wake_fd >= 0) {
+        close(wake_fd);
+        wake_fd = -1;
+    }
+    if (epoll_fd >= 0) {
+        close(epoll_fd);
+        epoll_fd = -1;
+    }
+    return HAL_ERROR;
+}
+
+hal_status_t hal_loop_deinit(void)
+{
+    if (!loop_initialized) {
+        return HAL_OK;
+    }
+
+    for (int i = 0; i < HAL_LOOP_MAX_WATCHES; i++) {
+        if (watches[i].kind != WATCH_FREE) {
+            free_watch(i);
+        }
+    }
+
+    close(wake_fd);
+    close(epoll_fd);
+    wake_fd = -1;
+    epoll_fd = -1;
+    loop_initialized = false;
+    return HAL_OK;
+}
+
+int hal_loop_add_fd(int fd, uint32_t events, hal_loop_fd_cb_t cb, void *user)
+{
+    if (!loop_initialized || fd < 0 || cb == NULL ||
+        (events & (HAL_LOOP_READ | HAL_LOOP_WRITE)) == 0) {
+        return -1;
+    }
+
+    int index = alloc_watch(WATCH_FD, user);
+    if (index < 0) {
+        return -1;
+    }
+
+    watches[index].cb.fd = cb;
+    watches[index].events = ((events & HAL_LOOP_READ) ? EPOLLIN : 0) |
+                            ((events & HAL_LOOP_WRITE) ? EPOLLOUT : 0);
+    if (watch_attach(index, fd, watches[index].events) != HAL_OK) {
+        free_watch(index);
+        return -1;
+    }
+
+    return watch_id(index);
+}
+
+int hal_loop_add_timer(uint32_t interval_ms, bool repeat, hal_loop_timer_cb_t cb, void *user)
+{
+    if (!loop_initialized || interval_ms == 0 || cb == NULL) {
+        return -1;
+    }
+
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (tfd < 0) {
+        LOGE("Cannot create timer: %s", strerror(errno));
+        return -1;
+    }
+
+    struct itimerspec spec = {0};
+    spec.it_value.tv_sec = interval_ms / 1000;
+    spec.it_value.tv_nsec = (long)(interval_ms % 1000) * 1000000L;
+    if (repeat) {
+        spec.it_interval = spec.it_value;
+    }
+    timerfd_settime(tfd, 0, &spec, NULL);
+
+    int index = alloc_watch(WATCH_TIMER, user);
+    if (index < 0) {
+        close(tfd);
+        return -1;
+    }
+
+    watches[index].cb.timer = cb;
+    watches[index].repeat = repeat;
+    if (watch_attach(index, tfd, EPOLLIN) != HAL_OK) {
+        close(tfd);
+        free_watch(index);
+        return -1;
+    }
+
+    return watch_id(index);
+}
+
+int hal_loop_add_touch(hal_loop_touch_cb_t cb, void *user)
+{
+    int fd = hal_touch_get_fd();
+    if (!loop_initialized || cb == NULL || fd < 0) {
+        return -1;
+    }
+
+    int index = alloc_watch(WATCH_TOUCH, user);
+    if (index < 0) {
+        return -1;
+    }
+
+    watches[index].cb.touch = cb;
+    if (watch_attach(index, fd, EPOLLIN) != HAL_OK) {
+        free_watch(index);
+        return -1;
+    }
+
+    /* Follow the panel across unplug/replug when uevents are available */
+    int hotplug = hal_touch_get_hotplug_fd();
+    if (hotplug >= 0) {
+        int partner = alloc_watch(WATCH_TOUCH_HOTPLUG, NULL);
+        if (partner >= 0 && watch_attach(partner, hotplug, EPOLLIN) == HAL_OK) {
+            watches[partner].link = index;
+            watches[index].link = partner;
+        } else if (partner >= 0) {
+            free_watch(partner);
+        }
+    }
+
+    return watch_id(index);
+}
+
+int hal_loop_add_buttons(hal_loop_button_cb_t cb, void *user)
+{
+    int fd = hal_button_get_fd();
+    if (!loop_initialized || cb == NULL || fd < 0) {
+        return -1;
+    }
+
+    int index = alloc_watch(WATCH_BUTTONS, user);
+    if (index < 0) {
+        return -1;
+    }
+
+    watches[index].cb.button = cb;
+    if (watch_attach(index, fd, EPOLLIN) != HAL_OK) {
+        free_watch(index);
+        return -1;
+    }
+
+    return watch_id(index);
+}
+
+int hal_loop_add_lcd(hal_loop_flip_cb_t cb, void *user)
+{
+    int fd = hal_lcd_get_fd();
+    if (!loop_initialized || cb == NULL || fd < 0) {
+        return -1;
+    }
+
+    int index = alloc_watch(WATCH_LCD, user);
+    if (index < 0) {
+        return -1;
+    }
+
+    watches[index].cb.flip = cb;
+    if (watch_attach(index, fd, EPOLLIN) != HAL_OK) {
+        free_watch(index);
+        return -1;
+    }
+
+    return watch_id(index);
+}
+
+hal_status_t hal_loop_remove(int id)
+{
+    if (!loop_initialized) {
+        return HAL_NOT_INITIALIZED;
+    }
+
+    int index = watch_index(id);
+    if (index < 0 || watches[index].kind == WATCH_TOUCH_HOTPLUG) {
+        return HAL_INVALID_PARAM;
+    }
+
+    free_watch(index);
+    return HAL_OK;
+}
+
+hal_status_t hal_loop_run_once(int timeout_ms)
+{
+    if (!loop_initialized) {
+        return HAL_NOT_INITIALIZED;
+    }
+
+    struct epoll_event events[LOOP_MAX_EVENTS];
+    int count = epoll_wait(epoll_fd, events, LOOP_MAX_EVENTS, timeout_ms);
+    if (count < 0) {
+        /* A signal handler may have asked us to stop */
+        return (errno == EINTR) ? HAL_OK : HAL_ERROR;
+    }
+
+    if (count == 0) {
+        return HAL_TIMEOUT;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (events[i].data.u64 == LOOP_WAKE_TAG) {
+            uint64_t value;
+            (void)read(wake_fd, &value, sizeof(value));
+            continue;
+        }
+
+        /* Skip watches removed or replaced by an earlier callback in this batch */
+        uint32_t index = (uint32_t)events[i].data.u64;
+        uint32_t generation = (uint32_t)(events[i].data.u64 >> 32);
+        if (index >= HAL_LOOP_MAX_WATCHES || watches[index].kind == WATCH_FREE ||
+            watches[index].generation != generation) {
+            continue;
+        }
+
+        dispatch((int)index, events[i].events);
+    }
+
+    return HAL_OK;
+}
+
+hal_status_t hal_loop_run(void)
+{
+    if (!loop_initialized) {
+        return HAL_NOT_INITIALIZED;
+    }
+
+    stop_requested = false;
+    while (!stop_requested) {
+        hal_status_t status = hal_loop_run_once(-1);
+        if (status == HAL_ERROR) {
+            LOG_RATELIMIT(HAL_LOG_ERROR, 1000, "Event loop wait failed: %s", strerror(errno));
+            return status;
+        }
+    }
+
+    return HAL_OK;
+}
+
+void hal_loop_stop(void)
+{
+    stop_requested = true;
+
+    /* write() is async-signal-safe, so this also works from a signal handler */
+    if (wake_fd >= 0) {
+        uint64_t one = 1;
+        (void)write(wake_fd, &one, sizeof(one));
+    }
+}
+
+/* Internal helper functions */
+
+static int alloc_watch(watch_kind_t kind, void *user)
+{
+    for (int i = 0; i < HAL_LOOP_MAX_WATCHES; i++) {
+        if (watches[i].kind == WATCH_FREE) {
+            watches[i].kind = kind;
+            watches[i].generation = (watches[i].generation + 1) & ((1u << (31 - LOOP_INDEX_BITS)) - 1);
+            watches[i].fd = -1;
+            watches[i].link = -1;
+            watches[i].user = user;
+            return i;
+        }
+    }
+
+    LOGE("Event loop is full (%d watches)", HAL_LOOP_MAX_WATCHES);
+    return -1;
+}
+
+static void free_watch(int index)
+{
+    loop_watch_t *w = &watches[index];
+
+    watch_detach(index);
+    if (w->kind == WATCH_TIMER && w->fd >= 0) {
+        close(w->fd);
+    }
+    w->fd = -1;
+
+    /* Touch and its hotplug socket are registered and removed together */
+    int link = w->link;
+    w->kind = WATCH_FREE;
+    w->link = -1;
+    if (link >= 0 && watches[link].kind != WATCH_FREE) {
+        watches[link].link = -1;
+        free_watch(link);
+    }
+}
+
+static int watch_id(int index)
+{
+    return (int)((watches[index].generation << LOOP_INDEX_BITS) | (uint32_t)index);
+}
+
+static int watch_index(int id)
+{
+    if (id < 0) {
+        return -1;
+    }
+
+    int index = id & ((1 << LOOP_INDEX_BITS) - 1);
+    if (index >= HAL_LOOP_MAX_WATCHES || watches[index].kind == WATCH_FREE ||
+        watch_id(index) != id) {
+        return -1;
+    }
+
+    return index;
+}
+
+static hal_status_t watch_attach(int index, int fd, uint32_t events)
+{
+    struct epoll_event ev = {
+        .events = events,
+        .data.u64 = ((uint64_t)watches[index].generation << 32) | (uint32_t)index
+    };
+
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        LOGE("Cannot watch fd %d: %s", fd, strerror(errno));
+        return HAL_ERROR;
+    }
+
+    watches[index].fd = fd;
+    return HAL_OK;
+}
+
+static void watch_detach(int index)
+{
+    loop_watch_t *w = &watches[index];
+
+    /* Fails harmlessly when the owner already closed the descriptor */
+    if (w->fd >= 0) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, w->fd, NULL);
+    }
+
+    if (w->kind != WATCH_TIMER) {
+        w->fd = -1;
+    }
+}
+
+static void dispatch(int index, uint32_t revents)
+{
+    loop_watch_t *w = &watches[index];
+
+    switch (w->kind) {
+    case WATCH_FD: {
+        uint32_t flags = ((revents & EPOLLIN) ? HAL_LOOP_READ : 0) |
+                         ((revents & EPOLLOUT) ? HAL_LOOP_WRITE : 0) |
+                         ((revents & (EPOLLERR | EPOLLHUP)) ? HAL_LOOP_ERROR : 0);
+        w->cb.fd(w->fd, flags, w->user);
+        break;
+    }
+
+    case WATCH_TIMER: {
+        uint64_t expirations;
+        if (read(w->fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            break;
+        }
+
+        hal_loop_timer_cb_t cb = w->cb.timer;
+        void *user = w->user;
+        if (!w->repeat) {
+            free_watch(index);
+        }
+        cb(user);
+        break;
+    }
+
+    case WATCH_TOUCH:
+        dispatch_touch(index, revents);
+        break;
+
+    case WATCH_TOUCH_HOTPLUG:
+        dispatch_hotplug(index);
+        break;
+
+    case WATCH_BUTTONS: {
+        hal_button_event_t events[16];
+        uint32_t generation = w->generation;
+        int count;
+
+        while ((count = hal_button_read_events(events, 16)) > 0) {
+            for (int i = 0; i < count; i++) {
+                w->cb.button(&events[i], w->user);
+                if (w->kind != WATCH_BUTTONS || w->generation != generation) {
+                    return;
+                }
+            }
+        }
+        break;
+    }
+
+    case WATCH_LCD:
+        /* Drains the flip event even if no flip is pending any more */
+        hal_lcd_handle_events(0);
+        if (!hal_lcd_flip_pending()) {
+            w->cb.flip(w->user);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void dispatch_touch(int index, uint32_t revents)
+{
+    loop_watch_t *w = &watches[index];
+    uint32_t generation = w->generation;
+
+    /* Unplugged: stop watching until the hotplug socket reports it back */
+    if (revents & (EPOLLERR | EPOLLHUP)) {
+        watch_detach(index);
+        return;
+    }
+
+    hal_touch_data_t frames[16];
+    int count = hal_touch_pop_events(frames, 16);
+
+    if (count < 0) {
+        /* Not threaded: read() decodes everything pending into one frame */
+        if (hal_touch_read(&frames[0]) == HAL_TOUCH_OK) {
+            w->cb.touch(&frames[0], w->user);
+        }
+        return;
+    }
+
+    do {
+        for (int i = 0; i < count; i++) {
+            w->cb.touch(&frames[i], w->user);
+            if (w->kind != WATCH_TOUCH || w->generation != generation) {
+                return;
+            }
+        }
+    } while ((count = hal_touch_pop_events(frames, 16)) > 0);
+}
+
+static void dispatch_hotplug(int index)
+{
+    int touch = watches[index].link;
+
+    if (hal_touch_handle_hotplug() != HAL_TOUCH_OK || touch < 0) {
+        return;
+    }
+
+    /* The device was closed or reopened, so the descriptor changed */
+    watch_detach(touch);
+    int fd = hal_touch_get_fd();
+    if (fd >= 0 && hal_touch_is_connected()) {
+        watch_attach(touch, fd, EPOLLIN);
+    }
+}
@@ -0,0 +1,270 @@
+/**
+ * @file pixel.c
+ * @brief Scalar pixel kernels and runtime kernel selection
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "pixel.h"
+#include <string.h>
+
+#if defined(__arm__)
+#include <sys/auxv.h>
+#ifndef HWCAP_NEON
+#define HWCAP_NEON  (1 << 12)
+#endif
+#endif
+
+static void scalar_fill(uint32_t *dst, size_t count, uint32_t color)
+{
+    size_t i = 0;
+
+    /* Unrolled so the compiler can emit store-multiple bursts */
+    for (; i + 8 <= count; i += 8) {
+        dst[i + 0] = color;
+        dst[i + 1] = color;
+        dst[i + 2] = color;
+        dst[i + 3] = color;
+        dst[i + 4] = color;
+        dst[i + 5] = color;
+        dst[i + 6] = color;
+        dst[i + 7] = color;
+    }
+    for (; i < count; i++) {
+        dst[i] = color;
+    }
+}
+
+static void scalar_copy(uint32_t *dst, const uint32_t *src, size_t count)
+{
+    memcpy(dst, src, count * sizeof(uint32_t));
+}
+
+static void scalar_blend(uint32_t *dst, const uint32_t *src, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        uint32_t s = src[i];
+        uint32_t a = s >> 24;
+
+        if (a == 0xFF) {
+            dst[i] = s;
+            continue;
+        }
+        if (a == 0) {
+            continue;
+        }
+
+        uint32_t d = dst[i];
+        uint32_t ia = 255 - a;
+        uint32_t r = hal_pixel_div255(((s >> 16) & 0xFF) * a + ((d >> 16) & 0xFF) * ia);
+        uint32_t g = hal_pixel_div255(((s >> 8) & 0xFF) * a + ((d >> 8) & 0xFF) * ia);
+        uint32_t b = hal_pixel_div255((s & 0xFF) * a + (d & 0xFF) * ia);
+        uint32_t oa = a + hal_pixel_div255((d >> 24) * ia);
+
+        dst[i] = (oa << 24) | (r << 16) | (g << 8) | b;
+    }
+}
+
+static void scalar_fill16(uint16_t *dst, size_t count, uint16_t color)
+{
+    size_t i = 0;
+
+    /* Align to a word, then store pixel pairs */
+    if (count > 0 && ((uintptr_t)dst & 2)) {
+        dst[i++] = color;
+    }
+    uint32_t pair = ((uint32_t)color << 16) | color;
+    for (; i + 2 <= count; i += 2) {
+        *(uint32_t *)(dst + i) = pair;
+    }
+    if (i < count) {
+        dst[i] = color;
+    }
+}
+
+static void scalar_convert565(uint16_t *dst, const uint32_t *src, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = hal_pixel_rgb565(src[i]);
+    }
+}
+
+static void scalar_blend565(uint16_t *dst, const uint32_t *src, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        uint32_t s = src[i];
+        uint32_t a = s >> 24;
+
+        if (a == 0xFF) {
+            dst[i] = hal_pixel_rgb565(s);
+            continue;
+        }
+        if (a == 0) {
+            continue;
+        }
+
+        /* Expand by bit replication so 0x1F maps to 0xFF */
+        uint32_t d = dst[i];
+        uint32_t dr = d >> 11;
+        uint32_t dg = (d >> 5) & 0x3F;
+        uint32_t db = d & 0x1F;
+        dr = (dr << 3) | (dr >> 2);
+        dg = (dg << 2) | (dg >> 4);
+        db = (db << 3) | (db >> 2);
+
+        uint32_t ia = 255 - a;
+        uint32_t r = hal_pixel_div255(((s >> 16) & 0xFF) * a + dr * ia);
+        uint32_t g = hal_pixel_div255(((s >> 8) & 0xFF) * a + dg * ia);
+        uint32_t b = hal_pixel_div255((s & 0xFF) * a + db * ia);
+
+        dst[i] = hal_pixel_rgb565((r << 16) | (g << 8) | b);
+    }
+}
+
+const hal_pixel_ops_t hal_pixel_scalar_ops = {
+    .name = "scalar",
+    .fill = scalar_fill,
+    .copy = scalar_copy,
+    .blend = scalar_blend,
+    .fill16 = scalar_fill16,
+    .convert565 = scalar_convert565,
+    .blend565 = scalar_blend565,
+};
+
+const hal_pixel_ops_t *hal_pixel = &hal_pixel_scalar_ops;
+
+bool hal_pixel_neon_available(void)
+{
+#if defined(__aarch64__)
+    return true;
+#elif defined(__arm__)
+    return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#else
+    return false;
+#endif
+}
+
+bool hal_pixel_select(bool use_neon)
+{
+#if HAL_PIXEL_HAVE_NEON
+    if (use_neon && hal_pixel_neon_available()) {
+        hal_pixel = &hal_pixel_neon_ops;
+        return true;
+    }
+#else
+    (void)use_neon;
+#endif
+    hal_pixel = &hal_pixel_scalar_ops;
+    return false;
+}
+
+void hal_pixel_fill_rect(uint32_t *dst, size_t pitch, int width, int height, uint32_t color)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    /* Unpadded full-width rectangles are one long span */
+    if (pitch == (size_t)width * sizeof(uint32_t)) {
+        hal_pixel->fill(dst, (size_t)width * height, color);
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        hal_pixel->fill(dst, width, color);
+        dst = (uint32_t *)((uint8_t *)dst + pitch);
+    }
+}
+
+void hal_pixel_copy_rect(uint32_t *dst, size_t dst_pitch,
+                         const uint32_t *src, size_t src_pitch, int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        hal_pixel->copy(dst, src, width);
+        dst = (uint32_t *)((uint8_t *)dst + dst_pitch);
+        src = (const uint32_t *)((const uint8_t *)src + src_pitch);
+    }
+}
+
+void hal_pixel_blend_rect(uint32_t *dst, size_t dst_pitch,
+                          const uint32_t *src, size_t src_pitch, int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        hal_pixel->blend(dst, src, width);
+        dst = (uint32_t *)((uint8_t *)dst + dst_pitch);
+        src = (const uint32_t *)((const uint8_t *)src + src_pitch);
+    }
+}
+
+void hal_pixel_fill_rect16(uint16_t *dst, size_t pitch, int width, int height, uint16_t color)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    if (pitch == (size_t)width * sizeof(uint16_t)) {
+        hal_pixel->fill16(dst, (size_t)width * height, color);
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        hal_pixel->fill16(dst, width, color);
+        dst = (uint16_t *)((uint8_t *)dst + pitch);
+    }
+}
+
+void hal_pixel_convert_rect565(uint16_t *dst, size_t dst_pitch,
+                               const uint32_t *src, size_t src_pitch, int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        hal_pixel->convert565(dst, src, width);
+        dst = (uint16_t *)((uint8_t *)dst + dst_pitch);
+        src = (const uint32_t *)((const uint8_t *)src + src_pitch);
+    }
+}
+
+void hal_pixel_blend_rect565(uint16_t *dst, size_t dst_pitch,
+                             const uint32_t *src, size_t src_pitch, int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        hal_pixel->blend565(dst, src, width);
+        dst = (uint16_t *)((uint8_t *)dst + dst_pitch);
+        src = (const uint32_t *)((const uint8_t *)src + src_pitch);
+    }
+}
+
+void hal_pixel_copy_rows(void *dst, size_t dst_pitch,
+                         const void *src, size_t src_pitch, size_t row_bytes, int height)
+{
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+    bool words = (((uintptr_t)d | (uintptr_t)s | dst_pitch | src_pitch | row_bytes) & 3) == 0;
+
+    for (int y = 0; y < height; y++) {
+        if (words) {
+            hal_pixel->copy((uint32_t *)d, (const uint32_t *)s, row_bytes / sizeof(uint32_t));
+        } else {
+            memcpy(d, s, row_bytes);
+        }
+        d += dst_pitch;
+        s += src_pitch;
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ * @file pixel.h
+ * @brief Internal pixel kernels for the LCD and UI drawing paths
+ * 
+ * Span kernels (fill, copy, ARGB8888 source-over blend, and their RGB565
+ * destination variants) with a scalar implementation and a NEON
+ * implementation picked at runtime from the CPU capabilities. The
+ * rectangle helpers walk rows with a byte pitch and call the selected
+ * span kernel once per row.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#ifndef HAL_PIXEL_H
+#define HAL_PIXEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* NEON kernels are built for ARM targets only (see pixel_neon.c) */
+#if defined(__arm__) || defined(__aarch64__)
+#define HAL_PIXEL_HAVE_NEON     1
+#else
+#define HAL_PIXEL_HAVE_NEON     0
+#endif
+
+typedef struct {
+    const char *name;
+    void (*fill)(uint32_t *dst, size_t count, uint32_t color);
+    void (*copy)(uint32_t *dst, const uint32_t *src, size_t count);
+    void (*blend)(uint32_t *dst, const uint32_t *src, size_t count);
+    /* RGB565 destinations, sources stay ARGB8888 */
+    void (*fill16)(uint16_t *dst, size_t count, uint16_t color);
+    void (*convert565)(uint16_t *dst, const uint32_t *src, size_t count);
+    void (*blend565)(uint16_t *dst, const uint32_t *src, size_t count);
+} hal_pixel_ops_t;
+
+/* Currently selected kernels, never NULL */
+extern const hal_pixel_ops_t *hal_pixel;
+
+extern const hal_pixel_ops_t hal_pixel_scalar_ops;
+#if HAL_PIXEL_HAVE_NEON
+extern const hal_pixel_ops_t hal_pixel_neon_ops;
+#endif
+
+/**
+ * @brief Select the kernels to use
+ * @param use_neon true to use NEON when the CPU supports it
+ * @return true if the NEON kernels are now selected
+ */
+bool hal_pixel_select(bool use_neon);
+
+/**
+ * @brief Check if the CPU supports the NEON kernels
+ * @return true if NEON is available
+ */
+bool hal_pixel_neon_available(void);
+
+void hal_pixel_fill_rect(uint32_t *dst, size_t pitch, int width, int height, uint32_t color);
+void hal_pixel_copy_rect(uint32_t *dst, size_t dst_pitch,
+                         const uint32_t *src, size_t src_pitch, int width, int height);
+void hal_pixel_blend_rect(uint32_t *dst, size_t dst_pitch,
+                          const uint32_t *src, size_t src_pitch, int width, int height);
+
+void hal_pixel_fill_rect16(uint16_t *dst, size_t pitch, int width, int height, uint16_t color);
+void hal_pixel_convert_rect565(uint16_t *dst, size_t dst_pitch,
+                               const uint32_t *src, size_t src_pitch, int width, int height);
+void hal_pixel_blend_rect565(uint16_t *dst, size_t dst_pitch,
+                             const uint32_t *src, size_t src_pitch, int width, int height);
+
+/* Format-agnostic row copy, uses the copy kernel when rows are word aligned */
+void hal_pixel_copy_rows(void *dst, size_t dst_pitch,
+                         const void *src, size_t src_pitch, size_t row_bytes, int height);
+
+/* Pack an ARGB8888 color to RGB565 by truncation, done once per fill */
+static inline uint16_t hal_pixel_rgb565(uint32_t color)
+{
+    return (uint16_t)(((color >> 8) & 0xF800) | ((color >> 5) & 0x07E0) | ((color >> 3) & 0x001F));
+}
+
+/* Exact round(x / 255) for x in [0, 255 * 255], shared by every blend path */
+static inline uint32_t hal_pixel_div255(uint32_t x)
+{
+    return (x + 128 + ((x + 128) >> 8)) >> 8;
+}
+
+#endif /* HAL_PIXEL_H */
@@ -0,0 +1,187 @@
+/**
+ * @file pixel_neon.c
+ * @brief NEON pixel kernels for the Cortex-A7
+ * 
+ * Built with NEON code generation enabled (see NEON_CFLAGS in the
+ * Makefile) and only used after hal_pixel_select() has checked the CPU.
+ * Results are bit-identical to the scalar kernels in pixel.c.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#include "pixel.h"
+
+#if HAL_PIXEL_HAVE_NEON
+
+#ifndef __ARM_NEON
+#error "pixel_neon.c must be compiled with NEON enabled (-mfpu=neon-vfpv4)"
+#endif
+
+#include <arm_neon.h>
+
+static void neon_fill(uint32_t *dst, size_t count, uint32_t color)
+{
+    uint32x4_t v = vdupq_n_u32(color);
+    size_t i = 0;
+
+    /* 64-byte bursts match the write-combining buffer */
+    for (; i + 16 <= count; i += 16) {
+        vst1q_u32(dst + i, v);
+        vst1q_u32(dst + i + 4, v);
+        vst1q_u32(dst + i + 8, v);
+        vst1q_u32(dst + i + 12, v);
+    }
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u32(dst + i, v);
+    }
+    for (; i < count; i++) {
+        dst[i] = color;
+    }
+}
+
+static void neon_copy(uint32_t *dst, const uint32_t *src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        uint32x4_t a = vld1q_u32(src + i);
+        uint32x4_t b = vld1q_u32(src + i + 4);
+        uint32x4_t c = vld1q_u32(src + i + 8);
+        uint32x4_t d = vld1q_u32(src + i + 12);
+        vst1q_u32(dst + i, a);
+        vst1q_u32(dst + i + 4, b);
+        vst1q_u32(dst + i + 8, c);
+        vst1q_u32(dst + i + 12, d);
+    }
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u32(dst + i, vld1q_u32(src + i));
+    }
+    for (; i < count; i++) {
+        dst[i] = src[i];
+    }
+}
+
+/* (t + 128 + ((t + 128) >> 8)) >> 8, same rounding as hal_pixel_div255() */
+static inline uint8x8_t div255_u16(uint16x8_t t)
+{
+    return vrshrn_n_u16(vrsraq_n_u16(t, t, 8), 8);
+}
+
+static void neon_blend(uint32_t *dst, const uint32_t *src, size_t count)
+{
+    const uint8x8_t full = vdup_n_u8(0xFF);
+    size_t i = 0;
+
+    /* 8 pixels per step, channels deinterleaved as B, G, R, A */
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t s = vld4_u8((const uint8_t *)(src + i));
+        uint8x8x4_t d = vld4_u8((const uint8_t *)(dst + i));
+        uint8x8_t a = s.val[3];
+        uint8x8_t ia = vmvn_u8(a);
+
+        for (int c = 0; c < 3; c++) {
+            uint16x8_t t = vmull_u8(s.val[c], a);
+            t = vmlal_u8(t, d.val[c], ia);
+            d.val[c] = div255_u16(t);
+        }
+
+        uint16x8_t t = vmull_u8(full, a);
+        t = vmlal_u8(t, d.val[3], ia);
+        d.val[3] = div255_u16(t);
+
+        vst4_u8((uint8_t *)(dst + i), d);
+    }
+
+    if (i < count) {
+        hal_pixel_scalar_ops.blend(dst + i, src + i, count - i);
+    }
+}
+
+static void neon_fill16(uint16_t *dst, size_t count, uint16_t color)
+{
+    uint16x8_t v = vdupq_n_u16(color);
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        vst1q_u16(dst + i, v);
+        vst1q_u16(dst + i + 8, v);
+        vst1q_u16(dst + i + 16, v);
+        vst1q_u16(dst + i + 24, v);
+    }
+    for (; i + 8 <= count; i += 8) {
+        vst1q_u16(dst + i, v);
+    }
+    for (; i < count; i++) {
+        dst[i] = color;
+    }
+}
+
+/* R, G, B bytes to RGB565 by truncation, same as hal_pixel_rgb565() */
+static inline uint16x8_t pack565(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+    uint16x8_t p = vshll_n_u8(r, 8);
+    p = vsriq_n_u16(p, vshll_n_u8(g, 8), 5);
+    return vsriq_n_u16(p, vshll_n_u8(b, 8), 11);
+}
+
+static void neon_convert565(uint16_t *dst, const uint32_t *src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t s = vld4_u8((const uint8_t *)(src + i));
+        vst1q_u16(dst + i, pack565(s.val[2], s.val[1], s.val[0]));
+    }
+
+    if (i < count) {
+        hal_pixel_scalar_ops.convert565(dst + i, src + i, count - i);
+    }
+}
+
+static void neon_blend565(uint16_t *dst, const uint32_t *src, size_t count)
+{
+    size_t i = 0;
+
+    /*
+     * No opaque/transparent shortcuts needed: with exact div255 alpha 255
+     * yields the source and alpha 0 re-packs the replicated destination
+     * to its original bits, matching the scalar kernel.
+     */
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t s = vld4_u8((const uint8_t *)(src + i));
+        uint16x8_t d = vld1q_u16(dst + i);
+        uint8x8_t a = s.val[3];
+        uint8x8_t ia = vmvn_u8(a);
+
+        /* Expand RGB565 by bit replication */
+        uint8x8_t dr = vand_u8(vshrn_n_u16(d, 8), vdup_n_u8(0xF8));
+        uint8x8_t dg = vand_u8(vshrn_n_u16(d, 3), vdup_n_u8(0xFC));
+        uint8x8_t db = vmovn_u16(vshlq_n_u16(d, 3));
+        dr = vorr_u8(dr, vshr_n_u8(dr, 5));
+        dg = vorr_u8(dg, vshr_n_u8(dg, 6));
+        db = vorr_u8(db, vshr_n_u8(db, 5));
+
+        uint8x8_t r = div255_u16(vmlal_u8(vmull_u8(s.val[2], a), dr, ia));
+        uint8x8_t g = div255_u16(vmlal_u8(vmull_u8(s.val[1], a), dg, ia));
+        uint8x8_t b = div255_u16(vmlal_u8(vmull_u8(s.val[0], a), db, ia));
+
+        vst1q_u16(dst + i, pack565(r, g, b));
+    }
+
+    if (i < count) {
+        hal_pixel_scalar_ops.blend565(dst + i, src + i, count - i);
+    }
+}
+
+const hal_pixel_ops_t hal_pixel_neon_ops = {
+    .name = "neon",
+    .fill = neon_fill,
+    .copy = neon_copy,
+    .blend = neon_blend,
+    .fill16 = neon_fill16,
+    .convert565 = neon_convert565,
+    .blend565 = neon_blend565,
+};
+
+#endif /* HAL_PIXEL_HAVE_NEON */
@@ -8,7 +8,17 @@
  * Hardware: FocalTech FT6236 connected via I2C
  * Interface: Linux input events (/dev/input/eventX)
  * Resolution: 480x800 pixels
- * Max touch points: 2 simultaneous touches
+ * Touch points: one per contact slot the device reports, up to HAL_TOUCH_MAX_POINTS
+ * 
+ * Locking: input_lock serializes everything that consumes input (device
+ * reads, the frame queue, hotplug), gesture_lock guards the recognizer.
+ * The newest decoded frame is also published through a seqlock, so
+ * hal_touch_get_snapshot() from a render or telemetry thread never waits
+ * on the input path. Lock order is input_lock, then gesture_lock.
+ * 
+ * Input can be recorded to a capture file while it is decoded, or come
+ * from one instead of the device (see touch_capture.h), selected before
+ * hal_touch_init().
  * 
  * @author Huy Nguyen  
  * @date August 2025
@@ -16,6 +26,12 @@
 
 #define _GNU_SOURCE
 #include "../../include/hal.h"
+#include "touch_capture.h"
+#include "touch_decoder.h"
+#include "touch_discovery.h"
+#include "touch_gesture.h"
+#include "seqlock.h"
+#include "log.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,30 +39,72 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <linux/input.h>
 
-#define NLONGS(nbits) (((nbits) + (8*sizeof(long)) - 1) / (8 * sizeof(unsigned long)))
-unsigned long evbit[NLONGS(EV_MAX+1)] = {0};
-unsigned long absbit[NLONGS(KEY_MAX+1)] = {0};
-
 /* Touch device constants */
-#define TOUCH_DEVICE_PATH_1     "/dev/input/event0"
-#define TOUCH_DEVICE_PATH_2     "/dev/input/event1"
-#define TOUCH_DEVICE_PATH_3     "/dev/input/event2"
-#define MAX_TOUCH_DEVICES       8
 #define POLL_TIMEOUT_MS         50
+#define TOUCH_RING_SIZE         256         /* Queued frames in threaded mode, power of two */
+
+/*
+ * Single-producer/single-consumer frame queue. The reader thread only
+ * writes head, the application only writes tail, so no lock is needed.
+ * The indices live on separate cache lines to keep the two cores from
+ * bouncing one line back and forth.
+ */
+typedef struct {
+    hal_touch_data_t frames[TOUCH_RING_SIZE];
+    uint32_t head;                          /* Next slot to fill, reader thread */
+    char head_pad[64 - sizeof(uint32_t)];
+    uint32_t tail;                          /* Next slot to drain, application */
+    char tail_pad[64 - sizeof(uint32_t)];
+    uint32_t overflows;                     /* Frames dropped because the ring was full */
+} touch_ring_t;
 
 /* Internal state */
 static bool touch_initialized = false;
 static int touch_fd = -1;
-static hal_touch_data_t current_touch_data;
-static char touch_device_path[64] = {0};
+static touch_decoder_t decoder;           /* Decoder for the opened device */
+static touch_gesture_t gestures;            /* Fed with every frame the application receives */
+static char touch_device_path[TOUCH_PATH_MAX] = {0};
+static int hotplug_fd = -1;                 /* Kernel uevents, opened on first use */
+
+/* Threaded mode, see hal_touch_set_threaded() */
+static bool threaded_requested = false;
+static bool reader_running = false;
+static pthread_t reader_thread;
+static int stop_fd = -1;                    /* Wakes the reader thread for shutdown */
+static int notify_fd = -1;                  /* Readable while frames are queued */
+static bool reader_failed = false;          /* Reader thread lost the device */
+static touch_ring_t touch_ring;
+
+/* Capture files, see hal_touch_set_record() and hal_touch_set_replay() */
+static char record_path[TOUCH_CAPTURE_PATH_MAX] = {0};
+static char replay_path[TOUCH_CAPTURE_PATH_MAX] = {0};
+static float replay_speed = 1.0f;
+static touch_capture_writer_t capture = { .fd = -1 };
+static touch_replay_t replay = { .file_fd = -1, .pipe_fd = -1, .stop_fd = -1 };
+
+/* Cross-thread access */
+static pthread_mutex_t input_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t gesture_lock = PTHREAD_MUTEX_INITIALIZER;
+static seqlock_t snapshot_lock;
+static uint32_t snapshot_words[SEQLOCK_WORDS(hal_touch_data_t)];   /* Newest decoded frame */
 
 /* Function prototypes */
-static int find_touch_device(void);
-static hal_touch_status_t process_input_event(struct input_event *event);
-static void reset_touch_data(void);
+static hal_touch_status_t attach_device(int fd, const struct input_absinfo *abs);
+static void detach_device(void);
+static hal_touch_status_t start_reader(void);
+static void stop_reader(void);
+static void *reader_main(void *arg);
+static bool ring_push(const hal_touch_data_t *frame);
+static int ring_pop(hal_touch_data_t *frames, int max);
+static bool drain_device(void);
+static void publish_frame(const hal_touch_data_t *frame);
+static void feed_gestures(const hal_touch_data_t *frames, int count);
+static hal_touch_status_t poll_snapshot(hal_touch_data_t *data);
 
 hal_touch_status_t hal_touch_init(void)
 {
@@ -54,38 +112,35 @@ hal_touch_status_t hal_touch_init(void)
         return HAL_TOUCH_OK;
     }
 
-    printf("Initializing touch subsystem...\n");
-
-    /* Find the touch input device */
-    touch_fd = find_touch_device();
-    if (touch_fd < 0) {
-        printf("Error: No touch device found\n");
-        return HAL_TOUCH_ERROR;
-    }
+    LOGI("Initializing touch subsystem...");
 
-    printf("Touch device opened: %s (fd=%d)\n", touch_device_path, touch_fd);
+    /* A replay stands in for the device, axis ranges come from the capture */
+    touch_capture_header_t header;
+    const struct input_absinfo *abs = NULL;
+    int fd;
 
-    /* Set non-blocking mode */
-    int flags = fcntl(touch_fd, F_GETFL, 0);
-    if (flags == -1) {
-        printf("Error: Cannot get touch device flags: %s\n", strerror(errno));
-        close(touch_fd);
-        touch_fd = -1;
+    if (replay_path[0]) {
+        fd = touch_replay_start(&replay, replay_path, replay_speed, &header);
+        snprintf(touch_device_path, sizeof(touch_device_path), "%.*s", TOUCH_PATH_MAX - 1, replay_path);
+        abs = header.abs;
+    } else {
+        /* Cached node first, then a sysfs scan */
+        fd = touch_discovery_open(touch_device_path);
+    }
+    if (fd < 0) {
+        LOGE("No touch device found");
         return HAL_TOUCH_ERROR;
     }
 
-    if (fcntl(touch_fd, F_SETFL, flags | O_NONBLOCK) == -1) {
-        printf("Error: Cannot set non-blocking mode: %s\n", strerror(errno));
-        close(touch_fd);
-        touch_fd = -1;
+    pthread_mutex_lock(&input_lock);
+    hal_touch_status_t status = attach_device(fd, abs);
+    pthread_mutex_unlock(&input_lock);
+    if (status != HAL_TOUCH_OK) {
         return HAL_TOUCH_ERROR;
     }
 
-    /* Initialize touch data */
-    reset_touch_data();
-
-    touch_initialized = true;
-    printf("Touch subsystem initialized successfully\n");
+    __atomic_store_n(&touch_initialized, true, __ATOMIC_RELEASE);
+    LOGI("Touch subsystem initialized successfully");
     return HAL_TOUCH_OK;
 }
 
@@ -95,17 +150,20 @@ hal_touch_status_t hal_touch_deinit(void)
         return HAL_TOUCH_OK;
     }
 
-    printf("Deinitializing touch subsystem...\n");
+    LOGI("Deinitializing touch subsystem...");
 
-    if (touch_fd >= 0) {
-        close(touch_fd);
-        touch_fd = -1;
+    __atomic_store_n(&touch_initialized, false, __ATOMIC_RELEASE);
+    pthread_mutex_lock(&input_lock);
+    detach_device();
+    touch_capture_close(&capture);
+    pthread_mutex_unlock(&input_lock);
+
+    if (hotplug_fd >= 0) {
+        close(hotplug_fd);
+        hotplug_fd = -1;
     }
 
-    reset_touch_data();
-    touch_initialized = false;
-    
-    printf("Touch subsystem deinitialized\n");
+    LOGI("Touch subsystem deinitialized");
     return HAL_TOUCH_OK;
 }
 
@@ -119,42 +177,276 @@ hal_touch_status_t hal_touch_read(hal_touch_data_t *data)
         return HAL_TOUCH_INVALID_PARAM;
     }
 
-    struct input_event events[64];
-    ssize_t bytes_read;
-    bool data_updated = false;
+    /* The reader thread owns the device and publishes every frame, drop the queued ones */
+    if (reader_running) {
+        hal_touch_data_t frames[16];
+        bool data_updated = false;
 
-    /* Read all available events */
-    while ((bytes_read = read(touch_fd, events, sizeof(events))) > 0) {
-        int num_events = bytes_read / sizeof(struct input_event);
-        
-        for (int i = 0; i < num_events; i++) {
-            if (process_input_event(&events[i]) == HAL_TOUCH_OK) {
-                data_updated = true;
-            }
+        while (hal_touch_pop_events(frames, 16) > 0) {
+            data_updated = true;
         }
+
+        hal_touch_get_snapshot(data);
+        return data_updated ? HAL_TOUCH_OK : HAL_TOUCH_NO_DATA;
     }
 
+    pthread_mutex_lock(&input_lock);
+    bool data_updated = drain_device();
+
     /* Copy current touch data */
-    memcpy(data, &current_touch_data, sizeof(hal_touch_data_t));
+    memcpy(data, &decoder.frame, sizeof(hal_touch_data_t));
+    pthread_mutex_unlock(&input_lock);
 
     return data_updated ? HAL_TOUCH_OK : HAL_TOUCH_NO_DATA;
 }
 
-bool hal_touch_is_touched(void)
+hal_touch_status_t hal_touch_get_snapshot(hal_touch_data_t *data)
+{
+    if (!__atomic_load_n(&touch_initialized, __ATOMIC_ACQUIRE)) {
+        return HAL_TOUCH_NOT_INITIALIZED;
+    }
+
+    if (data == NULL) {
+        return HAL_TOUCH_INVALID_PARAM;
+    }
+
+    uint32_t seq;
+    do {
+        seq = seqlock_read_begin(&snapshot_lock);
+        seqlock_load(data, snapshot_words, sizeof(*data));
+    } while (seqlock_read_retry(&snapshot_lock, seq));
+
+    return HAL_TOUCH_OK;
+}
+
+int hal_touch_get_fd(void)
 {
     if (!touch_initialized) {
-        return false;
+        return -1;
+    }
+
+    return reader_running ? notify_fd : touch_fd;
+}
+
+hal_touch_status_t hal_touch_wait(int timeout_ms)
+{
+    if (!touch_initialized || touch_fd < 0) {
+        return HAL_TOUCH_NOT_INITIALIZED;
+    }
+
+    struct pollfd pfd = { .fd = hal_touch_get_fd(), .events = POLLIN };
+    int rc;
+
+    for (;;) {
+        if (reader_running && __atomic_load_n(&reader_failed, __ATOMIC_ACQUIRE)) {
+            return HAL_TOUCH_ERROR;
+        }
+
+        do {
+            rc = poll(&pfd, 1, timeout_ms);
+        } while (rc < 0 && errno == EINTR);
+
+        if (rc < 0) {
+            LOG_RATELIMIT(HAL_LOG_ERROR, 1000, "Touch poll failed: %s", strerror(errno));
+            return HAL_TOUCH_ERROR;
+        }
+
+        if (rc == 0) {
+            return HAL_TOUCH_NO_DATA;
+        }
+
+        /* Device gone (unplugged, driver unbound, replay finished) once nothing is left to read */
+        if ((pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) && !(pfd.revents & POLLIN)) {
+            return HAL_TOUCH_ERROR;
+        }
+
+        if (!reader_running || __atomic_load_n(&touch_ring.head, __ATOMIC_ACQUIRE) != touch_ring.tail) {
+            return HAL_TOUCH_OK;
+        }
+
+        /* Stale notification for frames an earlier pop already took, clear it and wait again */
+        uint64_t pending;
+        (void)read(notify_fd, &pending, sizeof(pending));
+    }
+}
+
+hal_touch_status_t hal_touch_set_threaded(bool enable)
+{
+    if (touch_initialized) {
+        return HAL_TOUCH_ERROR;
+    }
+
+    threaded_requested = enable;
+    return HAL_TOUCH_OK;
+}
+
+hal_touch_status_t hal_touch_set_record(const char *path)
+{
+    if (touch_initialized) {
+        return HAL_TOUCH_ERROR;
+    }
+
+    if (path != NULL && strlen(path) >= sizeof(record_path)) {
+        return HAL_TOUCH_INVALID_PARAM;
+    }
+
+    snprintf(record_path, sizeof(record_path), "%s", path ? path : "");
+    return HAL_TOUCH_OK;
+}
+
+hal_touch_status_t hal_touch_set_replay(const char *path, float speed)
+{
+    if (touch_initialized) {
+        return HAL_TOUCH_ERROR;
+    }
+
+    if ((path != NULL && strlen(path) >= sizeof(replay_path)) || !(speed >= 0.0f)) {
+        return HAL_TOUCH_INVALID_PARAM;
     }
 
+    snprintf(replay_path, sizeof(replay_path), "%s", path ? path : "");
+    replay_speed = speed;
+    return HAL_TOUCH_OK;
+}
+
+int hal_touch_pop_events(hal_touch_data_t *frames, int max)
+{
+    if (!touch_initialized || !reader_running || frames == NULL || max <= 0) {
+        return -1;
+    }
+
+    /* One consumer at a time keeps the ring single-consumer */
+    pthread_mutex_lock(&input_lock);
+
+    /* Clear the notification first so a frame queued meanwhile signals again */
+    uint64_t pending;
+    if (read(notify_fd, &pending, sizeof(pending)) < 0 && errno != EAGAIN) {
+        pthread_mutex_unlock(&input_lock);
+        return -1;
+    }
+
+    int count = ring_pop(frames, max);
+    feed_gestures(frames, count);
+
+    /* Frames left behind keep the descriptor readable */
+    if (__atomic_load_n(&touch_ring.head, __ATOMIC_ACQUIRE) != touch_ring.tail) {
+        uint64_t one = 1;
+        (void)write(notify_fd, &one, sizeof(one));
+    }
+
+    pthread_mutex_unlock(&input_lock);
+    return count;
+}
+
+uint32_t hal_touch_get_overflow_count(void)
+{
+    return __atomic_load_n(&touch_ring.overflows, __ATOMIC_RELAXED);
+}
+
+int hal_touch_get_hotplug_fd(void)
+{
+    /* A replay has no device to come and go */
+    if (!touch_initialized || replay_path[0]) {
+        return -1;
+    }
+
+    if (hotplug_fd < 0) {
+        hotplug_fd = touch_hotplug_open();
+    }
+
+    return hotplug_fd;
+}
+
+hal_touch_status_t hal_touch_handle_hotplug(void)
+{
+    if (!touch_initialized || hotplug_fd < 0) {
+        return HAL_TOUCH_NOT_INITIALIZED;
+    }
+
+    bool changed = false;
+    char path[TOUCH_PATH_MAX];
+    int action;
+
+    pthread_mutex_lock(&input_lock);
+    while ((action = touch_hotplug_read(hotplug_fd, path)) >= 0) {
+        if (action == TOUCH_HOTPLUG_REMOVE && touch_fd >= 0 && strcmp(path, touch_device_path) == 0) {
+            LOGI("Touch device removed: %s", path);
+            detach_device();
+            changed = true;
+        } else if (action == TOUCH_HOTPLUG_ADD && touch_fd < 0 &&
+                   touch_discovery_is_touch(strrchr(path, '/') + 1)) {
+            int fd = touch_discovery_open(touch_device_path);
+            if (fd >= 0 && attach_device(fd, NULL) == HAL_TOUCH_OK) {
+                LOGI("Touch device attached: %s", touch_device_path);
+                changed = true;
+            }
+        }
+    }
+    pthread_mutex_unlock(&input_lock);
+
+    return changed ? HAL_TOUCH_OK : HAL_TOUCH_NO_DATA;
+}
+
+bool hal_touch_is_connected(void)
+{
+    return touch_initialized && touch_fd >= 0;
+}
+
+int hal_touch_pop_gestures(hal_gesture_t *out, int max)
+{
+    if (!__atomic_load_n(&touch_initialized, __ATOMIC_ACQUIRE) || out == NULL || max <= 0) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&gesture_lock);
+    int count = touch_gesture_pop(&gestures, out, max);
+    pthread_mutex_unlock(&gesture_lock);
+    return count;
+}
+
+hal_touch_status_t hal_touch_set_prediction(hal_touch_predict_t mode, uint32_t lead_ms)
+{
+    if (mode > HAL_TOUCH_PREDICT_KALMAN || lead_ms > 200) {
+        return HAL_TOUCH_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&gesture_lock);
+    gestures.predict = mode;
+    gestures.lead_ms = lead_ms;
+    pthread_mutex_unlock(&gesture_lock);
+    return HAL_TOUCH_OK;
+}
+
+hal_touch_status_t hal_touch_get_predicted(uint16_t *x, uint16_t *y)
+{
+    if (!__atomic_load_n(&touch_initialized, __ATOMIC_ACQUIRE)) {
+        return HAL_TOUCH_NOT_INITIALIZED;
+    }
+
+    if (x == NULL || y == NULL) {
+        return HAL_TOUCH_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&gesture_lock);
+    bool predicted = touch_gesture_predict(&gestures, x, y);
+    pthread_mutex_unlock(&gesture_lock);
+    return predicted ? HAL_TOUCH_OK : HAL_TOUCH_NO_DATA;
+}
+
+bool hal_touch_is_touched(void)
+{
     hal_touch_data_t data;
-    hal_touch_read(&data);
+
+    if (poll_snapshot(&data) != HAL_TOUCH_OK) {
+        return false;
+    }
 
     return (data.count > 0);
 }
 
 hal_touch_status_t hal_touch_get_point(uint16_t *x, uint16_t *y)
 {
-    if (!touch_initialized) {
+    if (!__atomic_load_n(&touch_initialized, __ATOMIC_ACQUIRE)) {
         return HAL_TOUCH_NOT_INITIALIZED;
     }
 
@@ -163,7 +455,7 @@ hal_touch_status_t hal_touch_get_point(uint16_t *x, uint16_t *y)
     }
 
     hal_touch_data_t data;
-    hal_touch_status_t status = hal_touch_read(&data);
+    hal_touch_status_t status = poll_snapshot(&data);
 
     if (status == HAL_TOUCH_OK && data.count > 0 && data.points[0].valid) {
         *x = data.points[0].x;
@@ -177,173 +469,251 @@ hal_touch_status_t hal_touch_get_point(uint16_t *x, uint16_t *y)
 hal_touch_status_t hal_touch_calibrate(void)
 {
     /* FT6236 typically doesn't need software calibration */
-    printf("Touch calibration not required for FT6236\n");
+    LOGI("Touch calibration not required for FT6236");
     return HAL_TOUCH_OK;
 }
 
 /* Internal helper functions */
 
-static int find_touch_device(void)
+static hal_touch_status_t start_reader(void)
 {
-    char device_paths[][32] = {
-        "/dev/input/event0",
-        "/dev/input/event1", 
-        "/dev/input/event2",
-        "/dev/input/event3",
-        "/dev/input/event4",
-        "/dev/input/event5",
-        "/dev/input/event6",
-        "/dev/input/event7"
-    };
+    memset(&touch_ring, 0, sizeof(touch_ring));
+    reader_failed = false;
+
+    stop_fd = eventfd(0, EFD_CLOEXEC);
+    notify_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (stop_fd < 0 || notify_fd < 0) {
+        LOGE("Cannot create touch eventfd: %s", strerror(errno));
+        stop_reader();
+        return HAL_TOUCH_ERROR;
+    }
 
-    for (int i = 0; i < MAX_TOUCH_DEVICES; i++) {
-        int fd = open(device_paths[i], O_RDONLY | O_NONBLOCK);
-        if (fd >= 0) {
-            /* Check if this device supports touch events */
-            unsigned long evbit = 0;
-            if (ioctl(fd, EVIOCGBIT(0, EV_MAX), &evbit) >= 0) {
-                if (evbit & (1 << EV_ABS)) {
-                    /* Check for absolute positioning (touch/tablet) */
-                    unsigned long absbit = 0;
-                    if (ioctl(fd, EVIOCGBIT(EV_ABS, KEY_MAX), &absbit) >= 0) {
-                        if ((absbit & (1 << ABS_X)) && (absbit & (1 << ABS_Y))) {
-                            /* This looks like a touch device */
-                            strcpy(touch_device_path, device_paths[i]);
-                            printf("Found potential touch device: %s\n", device_paths[i]);
-                            
-                            /* Get device name for verification */
-                            char name[256] = "Unknown";
-                            if (ioctl(fd, EVIOCGNAME(sizeof(name)), name) >= 0) {
-                                printf("Device name: %s\n", name);
-                                
-                                /* Look for FT6236 or touch-related keywords */
-                                if (strstr(name, "ft6236") || strstr(name, "FT6236") ||
-                                    strstr(name, "touch") || strstr(name, "Touch") ||
-                                    strstr(name, "touchscreen") || strstr(name, "Touchscreen")) {
-                                    printf("Touch device confirmed: %s\n", name);
-                                    return fd;
-                                }
-                            }
-                            
-                            /* Even if name doesn't match, try this device */
-                            return fd;
-                        }
-                    }
-                }
-            }
-            close(fd);
-        }
+    int rc = pthread_create(&reader_thread, NULL, reader_main, NULL);
+    if (rc != 0) {
+        LOGE("Cannot start touch reader thread: %s", strerror(rc));
+        stop_reader();
+        return HAL_TOUCH_ERROR;
+    }
+
+    __atomic_store_n(&reader_running, true, __ATOMIC_RELEASE);
+    return HAL_TOUCH_OK;
+}
+
+static void stop_reader(void)
+{
+    if (reader_running) {
+        uint64_t one = 1;
+        (void)write(stop_fd, &one, sizeof(one));
+        pthread_join(reader_thread, NULL);
+        __atomic_store_n(&reader_running, false, __ATOMIC_RELEASE);
     }
 
-    printf("No touch device found in /dev/input/event*\n");
-    return -1;
+    if (stop_fd >= 0) {
+        close(stop_fd);
+        stop_fd = -1;
+    }
+
+    if (notify_fd >= 0) {
+        close(notify_fd);
+        notify_fd = -1;
+    }
 }
 
-static hal_touch_status_t process_input_event(struct input_event *event)
+/* Drains the device and queues one decoded frame per SYN_REPORT */
+static void *reader_main(void *arg)
 {
-    static int current_slot = 0;
-    static int tracking_id = -1;
-    bool event_processed = false;
-
-    switch (event->type) {
-        case EV_ABS:
-            switch (event->code) {
-                case ABS_MT_SLOT:
-                    current_slot = event->value;
-                    if (current_slot >= HAL_TOUCH_MAX_POINTS) {
-                        current_slot = 0;
-                    }
-                    break;
-
-                case ABS_MT_TRACKING_ID:
-                    tracking_id = event->value;
-                    if (tracking_id == -1) {
-                        /* Touch release */
-                        if (current_slot < HAL_TOUCH_MAX_POINTS) {
-                            current_touch_data.points[current_slot].valid = false;
-                            current_touch_data.points[current_slot].event = HAL_TOUCH_EVENT_RELEASE;
-                            event_processed = true;
-                        }
-                    } else {
-                        /* Touch press */
-                        if (current_slot < HAL_TOUCH_MAX_POINTS) {
-                            current_touch_data.points[current_slot].valid = true;
-                            current_touch_data.points[current_slot].id = current_slot;
-                            current_touch_data.points[current_slot].event = HAL_TOUCH_EVENT_PRESS;
-                            event_processed = true;
-                        }
-                    }
-                    break;
-
-                case ABS_MT_POSITION_X:
-                case ABS_X:
-                    if (current_slot < HAL_TOUCH_MAX_POINTS) {
-                        /* Scale X coordinate to touch panel resolution */
-                        current_touch_data.points[current_slot].x = 
-                            (event->value * HAL_TOUCH_WIDTH) / 4096;  /* Assuming 12-bit resolution */
-                        if (current_touch_data.points[current_slot].valid) {
-                            current_touch_data.points[current_slot].event = HAL_TOUCH_EVENT_MOVE;
-                            event_processed = true;
-                        }
-                    }
-                    break;
-
-                case ABS_MT_POSITION_Y:
-                case ABS_Y:
-                    if (current_slot < HAL_TOUCH_MAX_POINTS) {
-                        /* Scale Y coordinate to touch panel resolution */
-                        current_touch_data.points[current_slot].y = 
-                            (event->value * HAL_TOUCH_HEIGHT) / 4096;  /* Assuming 12-bit resolution */
-                        if (current_touch_data.points[current_slot].valid) {
-                            current_touch_data.points[current_slot].event = HAL_TOUCH_EVENT_MOVE;
-                            event_processed = true;
-                        }
-                    }
-                    break;
-
-                case ABS_MT_PRESSURE:
-                case ABS_PRESSURE:
-                    if (current_slot < HAL_TOUCH_MAX_POINTS) {
-                        current_touch_data.points[current_slot].pressure = 
-                            (event->value > 255) ? 255 : event->value;
-                    }
-                    break;
-
-                default:
-                    break;
+    (void)arg;
+
+    struct pollfd pfd[2] = {
+        { .fd = touch_fd, .events = POLLIN },
+        { .fd = stop_fd, .events = POLLIN },
+    };
+    struct input_event events[64];
+
+    for (;;) {
+        int rc = poll(pfd, 2, -1);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
             }
             break;
+        }
 
-        case EV_SYN:
-            if (event->code == SYN_REPORT) {
-                /* End of touch report - update touch count and timestamp */
-                current_touch_data.count = 0;
-                for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
-                    if (current_touch_data.points[i].valid) {
-                        current_touch_data.count++;
-                    }
+        if (pfd[1].revents) {
+            return NULL;
+        }
+
+        if (pfd[0].revents & (POLLERR | POLLNVAL)) {
+            break;
+        }
+
+        bool queued = false;
+        ssize_t bytes_read;
+        while ((bytes_read = read(touch_fd, events, sizeof(events))) > 0) {
+            int num_events = bytes_read / sizeof(struct input_event);
+
+            touch_capture_write(&capture, events, num_events);
+            for (int i = 0; i < num_events; i++) {
+                if (touch_decoder_feed(&decoder, &events[i])) {
+                    queued |= ring_push(&decoder.frame);
+                    publish_frame(&decoder.frame);
                 }
-                current_touch_data.timestamp = event->time.tv_sec * 1000 + event->time.tv_usec / 1000;
-                event_processed = true;
             }
-            break;
+        }
 
-        default:
+        if (queued) {
+            uint64_t one = 1;
+            (void)write(notify_fd, &one, sizeof(one));
+        }
+
+        /* End of a replay, after everything before it was queued */
+        if (bytes_read == 0 || (bytes_read < 0 && errno != EAGAIN && errno != EINTR)) {
             break;
+        }
     }
 
-    return event_processed ? HAL_TOUCH_OK : HAL_TOUCH_NO_DATA;
+    /* Device lost, wake any waiter so it sees the error */
+    LOGE("Touch device lost, reader thread stopped");
+    __atomic_store_n(&reader_failed, true, __ATOMIC_RELEASE);
+    uint64_t one = 1;
+    (void)write(notify_fd, &one, sizeof(one));
+    return NULL;
 }
 
-static void reset_touch_data(void)
+static bool ring_push(const hal_touch_data_t *frame)
 {
-    memset(&current_touch_data, 0, sizeof(hal_touch_data_t));
-    
-    for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
-        current_touch_data.points[i].valid = false;
-        current_touch_data.points[i].event = HAL_TOUCH_EVENT_NONE;
-    }
-    
-    current_touch_data.count = 0;
-    current_touch_data.timestamp = 0;
+    uint32_t head = touch_ring.head;
+    uint32_t tail = __atomic_load_n(&touch_ring.tail, __ATOMIC_ACQUIRE);
+
+    /* Full: drop the new frame, the consumer still sees the older ones in order */
+    if (head - tail == TOUCH_RING_SIZE) {
+        __atomic_fetch_add(&touch_ring.overflows, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    touch_ring.frames[head & (TOUCH_RING_SIZE - 1)] = *frame;
+    __atomic_store_n(&touch_ring.head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static int ring_pop(hal_touch_data_t *frames, int max)
+{
+    uint32_t tail = touch_ring.tail;
+    uint32_t head = __atomic_load_n(&touch_ring.head, __ATOMIC_ACQUIRE);
+    uint32_t count = head - tail;
+
+    if (count > (uint32_t)max) {
+        count = (uint32_t)max;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        frames[i] = touch_ring.frames[(tail + i) & (TOUCH_RING_SIZE - 1)];
+    }
+
+    __atomic_store_n(&touch_ring.tail, tail + count, __ATOMIC_RELEASE);
+    return (int)count;
+}
+
+/* abs: axis ranges of a replayed capture, NULL to query the device */
+static hal_touch_status_t attach_device(int fd, const struct input_absinfo *abs)
+{
+    touch_fd = fd;
+    LOGI("Touch device opened: %s (fd=%d)", touch_device_path, touch_fd);
+
+    /* Axis ranges and slot count come from the device, a replay cannot resync */
+    if (abs != NULL) {
+        touch_decoder_init_axes(&decoder, -1, abs, HAL_TOUCH_WIDTH, HAL_TOUCH_HEIGHT);
+    } else {
+        touch_decoder_init(&decoder, touch_fd, HAL_TOUCH_WIDTH, HAL_TOUCH_HEIGHT);
+    }
+
+    /* One file per session, a device that comes back keeps appending to it */
+    if (record_path[0] && abs == NULL && capture.fd < 0) {
+        touch_capture_create(&capture, record_path, touch_fd);
+    }
+    publish_frame(&decoder.frame);
+    pthread_mutex_lock(&gesture_lock);
+    touch_gesture_init(&gestures);
+    pthread_mutex_unlock(&gesture_lock);
+    LOGI("Touch decoder: %s, %d slot(s)",
+         decoder.multitouch ? "multi-touch" : "single-touch", decoder.slot_count);
+
+    if (threaded_requested && start_reader() != HAL_TOUCH_OK) {
+        LOGW("Continuing without touch reader thread");
+    }
+
+    return HAL_TOUCH_OK;
+}
+
+static void detach_device(void)
+{
+    stop_reader();
+
+    /* The replay thread goes first, so it never writes into a closed pipe */
+    touch_replay_stop(&replay);
+    if (touch_fd >= 0) {
+        close(touch_fd);
+        touch_fd = -1;
+    }
+
+    touch_decoder_reset(&decoder);
+    publish_frame(&decoder.frame);
+}
+
+/* Decode everything pending on the device (input_lock held, not threaded) */
+static bool drain_device(void)
+{
+    struct input_event events[64];
+    ssize_t bytes_read;
+    bool data_updated = false;
+
+    /* Read all available events */
+    while ((bytes_read = read(touch_fd, events, sizeof(events))) > 0) {
+        int num_events = bytes_read / sizeof(struct input_event);
+
+        touch_capture_write(&capture, events, num_events);
+        for (int i = 0; i < num_events; i++) {
+            if (touch_decoder_feed(&decoder, &events[i])) {
+                feed_gestures(&decoder.frame, 1);
+                data_updated = true;
+            }
+        }
+    }
+
+    if (data_updated) {
+        publish_frame(&decoder.frame);
+    }
+
+    return data_updated;
+}
+
+/* Single writer: the reader thread, or whoever holds input_lock */
+static void publish_frame(const hal_touch_data_t *frame)
+{
+    seqlock_write_begin(&snapshot_lock);
+    seqlock_store(snapshot_words, frame, sizeof(*frame));
+    seqlock_write_end(&snapshot_lock);
+}
+
+static void feed_gestures(const hal_touch_data_t *frames, int count)
+{
+    pthread_mutex_lock(&gesture_lock);
+    for (int i = 0; i < count; i++) {
+        touch_gesture_feed(&gestures, &frames[i]);
+    }
+    pthread_mutex_unlock(&gesture_lock);
+}
+
+/* Latest frame for the polling helpers, draining the device if nobody else is */
+static hal_touch_status_t poll_snapshot(hal_touch_data_t *data)
+{
+    if (!__atomic_load_n(&reader_running, __ATOMIC_ACQUIRE) &&
+        pthread_mutex_trylock(&input_lock) == 0) {
+        if (touch_fd >= 0) {
+            drain_device();
+        }
+        pthread_mutex_unlock(&input_lock);
+    }
+
+    return hal_touch_get_snapshot(data);
 }
@@ -0,0 +1,328 @@
+/**
+ * @file touch_capture.c
+ * @brief Touch capture files and the replay thread
+ *
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "touch_capture.h"
+#include "touch_decoder.h"
+#include "log.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Events per replay write. A whole batch fits in PIPE_BUF, so each
+ * non-blocking write is all or nothing and a report is never split.
+ */
+#define REPLAY_BATCH            64
+
+static void *replay_main(void *arg);
+
+static uint64_t event_us(const struct input_event *ev)
+{
+    return (uint64_t)ev->time.tv_sec * 1000000 + (uint64_t)ev->time.tv_usec;
+}
+
+bool touch_capture_create(touch_capture_writer_t *w, const char *path, int device_fd)
+{
+    touch_capture_header_t header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TOUCH_CAPTURE_MAGIC, sizeof(header.magic));
+    header.version = TOUCH_CAPTURE_VERSION;
+    header.event_size = sizeof(touch_capture_event_t);
+    if (ioctl(device_fd, EVIOCGNAME(sizeof(header.name) - 1), header.name) < 0) {
+        header.name[0] = '\0';
+    }
+    touch_decoder_query_axes(device_fd, header.abs);
+
+    w->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    w->start_us = 0;
+    w->events = 0;
+    if (w->fd < 0) {
+        LOGE("Cannot create touch capture %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    if (write(w->fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+        LOGE("Cannot write touch capture %s: %s", path, strerror(errno));
+        close(w->fd);
+        w->fd = -1;
+        return false;
+    }
+
+    LOGI("Recording touch input to %s", path);
+    return true;
+}
+
+void touch_capture_write(touch_capture_writer_t *w, const struct input_event *events, int count)
+{
+    touch_capture_event_t records[REPLAY_BATCH];
+
+    if (w->fd < 0 || count <= 0) {
+        return;
+    }
+
+    /* Times count from the first event, which the header keeps */
+    if (w->events == 0) {
+        w->start_us = event_us(&events[0]);
+        if (pwrite(w->fd, &w->start_us, sizeof(w->start_us),
+                   offsetof(touch_capture_header_t, start_us)) != (ssize_t)sizeof(w->start_us)) {
+            LOGW("Touch capture header not updated: %s", strerror(errno));
+        }
+    }
+
+    while (count > 0) {
+        int n = count < REPLAY_BATCH ? count : REPLAY_BATCH;
+
+        for (int i = 0; i < n; i++) {
+            uint64_t t = event_us(&events[i]);
+            records[i].time_us = t > w->start_us ? t - w->start_us : 0;
+            records[i].type = events[i].type;
+            records[i].code = events[i].code;
+            records[i].value = events[i].value;
+        }
+
+        ssize_t size = (ssize_t)(n * sizeof(records[0]));
+        if (write(w->fd, records, (size_t)size) != size) {
+            /* A full disk must not take input down with it */
+            LOGE("Touch capture stopped after %u events: %s", w->events, strerror(errno));
+            touch_capture_close(w);
+            return;
+        }
+
+        w->events += (uint32_t)n;
+        events += n;
+        count -= n;
+    }
+}
+
+void touch_capture_close(touch_capture_writer_t *w)
+{
+    if (w->fd < 0) {
+        return;
+    }
+
+    LOGI("Touch capture closed, %u events", w->events);
+    close(w->fd);
+    w->fd = -1;
+}
+
+int touch_capture_open(const char *path, touch_capture_header_t *header)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOGE("Cannot open touch capture %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    if (read(fd, header, sizeof(*header)) != (ssize_t)sizeof(*header) ||
+        memcmp(header->magic, TOUCH_CAPTURE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != TOUCH_CAPTURE_VERSION ||
+        header->event_size != sizeof(touch_capture_event_t)) {
+        LOGE("%s is not a touch capture", path);
+        close(fd);
+        return -1;
+    }
+
+    header->name[sizeof(header->name) - 1] = '\0';
+    return fd;
+}
+
+int touch_capture_read(int fd, touch_capture_event_t *events, int max)
+{
+    ssize_t bytes;
+
+    do {
+        bytes = read(fd, events, (size_t)max * sizeof(events[0]));
+    } while (bytes < 0 && errno == EINTR);
+
+    /* A record cut short by a crash ends the file */
+    return bytes < 0 ? -1 : (int)((size_t)bytes / sizeof(events[0]));
+}
+
+void touch_capture_to_event(uint64_t start_us, const touch_capture_event_t *rec, struct input_event *ev)
+{
+    uint64_t t = start_us + rec->time_us;
+
+    memset(ev, 0, sizeof(*ev));
+    ev->time.tv_sec = (time_t)(t / 1000000);
+    ev->time.tv_usec = (suseconds_t)(t % 1000000);
+    ev->type = rec->type;
+    ev->code = rec->code;
+    ev->value = rec->value;
+}
+
+int touch_replay_start(touch_replay_t *r, const char *path, float speed, touch_capture_header_t *header)
+{
+    int fds[2] = { -1, -1 };
+
+    memset(r, 0, sizeof(*r));
+    r->pipe_fd = r->stop_fd = -1;
+
+    r->file_fd = touch_capture_open(path, header);
+    if (r->file_fd < 0) {
+        return -1;
+    }
+    r->speed = speed > 0.0f ? speed : 0.0f;
+    r->start_us = header->start_us;
+
+    r->stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (r->stop_fd < 0 || pipe2(fds, O_CLOEXEC | O_NONBLOCK) < 0) {
+        LOGE("Cannot set up touch replay: %s", strerror(errno));
+        goto fail;
+    }
+    r->pipe_fd = fds[1];
+
+    int rc = pthread_create(&r->thread, NULL, replay_main, r);
+    if (rc != 0) {
+        LOGE("Cannot start touch replay thread: %s", strerror(rc));
+        goto fail;
+    }
+
+    r->running = true;
+    if (r->speed > 0.0f) {
+        LOGI("Replaying touch capture %s (%s) at %.2fx", path, header->name, (double)r->speed);
+    } else {
+        LOGI("Replaying touch capture %s (%s) without delays", path, header->name);
+    }
+    return fds[0];
+
+fail:
+    if (fds[0] >= 0) {
+        close(fds[0]);
+    }
+    touch_replay_stop(r);
+    return -1;
+}
+
+void touch_replay_stop(touch_replay_t *r)
+{
+    if (r->running) {
+        uint64_t one = 1;
+        (void)write(r->stop_fd, &one, sizeof(one));
+        pthread_join(r->thread, NULL);
+        r->running = false;
+    }
+
+    if (r->pipe_fd >= 0) {
+        close(r->pipe_fd);
+        r->pipe_fd = -1;
+    }
+    if (r->stop_fd >= 0) {
+        close(r->stop_fd);
+        r->stop_fd = -1;
+    }
+    if (r->file_fd >= 0) {
+        close(r->file_fd);
+        r->file_fd = -1;
+    }
+}
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/* Sleep until the event is due, false if asked to stop meanwhile */
+static bool replay_wait(touch_replay_t *r, uint64_t start_ns, uint64_t time_us)
+{
+    struct pollfd pfd = { .fd = r->stop_fd, .events = POLLIN };
+    uint64_t due = start_ns + (uint64_t)((double)time_us * 1000.0 / r->speed);
+
+    for (;;) {
+        uint64_t now = monotonic_ns();
+        struct timespec timeout = { 0, 0 };
+
+        if (now < due) {
+            timeout.tv_sec = (time_t)((due - now) / 1000000000);
+            timeout.tv_nsec = (long)((due - now) % 1000000000);
+        }
+
+        int rc = ppoll(&pfd, 1, &timeout, NULL);
+        if (rc > 0) {
+            return false;
+        }
+        if (rc == 0 && monotonic_ns() >= due) {
+            return true;
+        }
+    }
+}
+
+/* Queue one batch, waiting for room while the reader lags */
+static bool replay_send(touch_replay_t *r, const struct input_event *events, int count)
+{
+    struct pollfd pfd[2] = {
+        { .fd = r->pipe_fd, .events = POLLOUT },
+        { .fd = r->stop_fd, .events = POLLIN },
+    };
+    ssize_t size = (ssize_t)(count * sizeof(events[0]));
+
+    for (;;) {
+        ssize_t written = write(r->pipe_fd, events, (size_t)size);
+        if (written == size) {
+            return true;
+        }
+        if (written >= 0 || (errno != EAGAIN && errno != EINTR)) {
+            return false;
+        }
+
+        if (poll(pfd, 2, -1) < 0 && errno != EINTR) {
+            return false;
+        }
+        if (pfd[1].revents) {
+            return false;
+        }
+    }
+}
+
+/* Paces the file into the pipe, one write per report */
+static void *replay_main(void *arg)
+{
+    touch_replay_t *r = arg;
+    touch_capture_event_t records[REPLAY_BATCH];
+    struct input_event batch[REPLAY_BATCH];
+    uint64_t start_ns = monotonic_ns();
+    uint32_t sent = 0;
+    int pending = 0;
+    int count;
+
+    while ((count = touch_capture_read(r->file_fd, records, REPLAY_BATCH)) > 0) {
+        for (int i = 0; i < count; i++) {
+            touch_capture_to_event(r->start_us, &records[i], &batch[pending++]);
+            if ((records[i].type != EV_SYN || records[i].code != SYN_REPORT) && pending < REPLAY_BATCH) {
+                continue;
+            }
+
+            if ((r->speed > 0.0f && !replay_wait(r, start_ns, records[i].time_us)) ||
+                !replay_send(r, batch, pending)) {
+                return NULL;
+            }
+            sent += (uint32_t)pending;
+            pending = 0;
+        }
+    }
+
+    if (pending > 0 && replay_send(r, batch, pending)) {
+        sent += (uint32_t)pending;
+    }
+
+    /* Closing the write end is the end of input for the reader */
+    LOGI("Touch replay finished, %u events", sent);
+    close(r->pipe_fd);
+    r->pipe_fd = -1;
+    return NULL;
+}
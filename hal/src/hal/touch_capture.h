@@ -0,0 +1,130 @@
+/**
+ * @file touch_capture.h
+ * @brief Internal touch capture files: recording and replay of evdev streams
+ *
+ * A capture is a header holding the device's axis ranges, followed by
+ * fixed 16-byte records timed from the first event. struct input_event
+ * changes size with time_t, so a file recorded on the board reads the
+ * same on a 64-bit host.
+ *
+ * Replay runs a thread that writes the events into a pipe at the recorded
+ * pace, scaled by a speed factor. The touch module reads the pipe instead
+ * of the device, so polling, the reader thread and hal_touch_get_fd() work
+ * unchanged, and the end of the file looks like an unplugged device.
+ * Events keep their recorded times, so gestures come out the same at any
+ * speed.
+ *
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#ifndef HAL_TOUCH_CAPTURE_H
+#define HAL_TOUCH_CAPTURE_H
+
+#include "../../include/hal.h"
+#include <linux/input.h>
+#include <pthread.h>
+
+#define TOUCH_CAPTURE_MAGIC     "HALTOUCH"
+#define TOUCH_CAPTURE_VERSION   1
+#define TOUCH_CAPTURE_PATH_MAX  256
+
+typedef struct {
+    char magic[8];              /* TOUCH_CAPTURE_MAGIC, not terminated */
+    uint32_t version;
+    uint32_t event_size;        /* sizeof(touch_capture_event_t) */
+    uint64_t start_us;          /* Kernel time of the first event, 0 until one arrived */
+    char name[64];              /* Device name from EVIOCGNAME */
+    struct input_absinfo abs[ABS_CNT];  /* Zeroed for axes the device lacks */
+} touch_capture_header_t;
+
+typedef struct {
+    uint64_t time_us;           /* Since the first event */
+    uint16_t type;
+    uint16_t code;
+    int32_t value;
+} touch_capture_event_t;
+
+/* Recording side, fed with every batch read from the device */
+typedef struct {
+    int fd;                     /* -1 when not recording */
+    uint64_t start_us;
+    uint32_t events;            /* Written so far */
+} touch_capture_writer_t;
+
+/* Replay side, see touch_replay_start() */
+typedef struct {
+    int file_fd;
+    int pipe_fd;                /* Write end, the touch module reads the other one */
+    int stop_fd;
+    float speed;                /* 1 = as recorded, 0 = as fast as the reader takes it */
+    uint64_t start_us;
+    pthread_t thread;
+    bool running;
+} touch_replay_t;
+
+/**
+ * @brief Start recording to a new capture file
+ * @param w Writer to set up
+ * @param path File to create or truncate
+ * @param device_fd Device whose name and axis ranges go into the header
+ * @return true on success
+ */
+bool touch_capture_create(touch_capture_writer_t *w, const char *path, int device_fd);
+
+/**
+ * @brief Append events as read from the device, in one write
+ * @param w Writer, ignored when not recording
+ * @param events Events in arrival order
+ * @param count Number of events
+ */
+void touch_capture_write(touch_capture_writer_t *w, const struct input_event *events, int count);
+
+/**
+ * @brief Stop recording and close the file
+ * @param w Writer, ignored when not recording
+ */
+void touch_capture_close(touch_capture_writer_t *w);
+
+/**
+ * @brief Open a capture file and read its header
+ * @param path Capture file
+ * @param header Receives the header
+ * @return Descriptor positioned at the first event, or -1 on error
+ */
+int touch_capture_open(const char *path, touch_capture_header_t *header);
+
+/**
+ * @brief Read the next events of a capture file
+ * @param fd Descriptor from touch_capture_open()
+ * @param events Receives up to max events
+ * @param max Capacity of events
+ * @return Events read, 0 at the end of the file, -1 on error
+ */
+int touch_capture_read(int fd, touch_capture_event_t *events, int max);
+
+/**
+ * @brief Convert a capture record back to an input event with its recorded time
+ * @param start_us Header start_us
+ * @param rec Record
+ * @param ev Receives the event
+ */
+void touch_capture_to_event(uint64_t start_us, const touch_capture_event_t *rec, struct input_event *ev);
+
+/**
+ * @brief Start replaying a capture file
+ * @param r Replay state
+ * @param path Capture file
+ * @param speed Pace factor, 1 = as recorded, 0 = no delays
+ * @param header Receives the header (name and axis ranges for the decoder)
+ * @return Non-blocking read end of the event pipe, or -1 on error
+ */
+int touch_replay_start(touch_replay_t *r, const char *path, float speed, touch_capture_header_t *header);
+
+/**
+ * @brief Stop the replay thread and release its descriptors
+ * @param r Replay state, ignored if not running
+ */
+void touch_replay_stop(touch_replay_t *r);
+
+#endif /* HAL_TOUCH_CAPTURE_H */
@@ -0,0 +1,303 @@
+/**
+ * @file touch_decoder.c
+ * @brief Evdev multi-touch decoder
+ * 
+ * Implements the type B multi-touch protocol (ABS_MT_SLOT, tracking IDs)
+ * and falls back to ABS_X/ABS_Y with BTN_TOUCH for single-touch panels.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "touch_decoder.h"
+#include <string.h>
+#include <sys/ioctl.h>
+
+/* Range assumed when the driver does not report one (12-bit controllers) */
+#define TOUCH_DEFAULT_MAX       4095
+
+typedef void (*touch_axis_handler_t)(touch_decoder_t *dec, int32_t value);
+
+static void on_ignore(touch_decoder_t *dec, int32_t value);
+static void on_slot(touch_decoder_t *dec, int32_t value);
+static void on_tracking_id(touch_decoder_t *dec, int32_t value);
+static void on_x(touch_decoder_t *dec, int32_t value);
+static void on_y(touch_decoder_t *dec, int32_t value);
+static void on_pressure(touch_decoder_t *dec, int32_t value);
+static void resync_slots(touch_decoder_t *dec);
+
+static const touch_axis_handler_t axis_handlers[TOUCH_AXIS_COUNT] = {
+    [TOUCH_AXIS_NONE]        = on_ignore,
+    [TOUCH_AXIS_SLOT]        = on_slot,
+    [TOUCH_AXIS_TRACKING_ID] = on_tracking_id,
+    [TOUCH_AXIS_X]           = on_x,
+    [TOUCH_AXIS_Y]           = on_y,
+    [TOUCH_AXIS_PRESSURE]    = on_pressure,
+};
+
+/* A range the device reports, as opposed to a zeroed entry */
+static bool has_axis(const struct input_absinfo *abs, int code)
+{
+    return abs[code].maximum > abs[code].minimum;
+}
+
+static void setup_scale(touch_axis_scale_t *axis, const struct input_absinfo *info, uint16_t limit)
+{
+    int32_t min = info ? info->minimum : 0;
+    int32_t max = info ? info->maximum : TOUCH_DEFAULT_MAX;
+
+    axis->min = min;
+    axis->range = (uint32_t)(max - min);
+    axis->limit = limit;
+    axis->scale = ((uint32_t)limit << 16) / axis->range;
+}
+
+static inline uint16_t scale_value(const touch_axis_scale_t *axis, int32_t value)
+{
+    int64_t offset = (int64_t)value - axis->min;
+    if (offset <= 0) {
+        return 0;
+    }
+    if (offset >= axis->range) {
+        return axis->limit;
+    }
+    return (uint16_t)(((uint32_t)offset * axis->scale) >> 16);
+}
+
+void touch_decoder_query_axes(int fd, struct input_absinfo abs[ABS_CNT])
+{
+    static const int codes[] = {
+        ABS_X, ABS_Y, ABS_PRESSURE,
+        ABS_MT_SLOT, ABS_MT_POSITION_X, ABS_MT_POSITION_Y, ABS_MT_PRESSURE
+    };
+
+    memset(abs, 0, ABS_CNT * sizeof(abs[0]));
+    for (size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); i++) {
+        if (ioctl(fd, EVIOCGABS(codes[i]), &abs[codes[i]]) < 0) {
+            memset(&abs[codes[i]], 0, sizeof(abs[0]));
+        }
+    }
+}
+
+void touch_decoder_init(touch_decoder_t *dec, int fd, uint16_t width, uint16_t height)
+{
+    struct input_absinfo abs[ABS_CNT];
+
+    touch_decoder_query_axes(fd, abs);
+    touch_decoder_init_axes(dec, fd, abs, width, height);
+}
+
+void touch_decoder_init_axes(touch_decoder_t *dec, int fd, const struct input_absinfo abs[ABS_CNT],
+                             uint16_t width, uint16_t height)
+{
+    int ax, ay, ap;
+
+    memset(dec, 0, sizeof(*dec));
+    dec->fd = fd;
+
+    dec->multitouch = has_axis(abs, ABS_MT_POSITION_X) && has_axis(abs, ABS_MT_POSITION_Y);
+    if (dec->multitouch) {
+        ax = ABS_MT_POSITION_X;
+        ay = ABS_MT_POSITION_Y;
+        ap = ABS_MT_PRESSURE;
+
+        /* Slots 0..max, without ABS_MT_SLOT the device has a single one */
+        dec->slot_count = has_axis(abs, ABS_MT_SLOT) ? abs[ABS_MT_SLOT].maximum + 1 : 1;
+        dec->abs_map[ABS_MT_SLOT] = TOUCH_AXIS_SLOT;
+        dec->abs_map[ABS_MT_TRACKING_ID] = TOUCH_AXIS_TRACKING_ID;
+        dec->abs_map[ABS_MT_POSITION_X] = TOUCH_AXIS_X;
+        dec->abs_map[ABS_MT_POSITION_Y] = TOUCH_AXIS_Y;
+        dec->abs_map[ABS_MT_PRESSURE] = TOUCH_AXIS_PRESSURE;
+        /* ABS_X/ABS_Y only repeat the oldest contact for legacy readers */
+    } else {
+        ax = ABS_X;
+        ay = ABS_Y;
+        ap = ABS_PRESSURE;
+
+        dec->slot_count = 1;
+        dec->abs_map[ABS_X] = TOUCH_AXIS_X;
+        dec->abs_map[ABS_Y] = TOUCH_AXIS_Y;
+        dec->abs_map[ABS_PRESSURE] = TOUCH_AXIS_PRESSURE;
+    }
+
+    setup_scale(&dec->x, has_axis(abs, ax) ? &abs[ax] : NULL, width - 1);
+    setup_scale(&dec->y, has_axis(abs, ay) ? &abs[ay] : NULL, height - 1);
+    setup_scale(&dec->pressure, has_axis(abs, ap) ? &abs[ap] : NULL, 255);
+
+    if (dec->slot_count > HAL_TOUCH_MAX_POINTS) {
+        dec->slot_count = HAL_TOUCH_MAX_POINTS;
+    }
+    touch_decoder_reset(dec);
+}
+
+void touch_decoder_reset(touch_decoder_t *dec)
+{
+    memset(&dec->frame, 0, sizeof(dec->frame));
+    for (int i = 0; i < HAL_TOUCH_MAX_POINTS; i++) {
+        dec->frame.points[i].id = (uint8_t)i;
+        dec->frame.points[i].event = HAL_TOUCH_EVENT_NONE;
+    }
+    dec->slot = 0;
+    dec->dropped = false;
+    dec->report_open = false;
+}
+
+bool touch_decoder_feed(touch_decoder_t *dec, const struct input_event *ev)
+{
+    /* A press is reported once, the same contact is a move in later reports */
+    if (!dec->report_open) {
+        for (int i = 0; i < dec->slot_count; i++) {
+            if (dec->frame.points[i].event == HAL_TOUCH_EVENT_PRESS) {
+                dec->frame.points[i].event = HAL_TOUCH_EVENT_MOVE;
+            }
+        }
+        dec->report_open = true;
+    }
+
+    if (ev->type == EV_ABS) {
+        if (ev->code < ABS_CNT && !dec->dropped) {
+            axis_handlers[dec->abs_map[ev->code]](dec, ev->value);
+        }
+        return false;
+    }
+
+    if (ev->type == EV_KEY) {
+        /* Single-touch panels signal contact with BTN_TOUCH instead of tracking IDs */
+        if (ev->code == BTN_TOUCH && !dec->multitouch && !dec->dropped) {
+            on_tracking_id(dec, ev->value ? 0 : -1);
+        }
+        return false;
+    }
+
+    if (ev->type != EV_SYN) {
+        return false;
+    }
+
+    if (ev->code == SYN_DROPPED) {
+        /* Everything up to the next report is incomplete */
+        dec->dropped = true;
+        return false;
+    }
+
+    if (ev->code != SYN_REPORT) {
+        return false;
+    }
+
+    if (dec->dropped) {
+        resync_slots(dec);
+        dec->dropped = false;
+    }
+    dec->report_open = false;
+
+    uint8_t count = 0;
+    for (int i = 0; i < dec->slot_count; i++) {
+        count += dec->frame.points[i].valid;
+    }
+    dec->frame.count = count;
+    dec->frame.timestamp = ev->time.tv_sec * 1000 + ev->time.tv_usec / 1000;
+    return true;
+}
+
+/* Axis handlers, indexed by touch_axis_t */
+
+static void on_ignore(touch_decoder_t *dec, int32_t value)
+{
+    (void)dec;
+    (void)value;
+}
+
+static void on_slot(touch_decoder_t *dec, int32_t value)
+{
+    dec->slot = (value >= 0 && value < dec->slot_count) ? value : -1;
+}
+
+static void on_tracking_id(touch_decoder_t *dec, int32_t value)
+{
+    if (dec->slot < 0) {
+        return;
+    }
+
+    hal_touch_point_t *point = &dec->frame.points[dec->slot];
+    point->valid = (value >= 0);
+    point->event = point->valid ? HAL_TOUCH_EVENT_PRESS : HAL_TOUCH_EVENT_RELEASE;
+}
+
+static void on_x(touch_decoder_t *dec, int32_t value)
+{
+    if (dec->slot < 0) {
+        return;
+    }
+
+    hal_touch_point_t *point = &dec->frame.points[dec->slot];
+    point->x = scale_value(&dec->x, value);
+    if (point->valid && point->event != HAL_TOUCH_EVENT_PRESS) {
+        point->event = HAL_TOUCH_EVENT_MOVE;
+    }
+}
+
+static void on_y(touch_decoder_t *dec, int32_t value)
+{
+    if (dec->slot < 0) {
+        return;
+    }
+
+    hal_touch_point_t *point = &dec->frame.points[dec->slot];
+    point->y = scale_value(&dec->y, value);
+    if (point->valid && point->event != HAL_TOUCH_EVENT_PRESS) {
+        point->event = HAL_TOUCH_EVENT_MOVE;
+    }
+}
+
+static void on_pressure(touch_decoder_t *dec, int32_t value)
+{
+    if (dec->slot < 0) {
+        return;
+    }
+
+    dec->frame.points[dec->slot].pressure = (uint8_t)scale_value(&dec->pressure, value);
+}
+
+/* Reload every slot from the kernel's state after events were lost */
+static void resync_slots(touch_decoder_t *dec)
+{
+    if (!dec->multitouch) {
+        return;
+    }
+
+    struct {
+        uint32_t code;
+        int32_t values[HAL_TOUCH_MAX_POINTS];
+    } ids, xs, ys;
+    ids.code = ABS_MT_TRACKING_ID;
+    xs.code = ABS_MT_POSITION_X;
+    ys.code = ABS_MT_POSITION_Y;
+
+    size_t size = sizeof(uint32_t) + dec->slot_count * sizeof(int32_t);
+    if (ioctl(dec->fd, EVIOCGMTSLOTS(size), &ids) < 0 ||
+        ioctl(dec->fd, EVIOCGMTSLOTS(size), &xs) < 0 ||
+        ioctl(dec->fd, EVIOCGMTSLOTS(size), &ys) < 0) {
+        touch_decoder_reset(dec);
+        return;
+    }
+
+    for (int i = 0; i < dec->slot_count; i++) {
+        hal_touch_point_t *point = &dec->frame.points[i];
+        bool was_valid = point->valid;
+
+        point->valid = (ids.values[i] >= 0);
+        point->x = scale_value(&dec->x, xs.values[i]);
+        point->y = scale_value(&dec->y, ys.values[i]);
+        if (point->valid) {
+            point->event = was_valid ? HAL_TOUCH_EVENT_MOVE : HAL_TOUCH_EVENT_PRESS;
+        } else if (was_valid) {
+            point->event = HAL_TOUCH_EVENT_RELEASE;
+        }
+    }
+
+    /* The device keeps addressing the slot it last selected */
+    struct input_absinfo slot;
+    if (ioctl(dec->fd, EVIOCGABS(ABS_MT_SLOT), &slot) == 0) {
+        on_slot(dec, slot.value);
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file touch_decoder.h
+ * @brief Internal evdev multi-touch decoder
+ * 
+ * One decoder per opened input device. Axis ranges come from EVIOCGABS
+ * when the decoder is initialized and are turned into Q16 scale factors,
+ * the slot count comes from the ABS_MT_SLOT range, and EV_ABS codes are
+ * dispatched through a per-device lookup table, so decoding an event is
+ * the same few operations on any panel.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#ifndef HAL_TOUCH_DECODER_H
+#define HAL_TOUCH_DECODER_H
+
+#include "../../include/hal.h"
+#include <linux/input.h>
+
+/* What an EV_ABS code feeds, index into the decoder's handler table */
+typedef enum {
+    TOUCH_AXIS_NONE = 0,
+    TOUCH_AXIS_SLOT,
+    TOUCH_AXIS_TRACKING_ID,
+    TOUCH_AXIS_X,
+    TOUCH_AXIS_Y,
+    TOUCH_AXIS_PRESSURE,
+    TOUCH_AXIS_COUNT
+} touch_axis_t;
+
+/* Maps a raw axis value onto 0..limit */
+typedef struct {
+    int32_t min;
+    uint32_t range;             /* max - min, at least 1 */
+    uint32_t scale;             /* Q16 output units per raw unit */
+    uint16_t limit;
+} touch_axis_scale_t;
+
+typedef struct {
+    int fd;                     /* Device, used to resynchronize after SYN_DROPPED */
+    uint8_t abs_map[ABS_CNT];   /* touch_axis_t for each EV_ABS code */
+    touch_axis_scale_t x;
+    touch_axis_scale_t y;
+    touch_axis_scale_t pressure;
+    bool multitouch;            /* Type B slots, otherwise single touch with BTN_TOUCH */
+    int slot_count;             /* Slots reported, at most HAL_TOUCH_MAX_POINTS */
+    int slot;                   /* Current slot, -1 while the device addresses one we skip */
+    bool dropped;               /* Kernel queue overflowed, resync on the next report */
+    bool report_open;           /* Events seen since the last SYN_REPORT */
+    hal_touch_data_t frame;     /* Decoded state, consistent after each SYN_REPORT */
+} touch_decoder_t;
+
+/**
+ * @brief Set up a decoder from the device's absolute axis ranges
+ * @param dec Decoder to initialize
+ * @param fd Opened evdev device
+ * @param width Output X range in pixels
+ * @param height Output Y range in pixels
+ */
+void touch_decoder_init(touch_decoder_t *dec, int fd, uint16_t width, uint16_t height);
+
+/**
+ * @brief Set up a decoder from axis ranges read earlier, e.g. from a capture file
+ * @param dec Decoder to initialize
+ * @param fd Descriptor used to resynchronize, -1 for none
+ * @param abs Ranges indexed by EV_ABS code, zeroed for axes the device lacks
+ * @param width Output X range in pixels
+ * @param height Output Y range in pixels
+ */
+void touch_decoder_init_axes(touch_decoder_t *dec, int fd, const struct input_absinfo abs[ABS_CNT],
+                             uint16_t width, uint16_t height);
+
+/**
+ * @brief Read the ranges of the axes the decoder uses
+ * @param fd Opened evdev device
+ * @param abs Receives ranges indexed by EV_ABS code, zeroed for absent axes
+ */
+void touch_decoder_query_axes(int fd, struct input_absinfo abs[ABS_CNT]);
+
+/**
+ * @brief Forget all contacts
+ * @param dec Decoder
+ */
+void touch_decoder_reset(touch_decoder_t *dec);
+
+/**
+ * @brief Decode one input event
+ * @param dec Decoder
+ * @param ev Event read from the device
+ * @return true when ev completed a report and dec->frame holds a new frame
+ */
+bool touch_decoder_feed(touch_decoder_t *dec, const struct input_event *ev);
+
+#endif /* HAL_TOUCH_DECODER_H */
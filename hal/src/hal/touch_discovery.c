@@ -0,0 +1,315 @@
+/**
+ * @file touch_discovery.c
+ * @brief Touchscreen discovery from sysfs, path cache and uevent hotplug
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "touch_discovery.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <linux/input.h>
+#include <linux/netlink.h>
+
+#define SYSFS_INPUT_DIR         "/sys/class/input"
+#define DEV_INPUT_DIR           "/dev/input"
+#define TOUCH_NAME_MAX          128
+
+#define BITS_PER_LONG           (8 * sizeof(unsigned long))
+#define NLONGS(nbits)           (((nbits) + BITS_PER_LONG - 1) / BITS_PER_LONG)
+
+static bool test_bit(const unsigned long *bits, unsigned int bit)
+{
+    return (bits[bit / BITS_PER_LONG] >> (bit % BITS_PER_LONG)) & 1;
+}
+
+static bool read_sysfs(const char *event_name, const char *attr, char *buf, size_t len)
+{
+    char path[128];
+    snprintf(path, sizeof(path), SYSFS_INPUT_DIR "/%s/device/%s", event_name, attr);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    ssize_t n = read(fd, buf, len - 1);
+    close(fd);
+    if (n <= 0) {
+        return false;
+    }
+
+    buf[n] = '\0';
+    buf[strcspn(buf, "\n")] = '\0';
+    return true;
+}
+
+/* Capability files list hex words most significant first, leading zero words dropped */
+static void parse_bitmap(const char *text, unsigned long *bits, size_t nlongs)
+{
+    const char *words[64];
+    size_t count = 0;
+
+    memset(bits, 0, nlongs * sizeof(unsigned long));
+    for (const char *p = text; *p && count < 64; ) {
+        while (*p == ' ') {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+        words[count++] = p;
+        while (*p && *p != ' ') {
+            p++;
+        }
+    }
+
+    for (size_t i = 0; i < count && i < nlongs; i++) {
+        bits[i] = strtoul(words[count - 1 - i], NULL, 16);
+    }
+}
+
+static bool name_looks_like_touch(const char *name)
+{
+    return strcasestr(name, "touch") || strcasestr(name, "ft6236") || strcasestr(name, "ft5x06");
+}
+
+/* Rank an event node from sysfs, 0 means not a touchscreen */
+static int score_node(const char *event_name, char *name, size_t name_len)
+{
+    char text[512];
+    unsigned long abs[NLONGS(ABS_CNT)];
+    unsigned long props[NLONGS(INPUT_PROP_CNT)];
+
+    if (!read_sysfs(event_name, "capabilities/abs", text, sizeof(text))) {
+        return 0;
+    }
+    parse_bitmap(text, abs, NLONGS(ABS_CNT));
+
+    bool mt = test_bit(abs, ABS_MT_POSITION_X) && test_bit(abs, ABS_MT_POSITION_Y);
+    if (!mt && !(test_bit(abs, ABS_X) && test_bit(abs, ABS_Y))) {
+        return 0;
+    }
+
+    int score = 1 + (mt ? 2 : 0);
+    if (read_sysfs(event_name, "properties", text, sizeof(text))) {
+        parse_bitmap(text, props, NLONGS(INPUT_PROP_CNT));
+        /* Touchscreens are direct, touchpads and tablets are not */
+        if (test_bit(props, INPUT_PROP_DIRECT)) {
+            score += 4;
+        }
+    }
+
+    if (!read_sysfs(event_name, "name", name, name_len)) {
+        snprintf(name, name_len, "Unknown");
+    } else if (name_looks_like_touch(name)) {
+        score += 1;
+    }
+
+    return score;
+}
+
+bool touch_discovery_is_touch(const char *event_name)
+{
+    char name[TOUCH_NAME_MAX];
+    return score_node(event_name, name, sizeof(name)) > 0;
+}
+
+static bool read_cache(char path[TOUCH_PATH_MAX], char *name, size_t name_len)
+{
+    char text[TOUCH_PATH_MAX + TOUCH_NAME_MAX + 2];
+    FILE *f = fopen(TOUCH_CACHE_FILE, "re");
+    if (f == NULL) {
+        return false;
+    }
+
+    size_t n = fread(text, 1, sizeof(text) - 1, f);
+    fclose(f);
+    text[n] = '\0';
+
+    /* "path\nname\n" */
+    char *sep = strchr(text, '\n');
+    if (sep == NULL || (size_t)(sep - text) >= TOUCH_PATH_MAX) {
+        return false;
+    }
+    *sep = '\0';
+    memcpy(path, text, sep - text + 1);
+    snprintf(name, name_len, "%s", sep + 1);
+    name[strcspn(name, "\n")] = '\0';
+    return path[0] != '\0';
+}
+
+static void write_cache(const char *path, const char *name)
+{
+    char dir[sizeof(TOUCH_CACHE_FILE)];
+    snprintf(dir, sizeof(dir), "%s", TOUCH_CACHE_FILE);
+    char *slash = strrchr(dir, '/');
+    if (slash && slash != dir) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+    }
+
+    FILE *f = fopen(TOUCH_CACHE_FILE, "we");
+    if (f == NULL) {
+        return;
+    }
+    fprintf(f, "%s\n%s\n", path, name);
+    fclose(f);
+}
+
+/* Confirm a cached node still is the same touchscreen: one open, one ioctl */
+static int open_cached(char path[TOUCH_PATH_MAX], char *name, size_t name_len)
+{
+    char cached_name[TOUCH_NAME_MAX];
+    if (!read_cache(path, cached_name, sizeof(cached_name))) {
+        return -1;
+    }
+
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    memset(name, 0, name_len);
+    if (ioctl(fd, EVIOCGNAME(name_len - 1), name) < 0 || strcmp(name, cached_name) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int touch_discovery_open(char path[TOUCH_PATH_MAX])
+{
+    char name[TOUCH_NAME_MAX] = {0};
+
+    int fd = open_cached(path, name, sizeof(name));
+    if (fd >= 0) {
+        LOGI("Touch device from cache: %s (%s)", path, name);
+        return fd;
+    }
+
+    DIR *dir = opendir(SYSFS_INPUT_DIR);
+    if (dir == NULL) {
+        LOGE("Cannot list %s: %s", SYSFS_INPUT_DIR, strerror(errno));
+        return -1;
+    }
+
+    char best[TOUCH_PATH_MAX] = {0};
+    char best_name[TOUCH_NAME_MAX] = {0};
+    int best_score = 0;
+    struct dirent *entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, "event", 5) != 0) {
+            continue;
+        }
+
+        char node_name[TOUCH_NAME_MAX];
+        int score = score_node(entry->d_name, node_name, sizeof(node_name));
+        if (score > best_score) {
+            best_score = score;
+            snprintf(best, sizeof(best), DEV_INPUT_DIR "/%.32s", entry->d_name);
+            snprintf(best_name, sizeof(best_name), "%s", node_name);
+        }
+    }
+    closedir(dir);
+
+    if (best_score == 0) {
+        LOGI("No touch device found in %s", SYSFS_INPUT_DIR);
+        return -1;
+    }
+
+    fd = open(best, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        LOGE("Cannot open %s: %s", best, strerror(errno));
+        return -1;
+    }
+
+    LOGI("Touch device confirmed: %s (%s)", best, best_name);
+    snprintf(path, TOUCH_PATH_MAX, "%s", best);
+    write_cache(best, best_name);
+    return fd;
+}
+
+int touch_hotplug_open(void)
+{
+    struct sockaddr_nl addr = {0};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = 1;                 /* Kernel uevent broadcast */
+
+    int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (fd < 0) {
+        LOGE("Cannot open uevent socket: %s", strerror(errno));
+        return -1;
+    }
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        LOGE("Cannot bind uevent socket: %s", strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int touch_hotplug_read(int fd, char path[TOUCH_PATH_MAX])
+{
+    char buf[4096];
+    struct sockaddr_nl sender;
+    socklen_t sender_len = sizeof(sender);
+    ssize_t len;
+
+    do {
+        len = recvfrom(fd, buf, sizeof(buf) - 1, 0, (struct sockaddr *)&sender, &sender_len);
+    } while (len < 0 && errno == EINTR);
+
+    if (len <= 0) {
+        return -1;
+    }
+    buf[len] = '\0';
+
+    /* Only trust messages from the kernel itself */
+    if (sender.nl_pid != 0) {
+        return TOUCH_HOTPLUG_NONE;
+    }
+
+    /* "action@devpath" followed by NUL separated KEY=value pairs */
+    const char *action = NULL;
+    const char *subsystem = NULL;
+    const char *devname = NULL;
+    for (char *p = buf; p < buf + len; p += strlen(p) + 1) {
+        if (strncmp(p, "ACTION=", 7) == 0) {
+            action = p + 7;
+        } else if (strncmp(p, "SUBSYSTEM=", 10) == 0) {
+            subsystem = p + 10;
+        } else if (strncmp(p, "DEVNAME=", 8) == 0) {
+            devname = p + 8;
+        }
+    }
+
+    if (action == NULL || subsystem == NULL || devname == NULL ||
+        strcmp(subsystem, "input") != 0 || strncmp(devname, "input/event", 11) != 0) {
+        return TOUCH_HOTPLUG_NONE;
+    }
+
+    snprintf(path, TOUCH_PATH_MAX, "/dev/%s", devname);
+    if (strcmp(action, "add") == 0) {
+        return TOUCH_HOTPLUG_ADD;
+    }
+    if (strcmp(action, "remove") == 0) {
+        return TOUCH_HOTPLUG_REMOVE;
+    }
+    return TOUCH_HOTPLUG_NONE;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file touch_discovery.h
+ * @brief Internal touchscreen discovery and hotplug notification
+ * 
+ * Devices are ranked from sysfs (/sys/class/input/eventN/device) without
+ * opening any of them. The chosen node is remembered in a small state
+ * file, so the next start is a single open plus one ioctl to confirm it.
+ * Hotplug comes from the kernel's uevent netlink broadcast.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#ifndef HAL_TOUCH_DISCOVERY_H
+#define HAL_TOUCH_DISCOVERY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Remembers the last touchscreen node across runs */
+#ifndef TOUCH_CACHE_FILE
+#define TOUCH_CACHE_FILE        "/var/lib/hal/touch-device"
+#endif
+
+#define TOUCH_PATH_MAX          64
+
+typedef enum {
+    TOUCH_HOTPLUG_NONE = 0,
+    TOUCH_HOTPLUG_ADD,
+    TOUCH_HOTPLUG_REMOVE
+} touch_hotplug_action_t;
+
+/**
+ * @brief Open the touchscreen, trying the cached node before scanning sysfs
+ * @param path Receives the opened /dev/input/eventN path
+ * @return Non-blocking file descriptor, or -1 if no touchscreen was found
+ */
+int touch_discovery_open(char path[TOUCH_PATH_MAX]);
+
+/**
+ * @brief Check from sysfs whether an event node looks like a touchscreen
+ * @param event_name Node name such as "event1"
+ * @return true if the node reports absolute X/Y axes
+ */
+bool touch_discovery_is_touch(const char *event_name);
+
+/**
+ * @brief Open a socket receiving kernel uevents
+ * @return Non-blocking netlink socket, or -1 on error
+ */
+int touch_hotplug_open(void);
+
+/**
+ * @brief Read one uevent and extract input event node changes
+ * @param fd Socket from touch_hotplug_open()
+ * @param path Receives /dev/input/eventN for add/remove events
+ * @return Action, TOUCH_HOTPLUG_NONE for unrelated messages, -1 when no message is pending
+ */
+int touch_hotplug_read(int fd, char path[TOUCH_PATH_MAX]);
+
+#endif /* HAL_TOUCH_DISCOVERY_H */
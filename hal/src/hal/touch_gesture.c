@@ -0,0 +1,276 @@
+/**
+ * @file touch_gesture.c
+ * @brief Gesture recognizer and position predictor
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#define _GNU_SOURCE
+#include "touch_gesture.h"
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* Recognizer thresholds */
+#define TAP_SLOP_PX             12          /* Movement that turns a press into a drag */
+#define TAP_MAX_MS              250
+#define LONG_PRESS_MS           500
+#define SWIPE_MIN_VELOCITY      600.0f      /* px/s at release */
+#define VELOCITY_SMOOTHING      0.5f        /* Weight of the newest sample */
+
+/* Kalman tuning: acceleration noise (px^2/s^3) and measurement noise (px^2) */
+#define KALMAN_Q                50000.0f
+#define KALMAN_R                4.0f
+
+static uint32_t mono_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000u + ts.tv_nsec / 1000000);
+}
+
+static void emit(touch_gesture_t *g, hal_gesture_type_t type, uint32_t timestamp)
+{
+    /* Overwrite the oldest entry so a stalled reader still gets recent gestures */
+    if (g->head - g->tail == TOUCH_GESTURE_QUEUE) {
+        g->tail++;
+    }
+
+    hal_gesture_t *ev = &g->queue[g->head++ % TOUCH_GESTURE_QUEUE];
+    memset(ev, 0, sizeof(*ev));
+    ev->type = type;
+    ev->x = g->x;
+    ev->y = g->y;
+    ev->dx = (int16_t)(g->x - g->start_x);
+    ev->dy = (int16_t)(g->y - g->start_y);
+    ev->vx = g->vx;
+    ev->vy = g->vy;
+    ev->scale = 1.0f;
+    ev->timestamp = timestamp;
+    bool pinch = (type == HAL_GESTURE_PINCH || type == HAL_GESTURE_PINCH_END);
+    if (pinch || !touch_gesture_predict(g, &ev->px, &ev->py)) {
+        ev->px = g->x;
+        ev->py = g->y;
+    }
+}
+
+static void kalman_reset(touch_kalman_t *k, float z)
+{
+    k->p = z;
+    k->v = 0.0f;
+    k->P[0][0] = KALMAN_R;
+    k->P[0][1] = 0.0f;
+    k->P[1][0] = 0.0f;
+    k->P[1][1] = 1e6f;      /* Velocity unknown after a press */
+}
+
+static void kalman_update(touch_kalman_t *k, float z, float dt)
+{
+    /* Predict: p += v * dt, P = F P F' + Q */
+    float dt2 = dt * dt;
+    k->p += k->v * dt;
+    float p00 = k->P[0][0] + dt * (k->P[1][0] + k->P[0][1]) + dt2 * k->P[1][1] + KALMAN_Q * dt2 * dt / 3.0f;
+    float p01 = k->P[0][1] + dt * k->P[1][1] + KALMAN_Q * dt2 / 2.0f;
+    float p10 = k->P[1][0] + dt * k->P[1][1] + KALMAN_Q * dt2 / 2.0f;
+    float p11 = k->P[1][1] + KALMAN_Q * dt;
+
+    /* Correct with the measured position */
+    float s = p00 + KALMAN_R;
+    float k0 = p00 / s;
+    float k1 = p10 / s;
+    float y = z - k->p;
+    k->p += k0 * y;
+    k->v += k1 * y;
+    k->P[0][0] = (1.0f - k0) * p00;
+    k->P[0][1] = (1.0f - k0) * p01;
+    k->P[1][0] = p10 - k1 * p00;
+    k->P[1][1] = p11 - k1 * p01;
+}
+
+static float contact_distance(const hal_touch_data_t *frame, int *centroid_x, int *centroid_y)
+{
+    const hal_touch_point_t *a = NULL, *b = NULL;
+    for (int i = 0; i < HAL_TOUCH_MAX_POINTS && b == NULL; i++) {
+        if (frame->points[i].valid) {
+            if (a == NULL) {
+                a = &frame->points[i];
+            } else {
+                b = &frame->points[i];
+            }
+        }
+    }
+    if (b == NULL) {
+        return 0.0f;
+    }
+
+    *centroid_x = (a->x + b->x) / 2;
+    *centroid_y = (a->y + b->y) / 2;
+    float dx = (float)a->x - b->x;
+    float dy = (float)a->y - b->y;
+    return sqrtf(dx * dx + dy * dy);
+}
+
+void touch_gesture_init(touch_gesture_t *g)
+{
+    hal_touch_predict_t predict = g->predict;
+    uint32_t lead_ms = g->lead_ms;
+
+    memset(g, 0, sizeof(*g));
+    g->slot = -1;
+    g->predict = predict;
+    g->lead_ms = lead_ms;
+}
+
+static void begin_contact(touch_gesture_t *g, int slot, const hal_touch_data_t *frame)
+{
+    const hal_touch_point_t *p = &frame->points[slot];
+
+    g->state = GESTURE_PENDING;
+    g->slot = slot;
+    g->start_x = g->x = p->x;
+    g->start_y = g->y = p->y;
+    g->start_ms = g->last_ms = frame->timestamp;
+    g->press_mono_ms = mono_ms();
+    g->vx = g->vy = 0.0f;
+    kalman_reset(&g->kx, p->x);
+    kalman_reset(&g->ky, p->y);
+}
+
+static void track_contact(touch_gesture_t *g, const hal_touch_point_t *p, uint32_t timestamp)
+{
+    uint32_t dt_ms = timestamp - g->last_ms;
+    if (dt_ms > 0) {
+        float dt = dt_ms / 1000.0f;
+        float vx = ((float)p->x - g->x) / dt;
+        float vy = ((float)p->y - g->y) / dt;
+        g->vx += VELOCITY_SMOOTHING * (vx - g->vx);
+        g->vy += VELOCITY_SMOOTHING * (vy - g->vy);
+        kalman_update(&g->kx, p->x, dt);
+        kalman_update(&g->ky, p->y, dt);
+    }
+
+    g->x = p->x;
+    g->y = p->y;
+    g->last_ms = timestamp;
+}
+
+void touch_gesture_feed(touch_gesture_t *g, const hal_touch_data_t *frame)
+{
+    if (frame->count == 0) {
+        /* Lift: taps and swipes are decided here */
+        if (g->state == GESTURE_PENDING && frame->timestamp - g->start_ms <= TAP_MAX_MS) {
+            emit(g, HAL_GESTURE_TAP, frame->timestamp);
+        } else if (g->state == GESTURE_DRAGGING) {
+            float speed = sqrtf(g->vx * g->vx + g->vy * g->vy);
+            emit(g, speed >= SWIPE_MIN_VELOCITY ? HAL_GESTURE_SWIPE : HAL_GESTURE_DRAG_END, frame->timestamp);
+        } else if (g->state == GESTURE_PINCHING) {
+            emit(g, HAL_GESTURE_PINCH_END, frame->timestamp);
+        }
+        g->state = GESTURE_IDLE;
+        g->slot = -1;
+        return;
+    }
+
+    if (frame->count >= 2) {
+        int cx = 0, cy = 0;
+        float distance = contact_distance(frame, &cx, &cy);
+
+        if (g->state == GESTURE_DRAGGING) {
+            emit(g, HAL_GESTURE_DRAG_END, frame->timestamp);
+        }
+        if (g->state != GESTURE_PINCHING && g->state != GESTURE_DONE) {
+            g->state = GESTURE_PINCHING;
+            g->pinch_start = distance > 1.0f ? distance : 1.0f;
+        }
+        if (g->state == GESTURE_PINCHING) {
+            g->x = (uint16_t)cx;
+            g->y = (uint16_t)cy;
+            emit(g, HAL_GESTURE_PINCH, frame->timestamp);
+            g->queue[(g->head - 1) % TOUCH_GESTURE_QUEUE].scale = distance / g->pinch_start;
+        }
+        return;
+    }
+
+    /* One contact left after a pinch: wait for a clean lift */
+    if (g->state == GESTURE_PINCHING) {
+        emit(g, HAL_GESTURE_PINCH_END, frame->timestamp);
+        g->state = GESTURE_DONE;
+    }
+    if (g->state == GESTURE_DONE) {
+        return;
+    }
+
+    int slot = g->slot;
+    if (g->state == GESTURE_IDLE || slot < 0 || !frame->points[slot].valid) {
+        for (slot = 0; slot < HAL_TOUCH_MAX_POINTS && !frame->points[slot].valid; slot++) {
+        }
+        begin_contact(g, slot, frame);
+        return;
+    }
+
+    track_contact(g, &frame->points[slot], frame->timestamp);
+
+    int dx = (int)g->x - g->start_x;
+    int dy = (int)g->y - g->start_y;
+    bool moved = dx * dx + dy * dy > TAP_SLOP_PX * TAP_SLOP_PX;
+
+    if (g->state == GESTURE_PENDING && moved) {
+        g->state = GESTURE_DRAGGING;
+    } else if (g->state == GESTURE_PENDING && frame->timestamp - g->start_ms >= LONG_PRESS_MS) {
+        emit(g, HAL_GESTURE_LONG_PRESS, frame->timestamp);
+        g->state = GESTURE_LONG;
+    }
+
+    if (g->state == GESTURE_DRAGGING) {
+        emit(g, HAL_GESTURE_DRAG, frame->timestamp);
+    }
+}
+
+int touch_gesture_pop(touch_gesture_t *g, hal_gesture_t *out, int max)
+{
+    /* A finger held still may stop producing frames, so time long presses here too */
+    if (g->state == GESTURE_PENDING && mono_ms() - g->press_mono_ms >= LONG_PRESS_MS) {
+        emit(g, HAL_GESTURE_LONG_PRESS, g->start_ms + LONG_PRESS_MS);
+        g->state = GESTURE_LONG;
+    }
+
+    int count = 0;
+    while (count < max && g->tail != g->head) {
+        out[count++] = g->queue[g->tail++ % TOUCH_GESTURE_QUEUE];
+    }
+    return count;
+}
+
+bool touch_gesture_predict(const touch_gesture_t *g, uint16_t *x, uint16_t *y)
+{
+    if (g->slot < 0 || g->state == GESTURE_IDLE) {
+        return false;
+    }
+
+    float lead = g->lead_ms / 1000.0f;
+    float px, py;
+
+    switch (g->predict) {
+        case HAL_TOUCH_PREDICT_LINEAR:
+            px = g->x + g->vx * lead;
+            py = g->y + g->vy * lead;
+            break;
+
+        case HAL_TOUCH_PREDICT_KALMAN:
+            px = g->kx.p + g->kx.v * lead;
+            py = g->ky.p + g->ky.v * lead;
+            break;
+
+        default:
+            px = g->x;
+            py = g->y;
+            break;
+    }
+
+    px = fminf(fmaxf(px, 0.0f), HAL_TOUCH_WIDTH - 1);
+    py = fminf(fmaxf(py, 0.0f), HAL_TOUCH_HEIGHT - 1);
+    *x = (uint16_t)(px + 0.5f);
+    *y = (uint16_t)(py + 0.5f);
+    return true;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file touch_gesture.h
+ * @brief Internal gesture recognizer and position predictor
+ * 
+ * Fed with every decoded touch frame, in order. Single-contact frames
+ * drive tap, long-press, drag and swipe detection, two contacts drive
+ * pinch. The primary contact also runs through a linear or Kalman
+ * (constant velocity) predictor so drag-follow UIs can draw where the
+ * finger will be when the frame reaches the panel.
+ * 
+ * @author Huy Nguyen
+ * @date August 2025
+ */
+
+#ifndef HAL_TOUCH_GESTURE_H
+#define HAL_TOUCH_GESTURE_H
+
+#include "../../include/hal.h"
+
+#define TOUCH_GESTURE_QUEUE     32          /* Pending gestures, oldest dropped when full */
+
+typedef enum {
+    GESTURE_IDLE = 0,
+    GESTURE_PENDING,            /* Finger down, not moved past the slop yet */
+    GESTURE_LONG,               /* Long press reported, waiting for release */
+    GESTURE_DRAGGING,
+    GESTURE_PINCHING,
+    GESTURE_DONE                /* Multi-touch ended, ignore until all fingers lift */
+} touch_gesture_state_t;
+
+/* Constant-velocity Kalman filter for one axis */
+typedef struct {
+    float p;                    /* Position, px */
+    float v;                    /* Velocity, px/s */
+    float P[2][2];              /* Covariance */
+} touch_kalman_t;
+
+typedef struct {
+    touch_gesture_state_t state;
+    int slot;                   /* Primary contact */
+    uint16_t start_x, start_y;
+    uint16_t x, y;              /* Last primary position */
+    uint32_t start_ms;          /* Frame timestamps */
+    uint32_t last_ms;
+    uint32_t press_mono_ms;     /* Monotonic press time for long-press without new frames */
+    float vx, vy;               /* Smoothed velocity, px/s */
+    float pinch_start;          /* Finger distance when the pinch started */
+
+    hal_touch_predict_t predict;
+    uint32_t lead_ms;
+    touch_kalman_t kx, ky;
+
+    hal_gesture_t queue[TOUCH_GESTURE_QUEUE];
+    uint32_t head;
+    uint32_t tail;
+} touch_gesture_t;
+
+void touch_gesture_init(touch_gesture_t *g);
+void touch_gesture_feed(touch_gesture_t *g, const hal_touch_data_t *frame);
+int touch_gesture_pop(touch_gesture_t *g, hal_gesture_t *out, int max);
+bool touch_gesture_predict(const touch_gesture_t *g, uint16_t *x, uint16_t *y);
+
+#endif /* HAL_TOUCH_GESTURE_H */
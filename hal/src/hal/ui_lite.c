@@ -1,10 +1,146 @@
+#include <stdlib.h>
 #include <string.h>
 #include "../include/hal.h"
 #include "../include/hal_ui.h"
+#include "font.h"
 
 static int s_enabled = 0;
 
+// Retained scene, one compact entry per widget
+enum { W_FREE = 0, W_BAR, W_GAUGE, W_SPARK, W_LABEL };
+
+typedef struct {
+    uint8_t type;
+    uint8_t warn, alarm;        // gauge zone thresholds
+    uint8_t font;               // label font
+    int16_t x, y, w, h;
+    int16_t len;                // bar/gauge: painted length, sparkline: last sample row, label: chars
+    int16_t col;                // sparkline: next column
+    uint32_t fg, bg;            // gauge: fg is the zone color last painted
+} ui_widget_t;
+
+static ui_widget_t s_widgets[HAL_UI_MAX_WIDGETS];
+static char s_label_text[HAL_UI_MAX_WIDGETS][HAL_UI_LABEL_MAX + 1];   // what each label shows
+static uint32_t s_painted = 0;  // pixels since the last hal_ui_render()
+static int s_bar3[3] = {-1, -1, -1};
+
+// Colored string runs, ARGB8888 straight alpha, least recently used is recycled
+#define UI_RUN_CACHE 8
+
+typedef struct {
+    const font_t *font;
+    uint32_t color;
+    char text[HAL_UI_TEXT_MAX + 1];
+    uint32_t *pixels;           // len * cell_w wide, cell_h tall
+    int cap;                    // pixels allocated
+    uint32_t used;              // LRU stamp, 0 = empty
+} ui_run_t;
+
+static ui_run_t s_runs[UI_RUN_CACHE];
+static uint32_t s_run_clock = 0;
+
+static const font_t *get_font(hal_ui_font_t font) {
+    if (font == HAL_UI_FONT_SMALL) return &font_small;
+    if (font == HAL_UI_FONT_LARGE) return &font_large;
+    return NULL;
+}
+
+static void paint(int x, int y, int w, int h, uint32_t color) {
+    if (w <= 0 || h <= 0) return;
+    hal_ui_fill_rect(x, y, w, h, color);
+}
+
+static int clamp100(int v) { return (v < 0) ? 0 : (v > 100) ? 100 : v; }
+
+static uint32_t gauge_color(const ui_widget_t *g, int v) {
+    if (v >= g->alarm) return 0xFF3030;
+    if (v >= g->warn) return 0xFFB000;
+    return 0x30D040;
+}
+
+static int add_widget(uint8_t type, int x, int y, int w, int h, uint32_t fg, uint32_t bg) {
+    if (!s_enabled || w <= 0 || h <= 0) return -1;
+    for (int i = 0; i < HAL_UI_MAX_WIDGETS; i++) {
+        if (s_widgets[i].type != W_FREE) continue;
+        ui_widget_t *wd = &s_widgets[i];
+        memset(wd, 0, sizeof(*wd));
+        wd->type = type;
+        wd->x = x; wd->y = y; wd->w = w; wd->h = h;
+        wd->fg = fg; wd->bg = bg;
+        wd->len = (type == W_SPARK) ? h - 1 : 0;
+        paint(x, y, w, h, bg);
+        return i;
+    }
+    return -1;
+}
+
+// Expand the atlas cells of text into one colored run, or reuse the cached one
+static const ui_run_t *get_run(const font_t *f, uint32_t color, const char *text) {
+    char key[HAL_UI_TEXT_MAX + 1];
+    strncpy(key, text, HAL_UI_TEXT_MAX);
+    key[HAL_UI_TEXT_MAX] = 0;
+    color &= 0xFFFFFF;
+
+    ui_run_t *run = &s_runs[0];
+    for (int i = 0; i < UI_RUN_CACHE; i++) {
+        ui_run_t *r = &s_runs[i];
+        if (r->used && r->font == f && r->color == color && strcmp(r->text, key) == 0) {
+            r->used = ++s_run_clock;
+            return r;
+        }
+        if (r->used < run->used) run = r;
+    }
+
+    int len = (int)strlen(key);
+    int stride = len * f->cell_w;
+    int need = stride * f->cell_h;
+    if (need > run->cap) {
+        uint32_t *px = realloc(run->pixels, (size_t)need * sizeof(uint32_t));
+        if (!px) return NULL;
+        run->pixels = px;
+        run->cap = need;
+    }
+
+    // Coverage nibble n becomes alpha n * 17 over the text color
+    int rb = font_row_bytes(f);
+    for (int c = 0; c < len; c++) {
+        const uint8_t *g = font_glyph(f, key[c]);
+        for (int y = 0; y < f->cell_h; y++) {
+            uint32_t *dst = run->pixels + y * stride + c * f->cell_w;
+            for (int x = 0; x < f->cell_w; x++) {
+                int n = g ? (g[y * rb + x / 2] >> ((x & 1) * 4)) & 0x0F : 0;
+                dst[x] = ((uint32_t)(n * 17) << 24) | color;
+            }
+        }
+    }
+
+    run->font = f;
+    run->color = color;
+    memcpy(run->text, key, (size_t)len + 1);
+    run->used = ++s_run_clock;
+    return run;
+}
+
+// Blend chars [first, first + count) of a run at x, y
+static void blend_run(const ui_run_t *run, int first, int count, int x, int y) {
+    const font_t *f = run->font;
+    int stride = (int)strlen(run->text) * f->cell_w;
+    if (count <= 0) return;
+    hal_lcd_rect_t rect = { .x = x, .y = y, .width = count * f->cell_w, .height = f->cell_h };
+    hal_lcd_blend_rect(rect, run->pixels + first * f->cell_w, (uint32_t)stride * sizeof(uint32_t));
+    s_painted += (uint32_t)(rect.width * rect.height);
+}
+
+static void free_runs(void) {
+    for (int i = 0; i < UI_RUN_CACHE; i++) free(s_runs[i].pixels);
+    memset(s_runs, 0, sizeof(s_runs));
+    s_run_clock = 0;
+}
+
 int hal_ui_init(const char *card) {
+    // Dashboards redraw mostly unchanged frames, let the shadow flush only the delta.
+    // Widgets repaint only their changed strip: without a shadow lcd keeps one buffer.
+    hal_lcd_set_shadow(true);
     if (hal_lcd_init() < 0) {
         s_enabled = 0;
         return -1;
@@ -18,6 +154,8 @@ void hal_ui_shutdown(void) {
         hal_lcd_shutdown();
         s_enabled = 0;
     }
+    hal_ui_reset_widgets();
+    free_runs();
 }
 
 int hal_ui_info(hal_ui_info_t *out) {
@@ -41,46 +179,198 @@ int hal_ui_info(hal_ui_info_t *out) {
 void hal_ui_clear(uint32_t color) {
     if (!s_enabled) return;
     hal_lcd_clear(color);
+    hal_ui_info_t info;
+    if (hal_ui_info(&info) == 0) s_painted += (uint32_t)(info.w * info.h);
 }
 
+// Immediate draws count too, so hal_ui_render() presents them
 void hal_ui_fill_rect(int x, int y, int w, int h, uint32_t color) {
-    if (!s_enabled) return;
+    if (!s_enabled || w <= 0 || h <= 0) return;
     hal_lcd_rect_t rect = { .x = x, .y = y, .width = w, .height = h };
     hal_lcd_draw_rectangle(rect, color, true);
+    s_painted += (uint32_t)(w * h);
 }
 
-int hal_ui_bar3(int cpu, int mem, int temp) {
-    if (!s_enabled) return -1;
+int hal_ui_add_bar(int x, int y, int w, int h, uint32_t fg, uint32_t bg) {
+    return add_widget(W_BAR, x, y, w, h, fg, bg);
+}
+
+int hal_ui_add_gauge(int x, int y, int w, int h, int warn, int alarm, uint32_t bg) {
+    int id = add_widget(W_GAUGE, x, y, w, h, 0, bg);
+    if (id >= 0) {
+        s_widgets[id].warn = (uint8_t)clamp100(warn);
+        s_widgets[id].alarm = (uint8_t)clamp100(alarm);
+    }
+    return id;
+}
 
-    // Normalize values to 0-100 range
-    cpu = (cpu < 0) ? 0 : (cpu > 100) ? 100 : cpu;
-    mem = (mem < 0) ? 0 : (mem > 100) ? 100 : mem;
-    temp = (temp < 0) ? 0 : (temp > 100) ? 100 : temp;
+int hal_ui_add_sparkline(int x, int y, int w, int h, uint32_t fg, uint32_t bg) {
+    return add_widget(W_SPARK, x, y, w, h, fg, bg);
+}
 
-    hal_ui_info_t info;
-    if (hal_ui_info(&info) < 0) {
-        return -1; // UI not initialized
+int hal_ui_text(int x, int y, hal_ui_font_t font, uint32_t color, const char *text) {
+    const font_t *f = get_font(font);
+    if (!s_enabled || !f || !text) return -1;
+    const ui_run_t *run = get_run(f, color, text);
+    if (!run) return -1;
+    int len = (int)strlen(run->text);
+    blend_run(run, 0, len, x, y);
+    return len * f->cell_w;
+}
+
+int hal_ui_text_size(hal_ui_font_t font, const char *text, int *w, int *h) {
+    const font_t *f = get_font(font);
+    if (!f || !text) return -1;
+    size_t len = strlen(text);
+    if (len > HAL_UI_TEXT_MAX) len = HAL_UI_TEXT_MAX;
+    if (w) *w = (int)len * f->cell_w;
+    if (h) *h = f->cell_h;
+    return 0;
+}
+
+int hal_ui_add_label(int x, int y, int chars, hal_ui_font_t font, uint32_t fg, uint32_t bg) {
+    const font_t *f = get_font(font);
+    if (!f || chars <= 0 || chars > HAL_UI_LABEL_MAX) return -1;
+    int id = add_widget(W_LABEL, x, y, chars * f->cell_w, f->cell_h, fg, bg);
+    if (id >= 0) {
+        s_widgets[id].font = (uint8_t)font;
+        s_widgets[id].len = chars;
+        memset(s_label_text[id], ' ', chars);
+        s_label_text[id][chars] = 0;
     }
+    return id;
+}
+
+int hal_ui_set_text(int id, const char *text) {
+    if (!s_enabled || id < 0 || id >= HAL_UI_MAX_WIDGETS || s_widgets[id].type != W_LABEL || !text) return -1;
+    ui_widget_t *wd = &s_widgets[id];
+    const font_t *f = get_font((hal_ui_font_t)wd->font);
+    char *shown = s_label_text[id];
 
-    int W = info.w;
-    int H = info.h;
-    int bars = 3;
-    int bh = H / (bars + 1);
-    int gap = bh / 2;
-    hal_ui_clear(0x101010); // Clear with dark gray
+    // Pad or cut to the field width so every cell has a defined character
+    char next[HAL_UI_LABEL_MAX + 1];
+    const char *nul = memchr(text, 0, (size_t)wd->len);
+    int n = nul ? (int)(nul - text) : wd->len;
+    memcpy(next, text, (size_t)n);
+    memset(next + n, ' ', (size_t)(wd->len - n));
+    next[wd->len] = 0;
+    if (strcmp(next, shown) == 0) return 0;
 
-    struct {int v; uint32_t c;} B[3] = {
-        {cpu, 0xFF0000}, // Red for CPU
-        {mem, 0x00FF00}, // Green for Memory
-        {temp, 0x0000FF} // Blue for Temperature
-    };
+    const ui_run_t *run = get_run(f, wd->fg, next);
+    if (!run) return -1;
 
-    for (int i = 0; i < bars; i++) {
-        int bar_height = (B[i].v * bh) / 100;
-        int y = H - (i + 1) * bh + gap;
-        hal_ui_fill_rect(0, y, W * B[i].v / 100, bar_height, B[i].c);
+    // Repaint each run of changed cells: background, then the new glyphs from the cached string
+    for (int c = 0; c < wd->len;) {
+        if (next[c] == shown[c]) { c++; continue; }
+        int first = c;
+        while (c < wd->len && next[c] != shown[c]) c++;
+        int x = wd->x + first * f->cell_w;
+        paint(x, wd->y, (c - first) * f->cell_w, f->cell_h, wd->bg);
+        int end = c;
+        while (end > first && next[end - 1] == ' ') end--;   // nothing to blend for trailing blanks
+        blend_run(run, first, end - first, x, wd->y);
+    }
+    memcpy(shown, next, (size_t)wd->len + 1);
+    return 0;
+}
+
+int hal_ui_set_value(int id, int value) {
+    if (!s_enabled || id < 0 || id >= HAL_UI_MAX_WIDGETS || s_widgets[id].type == W_FREE
+        || s_widgets[id].type == W_LABEL) return -1;
+    ui_widget_t *wd = &s_widgets[id];
+    int v = clamp100(value);
+
+    switch (wd->type) {
+    case W_BAR: {
+        // Only the strip between the old and new end changes
+        int len = wd->w * v / 100;
+        if (len > wd->len) paint(wd->x + wd->len, wd->y, len - wd->len, wd->h, wd->fg);
+        else paint(wd->x + len, wd->y, wd->len - len, wd->h, wd->bg);
+        wd->len = len;
+        break;
+    }
+    case W_GAUGE: {
+        // Fills from the bottom, a zone change recolors the filled part
+        int len = wd->h * v / 100;
+        uint32_t color = gauge_color(wd, v);
+        int bottom = wd->y + wd->h;
+        if (color != wd->fg && len > 0) {
+            int keep = (len < wd->len) ? len : wd->len;
+            paint(wd->x, bottom - keep, wd->w, keep, color);
+            wd->fg = color;
+        }
+        if (len > wd->len) paint(wd->x, bottom - len, wd->w, len - wd->len, color);
+        else paint(wd->x, bottom - wd->len, wd->w, wd->len - len, wd->bg);
+        wd->len = len;
+        break;
+    }
+    case W_SPARK: {
+        // One column per sample: clear it, draw the step from the previous row, blank the next as cursor
+        int row = (wd->h - 1) - (wd->h - 1) * v / 100;
+        int top = (row < wd->len) ? row : wd->len;
+        int bot = (row < wd->len) ? wd->len : row;
+        int x = wd->x + wd->col;
+        if (wd->col == 0) top = bot = row;   // no step across the wrap
+        paint(x, wd->y, 1, top, wd->bg);
+        paint(x, wd->y + top, 1, bot - top + 1, wd->fg);
+        paint(x, wd->y + bot + 1, 1, wd->h - bot - 1, wd->bg);
+        wd->col = (wd->col + 1 < wd->w) ? wd->col + 1 : 0;
+        paint(wd->x + wd->col, wd->y, 1, wd->h, wd->bg);
+        wd->len = row;
+        break;
     }
-    hal_lcd_swap();
+    }
+    return 0;
+}
+
+int hal_ui_render(void) {
+    if (!s_enabled) return -1;
+    int painted = (int)s_painted;
+    if (s_painted) {
+        hal_lcd_swap();
+        s_painted = 0;
+    }
+    return painted;
+}
+
+void hal_ui_reset_widgets(void) {
+    memset(s_widgets, 0, sizeof(s_widgets));
+    memset(s_label_text, 0, sizeof(s_label_text));
+    s_bar3[0] = s_bar3[1] = s_bar3[2] = -1;
+}
+
+int hal_ui_bar3(int cpu, int mem, int temp) {
+    if (!s_enabled) return -1;
+
+    // Build the scene once, later calls only repaint value changes
+    if (s_bar3[0] < 0) {
+        hal_ui_info_t info;
+        if (hal_ui_info(&info) < 0) {
+            return -1; // UI not initialized
+        }
+
+        int W = info.w;
+        int H = info.h;
+        int bars = 3;
+        int bh = H / (bars + 1);
+        int gap = bh / 2;
+        const uint32_t colors[3] = {
+            0xFF0000, // Red for CPU
+            0x00FF00, // Green for Memory
+            0x0000FF  // Blue for Temperature
+        };
+
+        hal_ui_clear(0x101010); // Clear with dark gray
+        for (int i = 0; i < bars; i++) {
+            int y = H - (i + 1) * bh + gap;
+            s_bar3[i] = hal_ui_add_bar(0, y, W, bh - gap, colors[i], 0x101010);
+        }
+    }
+
+    hal_ui_set_value(s_bar3[0], cpu);
+    hal_ui_set_value(s_bar3[1], mem);
+    hal_ui_set_value(s_bar3[2], temp);
+    hal_ui_render();
 
     return 0; // success
 }
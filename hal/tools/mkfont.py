@@ -0,0 +1,294 @@
+#!/usr/bin/env python3
+"""
+mkfont.py - generate the ui_lite glyph atlas (src/hal/font_data.c)
+
+Rasterizes a monospace TrueType font into fixed-size cells with 4 bits of
+anti-aliased coverage per pixel, so the target never runs a rasterizer.
+Only the standard library is used: simple and composite glyf outlines,
+quadratic curves flattened to lines, 16x16 supersampled non-zero fill.
+
+Usage: tools/mkfont.py [font.ttf] > src/hal/font_data.c
+Default font: DejaVu Sans Mono (Bitstream Vera license, bitmaps may be embedded).
+
+Author: Huy Nguyen, August 2025
+"""
+
+import struct
+import sys
+
+DEFAULT_FONT = "/usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf"
+
+# name, em size in pixels, charset (atlas order)
+FONTS = [
+    ("small", 16, "".join(chr(c) for c in range(32, 127))),
+    ("large", 32, " %+,-./0123456789:ACFVW"),
+]
+
+SUB = 16  # supersampling per axis
+
+
+class TrueType:
+    def __init__(self, data):
+        self.data = data
+        num = struct.unpack_from(">H", data, 4)[0]
+        self.tables = {}
+        for i in range(num):
+            tag, _, off, length = struct.unpack_from(">4sIII", data, 12 + 16 * i)
+            self.tables[tag.decode("latin-1")] = (off, length)
+
+        head = self.tables["head"][0]
+        self.units_per_em = struct.unpack_from(">H", data, head + 18)[0]
+        self.loca_long = struct.unpack_from(">h", data, head + 50)[0] == 1
+
+        hhea = self.tables["hhea"][0]
+        self.ascender, self.descender = struct.unpack_from(">hh", data, hhea + 4)
+        self.num_hmetrics = struct.unpack_from(">H", data, hhea + 34)[0]
+        self.num_glyphs = struct.unpack_from(">H", data, self.tables["maxp"][0] + 4)[0]
+        self.cmap = self._read_cmap()
+
+    def _read_cmap(self):
+        base = self.tables["cmap"][0]
+        count = struct.unpack_from(">H", self.data, base + 2)[0]
+        for i in range(count):
+            plat, enc, off = struct.unpack_from(">HHI", self.data, base + 4 + 8 * i)
+            sub = base + off
+            if plat == 3 and enc == 1 and struct.unpack_from(">H", self.data, sub)[0] == 4:
+                return self._read_format4(sub)
+        raise ValueError("no unicode BMP cmap")
+
+    def _read_format4(self, sub):
+        d = self.data
+        segs = struct.unpack_from(">H", d, sub + 6)[0] // 2
+        ends = struct.unpack_from(">%dH" % segs, d, sub + 14)
+        starts = struct.unpack_from(">%dH" % segs, d, sub + 16 + 2 * segs)
+        deltas = struct.unpack_from(">%dh" % segs, d, sub + 16 + 4 * segs)
+        range_base = sub + 16 + 6 * segs
+        ranges = struct.unpack_from(">%dH" % segs, d, range_base)
+        cmap = {}
+        for s in range(segs):
+            for c in range(starts[s], min(ends[s], 0x7F) + 1):
+                if ranges[s] == 0:
+                    g = (c + deltas[s]) & 0xFFFF
+                else:
+                    addr = range_base + 2 * s + ranges[s] + 2 * (c - starts[s])
+                    g = struct.unpack_from(">H", d, addr)[0]
+                    if g:
+                        g = (g + deltas[s]) & 0xFFFF
+                cmap[c] = g
+        return cmap
+
+    def advance(self, glyph):
+        hmtx = self.tables["hmtx"][0]
+        index = min(glyph, self.num_hmetrics - 1)
+        return struct.unpack_from(">H", self.data, hmtx + 4 * index)[0]
+
+    def _glyph_range(self, glyph):
+        loca = self.tables["loca"][0]
+        if self.loca_long:
+            a, b = struct.unpack_from(">II", self.data, loca + 4 * glyph)
+        else:
+            a, b = (2 * v for v in struct.unpack_from(">HH", self.data, loca + 2 * glyph))
+        return self.tables["glyf"][0] + a, b - a
+
+    def contours(self, glyph, dx=0, dy=0):
+        """List of contours, each a list of (x, y, on_curve) in font units."""
+        off, length = self._glyph_range(glyph)
+        if length == 0:
+            return []
+        d = self.data
+        ncont = struct.unpack_from(">h", d, off)[0]
+        p = off + 10
+        if ncont < 0:
+            return self._composite(p, dx, dy)
+
+        ends = struct.unpack_from(">%dH" % ncont, d, p)
+        p += 2 * ncont
+        p += 2 + struct.unpack_from(">H", d, p)[0]  # skip instructions
+        npts = ends[-1] + 1 if ncont else 0
+
+        flags = []
+        while len(flags) < npts:
+            f = d[p]
+            p += 1
+            flags.append(f)
+            if f & 8:
+                flags.extend([f] * d[p])
+                p += 1
+
+        def coords(short_bit, same_bit):
+            nonlocal p
+            vals, v = [], 0
+            for f in flags:
+                if f & short_bit:
+                    delta = d[p]
+                    p += 1
+                    v += delta if f & same_bit else -delta
+                elif not f & same_bit:
+                    v += struct.unpack_from(">h", d, p)[0]
+                    p += 2
+                vals.append(v)
+            return vals
+
+        xs = coords(2, 16)
+        ys = coords(4, 32)
+        result, start = [], 0
+        for end in ends:
+            result.append([(xs[i] + dx, ys[i] + dy, flags[i] & 1) for i in range(start, end + 1)])
+            start = end + 1
+        return result
+
+    def _composite(self, p, dx, dy):
+        d = self.data
+        result = []
+        while True:
+            flags, glyph = struct.unpack_from(">HH", d, p)
+            p += 4
+            if flags & 1:
+                ax, ay = struct.unpack_from(">hh", d, p)
+                p += 4
+            else:
+                ax, ay = struct.unpack_from(">bb", d, p)
+                p += 2
+            if flags & 8:
+                p += 2
+            elif flags & 0x40:
+                p += 4
+            elif flags & 0x80:
+                p += 8
+            result.extend(self.contours(glyph, dx + ax, dy + ay))
+            if not flags & 0x20:
+                return result
+
+
+def flatten(contour, steps=8):
+    """Quadratic TrueType contour to a closed polyline."""
+    n = len(contour)
+    first = next((i for i in range(n) if contour[i][2]), None)
+    if first is None:  # all off-curve: start at an implied midpoint
+        a, b = contour[0], contour[1]
+        contour = [((a[0] + b[0]) / 2, (a[1] + b[1]) / 2, 1)] + contour[1:] + contour[:1]
+        first = 0
+    pts = contour[first:] + contour[:first]
+    out = [(pts[0][0], pts[0][1])]
+    ctrl = None
+    for x, y, on in pts[1:] + pts[:1]:
+        if on:
+            if ctrl is None:
+                out.append((x, y))
+            else:
+                out.extend(curve(out[-1], ctrl, (x, y), steps))
+                ctrl = None
+        else:
+            if ctrl is not None:
+                mid = ((ctrl[0] + x) / 2, (ctrl[1] + y) / 2)
+                out.extend(curve(out[-1], ctrl, mid, steps))
+            ctrl = (x, y)
+    return out
+
+
+def curve(p0, p1, p2, steps):
+    pts = []
+    for i in range(1, steps + 1):
+        t = i / steps
+        u = 1 - t
+        pts.append((u * u * p0[0] + 2 * u * t * p1[0] + t * t * p2[0],
+                    u * u * p0[1] + 2 * u * t * p1[1] + t * t * p2[1]))
+    return pts
+
+
+def rasterize(polys, width, height):
+    """Coverage 0..255 per pixel, non-zero winding, polys in pixel space (y down)."""
+    edges = []
+    for poly in polys:
+        for i in range(len(poly)):
+            (x0, y0), (x1, y1) = poly[i], poly[(i + 1) % len(poly)]
+            if y0 != y1:
+                edges.append((x0, y0, x1, y1, 1 if y1 > y0 else -1))
+
+    cover = [[0] * (width * SUB) for _ in range(height)]
+    for sy in range(height * SUB):
+        y = (sy + 0.5) / SUB
+        hits = []
+        for x0, y0, x1, y1, w in edges:
+            lo, hi = (y0, y1) if y0 < y1 else (y1, y0)
+            if lo <= y < hi:
+                hits.append((x0 + (y - y0) * (x1 - x0) / (y1 - y0), w))
+        hits.sort()
+        winding = 0
+        row = cover[sy // SUB]
+        for i, (x, w) in enumerate(hits):
+            prev = winding
+            winding += w
+            if prev == 0 and winding != 0:
+                start = x
+            elif prev != 0 and winding == 0:
+                a = max(0, int(start * SUB + 0.5))
+                b = min(width * SUB, int(x * SUB + 0.5))
+                for sx in range(a, b):
+                    row[sx] += 1
+
+    alpha = []
+    for py in range(height):
+        row = cover[py]
+        alpha.append([min(255, sum(row[px * SUB:(px + 1) * SUB]) * 255 // (SUB * SUB))
+                      for px in range(width)])
+    return alpha
+
+
+def build(font, name, size, charset):
+    scale = size / font.units_per_em
+    cell_w = round(font.advance(font.cmap[ord("0")]) * scale)
+    ascent = round(font.ascender * scale)
+    cell_h = ascent + round(-font.descender * scale)
+
+    packed = []
+    for ch in charset:
+        polys = []
+        for contour in font.contours(font.cmap.get(ord(ch), 0)):
+            polys.append([(x * scale, ascent - y * scale) for x, y in flatten(contour)])
+        alpha = rasterize(polys, cell_w, cell_h)
+        for row in alpha:
+            nibbles = [(a * 15 + 127) // 255 for a in row]
+            if len(nibbles) & 1:
+                nibbles.append(0)
+            packed.extend(nibbles[i] | (nibbles[i + 1] << 4) for i in range(0, len(nibbles), 2))
+    return cell_w, cell_h, ascent, packed
+
+
+def c_string(s):
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_FONT
+    with open(path, "rb") as f:
+        font = TrueType(f.read())
+
+    out = sys.stdout
+    out.write("/**\n"
+              " * @file font_data.c\n"
+              " * @brief Precompiled glyph atlases for ui_lite text\n"
+              " * \n"
+              " * Generated by tools/mkfont.py from DejaVu Sans Mono, do not edit.\n"
+              " * 4-bit coverage, low nibble first, rows padded to whole bytes.\n"
+              " * \n"
+              " * @author Huy Nguyen\n"
+              " * @date August 2025\n"
+              " */\n\n"
+              "#include \"font.h\"\n")
+
+    for name, size, charset in FONTS:
+        cell_w, cell_h, ascent, packed = build(font, name, size, charset)
+        out.write("\n/* %s: %dpx em, %dx%d cells, %d glyphs */\n" % (name, size, cell_w, cell_h, len(charset)))
+        out.write("static const uint8_t %s_alpha[%d] = {\n" % (name, len(packed)))
+        for i in range(0, len(packed), 24):
+            out.write("    " + ",".join("%d" % b for b in packed[i:i + 24]) + ",\n")
+        out.write("};\n\n")
+        out.write("const font_t font_%s = {\n" % name)
+        out.write("    .cell_w = %d,\n    .cell_h = %d,\n    .baseline = %d,\n" % (cell_w, cell_h, ascent))
+        out.write("    .charset = %s,\n" % c_string(charset))
+        out.write("    .alpha = %s_alpha\n};\n" % name)
+
+
+if __name__ == "__main__":
+    main()
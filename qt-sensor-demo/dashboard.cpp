@@ -0,0 +1,261 @@
+/*
+ * Kiosk frontend: the same acquisition as the Qt demo (SensorFeed on its
+ * own thread, SensorHistory) drawn with the HAL's ui_lite renderer instead
+ * of Qt widgets. Only QtCore is linked, so start-up is mostly the KMS mode
+ * set and the process stays a few MB resident.
+ *
+ * Layout: per channel a caption, a large value label, a bar and a
+ * one-sample-per-second sparkline, then a 24 h min/max chart per channel
+ * in the height left below. Sparklines shrink on short panels and the
+ * charts are left out when they would be under MIN_CHART_H (800x480
+ * landscape), so the live blocks need about 380 lines. Values repaint per
+ * frame, sparklines per second, charts per minute, and each only where
+ * pixels actually change.
+ */
+#include <QtCore/QCoreApplication>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QTimer>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/signalfd.h>
+#include <time.h>
+#include <unistd.h>
+#include "hal_ui.h"
+#include "sensor-feed.h"
+#include "sensor-history.h"
+
+#define MARGIN		16
+#define CHART_MAX_W	1024
+#define MIN_CHART_H	24
+#define SPARK_H		36
+#define BG		0x101010
+#define TRACK		0x202020
+#define CAPTION		0x909090
+
+static const struct {
+	const char *caption;
+	const char *format;	/* 6 large cells */
+	const char *unit;	/* small, after the value */
+	float lo, hi;		/* bar and sparkline range */
+	uint32_t color;
+} channel_style[DataProvider::ChannelCount] = {
+	{ "TEMPERATURE", "%5.1fC", "",    0.0f,   50.0f,   0xFF6040 },
+	{ "PRESSURE",    "%6.1f",  "hPa", 950.0f, 1050.0f, 0x40A0FF },
+	{ "HUMIDITY",    "%5.1f%%", "",   0.0f,   100.0f,  0x40D080 },
+};
+
+struct Chart {
+	int x, y, w, h;
+	uint32_t color;
+	short top[CHART_MAX_W];		/* painted span per column, top > bottom: empty */
+	short bottom[CHART_MAX_W];
+};
+
+struct Dashboard {
+	int value[DataProvider::ChannelCount];
+	int range[DataProvider::ChannelCount];
+	int bar[DataProvider::ChannelCount];
+	int spark[DataProvider::ChannelCount];
+	Chart chart[DataProvider::ChannelCount];
+	int charts;			/* charts laid out, 0 on short panels */
+	float latest[DataProvider::ChannelCount];
+};
+
+static qint64 monotonic_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (qint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int percent(int channel, float value)
+{
+	float lo = channel_style[channel].lo, hi = channel_style[channel].hi;
+	return (int)((value - lo) * 100.0f / (hi - lo) + 0.5f);
+}
+
+static void build(Dashboard *d, int w, int h)
+{
+	int x = MARGIN, inner = w - 2 * MARGIN;
+	int y = MARGIN;
+
+	hal_ui_clear(BG);
+	hal_ui_text(x, y, HAL_UI_FONT_SMALL, 0xFFFFFF, "STM32MP157F-DK2 sensors");
+	y += 19 + 12;
+
+	/* Live block per channel: caption, value, bar, sparkline, 96 lines without the sparkline */
+	int spark_h = (h - MARGIN - y) / DataProvider::ChannelCount - 96;
+	if (spark_h > SPARK_H)
+		spark_h = SPARK_H;
+	if (spark_h < 8)
+		spark_h = 8;
+	for (int i = 0; i < DataProvider::ChannelCount; i++) {
+		hal_ui_text(x, y, HAL_UI_FONT_SMALL, CAPTION, channel_style[i].caption);
+		d->value[i] = hal_ui_add_label(x, y + 22, 6, HAL_UI_FONT_LARGE, channel_style[i].color, BG);
+		hal_ui_text(x + 6 * 19 + 4, y + 22 + 38 - 19 - 4, HAL_UI_FONT_SMALL, CAPTION, channel_style[i].unit);
+		d->range[i] = hal_ui_add_label(x + inner - 20 * 10, y + 22 + 10, 20, HAL_UI_FONT_SMALL, CAPTION, BG);
+		d->bar[i] = hal_ui_add_bar(x, y + 66, inner, 10, channel_style[i].color, TRACK);
+		d->spark[i] = hal_ui_add_sparkline(x, y + 82, inner, spark_h, channel_style[i].color, TRACK);
+		y += 96 + spark_h;
+	}
+
+	/* History charts share what is left, if it is enough to read them */
+	int chart_h = (h - MARGIN - y) / DataProvider::ChannelCount - 24;
+	d->charts = chart_h >= MIN_CHART_H ? DataProvider::ChannelCount : 0;
+	for (int i = 0; i < d->charts; i++) {
+		char caption[48];
+		snprintf(caption, sizeof(caption), "%s 24 H", channel_style[i].caption);
+		hal_ui_text(x, y, HAL_UI_FONT_SMALL, CAPTION, caption);
+
+		Chart &c = d->chart[i];
+		c.x = x;
+		c.y = y + 22;
+		c.w = inner < CHART_MAX_W ? inner : CHART_MAX_W;
+		c.h = chart_h;
+		c.color = channel_style[i].color;
+		for (int col = 0; col < c.w; col++) {
+			c.top[col] = 1;
+			c.bottom[col] = 0;
+		}
+		hal_ui_fill_rect(c.x, c.y, c.w, c.h, TRACK);
+		y += 24 + chart_h;
+	}
+}
+
+/* Frame-rate path: labels repaint only changed glyph cells, bars only their delta */
+static void updateValues(Dashboard *d, float temp, float pressure, float humidity)
+{
+	const float values[DataProvider::ChannelCount] = { temp, pressure, humidity };
+
+	for (int i = 0; i < DataProvider::ChannelCount; i++) {
+		char text[16];
+		snprintf(text, sizeof(text), channel_style[i].format, values[i]);
+		hal_ui_set_text(d->value[i], text);
+		hal_ui_set_value(d->bar[i], percent(i, values[i]));
+		d->latest[i] = values[i];
+	}
+	hal_ui_render();
+}
+
+/* Per second: one sparkline column per channel, plus the 24 h range */
+static void updateSeconds(Dashboard *d, const SensorHistory &history)
+{
+	qint64 now = monotonic_ns();
+
+	for (int i = 0; i < DataProvider::ChannelCount; i++) {
+		hal_ui_set_value(d->spark[i], percent(i, d->latest[i]));
+
+		SensorHistory::Point day;
+		char text[32] = "";
+		if (history.series(i, now - 24LL * 3600 * 1000000000, now, &day, 1) == 1)
+			snprintf(text, sizeof(text), "lo %.1f hi %.1f", day.min, day.max);
+		hal_ui_set_text(d->range[i], text);
+	}
+	hal_ui_render();
+}
+
+/* Per minute: redraw the columns of each chart whose min/max span moved */
+static void updateCharts(Dashboard *d, const SensorHistory &history)
+{
+	static SensorHistory::Point points[CHART_MAX_W];
+	qint64 now = monotonic_ns();
+	qint64 span = 24LL * 3600 * 1000000000;
+
+	for (int i = 0; i < d->charts; i++) {
+		Chart &c = d->chart[i];
+		int n = history.series(i, now - span, now, points, c.w);
+
+		float lo = channel_style[i].hi, hi = channel_style[i].lo;
+		for (int p = 0; p < n; p++) {
+			if (points[p].min < lo)
+				lo = points[p].min;
+			if (points[p].max > hi)
+				hi = points[p].max;
+		}
+		if (hi - lo < 1.0f) {
+			float mid = (hi + lo) / 2;
+			lo = mid - 0.5f;
+			hi = mid + 0.5f;
+		}
+
+		/* Newest point at the right edge, time runs left to right */
+		for (int col = 0; col < c.w; col++) {
+			int p = n - c.w + col;
+			int top = 1, bottom = 0;
+			if (p >= 0) {
+				top = (int)((hi - points[p].max) * (c.h - 1) / (hi - lo));
+				bottom = (int)((hi - points[p].min) * (c.h - 1) / (hi - lo));
+			}
+			if (top == c.top[col] && bottom == c.bottom[col])
+				continue;
+
+			hal_ui_fill_rect(c.x + col, c.y, 1, c.h, TRACK);
+			if (top <= bottom)
+				hal_ui_fill_rect(c.x + col, c.y + top, 1, bottom - top + 1, c.color);
+			c.top[col] = top;
+			c.bottom[col] = bottom;
+		}
+	}
+	hal_ui_render();
+}
+
+int main(int argc, char *argv[])
+{
+	/* SIGINT/SIGTERM arrive through a signalfd, blocked before any thread starts */
+	sigset_t mask;
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGINT);
+	sigaddset(&mask, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &mask, NULL);
+	int sig_fd = signalfd(-1, &mask, SFD_CLOEXEC | SFD_NONBLOCK);
+
+	QCoreApplication app(argc, argv);
+
+	if (hal_ui_init(NULL) < 0) {
+		fprintf(stderr, "Error: no display\n");
+		return 1;
+	}
+	hal_ui_info_t info;
+	hal_ui_info(&info);
+
+	static Dashboard dashboard;
+	build(&dashboard, info.w, info.h);
+	hal_ui_render();
+
+	QScopedPointer<SensorHistory> history(new SensorHistory);
+	/* SENSOR_REPLAY=/path plays a recording instead, see data-provider.h */
+	QString replay = QString::fromLocal8Bit(qgetenv("SENSOR_REPLAY"));
+	QByteArray speed = qgetenv("SENSOR_REPLAY_SPEED");
+	SensorFeed feed(1000, replay.isEmpty() ? DataProvider::Auto : DataProvider::Replay,
+			QString::fromLocal8Bit(qgetenv("SENSOR_LOG_DIR")),
+			replay, speed.isEmpty() ? 1.0f : speed.toFloat());
+
+	QObject::connect(&feed, &SensorFeed::samplesReady,
+			[&history](const SensorRecord *records, int count) {
+				history->add(records, count);
+			});
+	QObject::connect(&feed, &SensorFeed::valueChanged,
+			[](float temp, float pressure, float humidity) {
+				updateValues(&dashboard, temp, pressure, humidity);
+			});
+
+	QTimer seconds, minutes;
+	QObject::connect(&seconds, &QTimer::timeout,
+			[&history]() { updateSeconds(&dashboard, *history); });
+	QObject::connect(&minutes, &QTimer::timeout,
+			[&history]() { updateCharts(&dashboard, *history); });
+	seconds.start(1000);
+	minutes.start(60000);
+
+	QSocketNotifier quit(sig_fd, QSocketNotifier::Read);
+	QObject::connect(&quit, &QSocketNotifier::activated, &app, &QCoreApplication::quit);
+
+	int ret = app.exec();
+
+	hal_ui_shutdown();
+	close(sig_fd);
+	return ret;
+}
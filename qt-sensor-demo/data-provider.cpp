@@ -1,34 +1,398 @@
-#include <QtCore/QFile>
 #include <QDebug>
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
 #include "data-provider.h"
+#include "sensor-log.h"
 
-DataProvider::DataProvider()
+/*
+ * Per-sample logging costs more than the sampling itself, build with
+ * DEFINES += DATA_PROVIDER_DEBUG to get it back.
+ */
+#ifdef DATA_PROVIDER_DEBUG
+#define DP_DEBUG() qDebug()
+#else
+#define DP_DEBUG() if (1) {} else qDebug()
+#endif
+
+#define IIO_DEVICES "/sys/bus/iio/devices"
+
+/*
+ * IIO reports milli-degC, kPa and milli-percent, both from the processed
+ * sysfs attributes and from (raw + offset) * scale in buffers. unit turns
+ * that into degC, hPa and percent. Sysfs values are parsed to integers
+ * keeping frac_digits decimals.
+ */
+static const struct {
+	const char *name;
+	int frac_digits;
+	float unit;
+} channels[] = {
+	{ "temp",             0, 0.001f },
+	{ "pressure",         3, 10.0f },
+	{ "humidityrelative", 0, 0.001f },
+};
+
+static const float pow10_table[] = { 1.0f, 10.0f, 100.0f, 1000.0f };
+
+static qint64 monotonic_ns()
 {
-	QObject::connect(&timer, &QTimer::timeout,
-			this, &DataProvider::handleTimer);
-	timer.setInterval(1000);
-	timer.start();
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (qint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
 }
 
-void DataProvider::handleTimer()
+DataProvider::DataProvider(int interval_ms, Backend backend,
+		const QString &replay_path, float replay_speed)
+	: replay(NULL),
+	  replay_path(replay_path),
+	  replay_dir(false),
+	  replay_segment(-1),
+	  replay_record(0),
+	  replay_speed(replay_speed > 0.0f ? replay_speed : 0.0f),
+	  replay_start_ns(0),
+	  replay_last_ns(-1),
+	  replay_offset_ns(0)
 {
-	QFile temp_f("/dev/zero");
-	QFile pressure_f("/dev/zero");
-	QFile humidity_f("/dev/zero");
+	for (int i = 0; i < ChannelCount; i++) {
+		fds[i] = -1;
+		latest[i] = 0.0f;
+		buffers[i] = NULL;
+	}
 
-	if (!temp_f.open(QIODevice::ReadOnly | QIODevice::Text))
-		return;
-	if (!pressure_f.open(QIODevice::ReadOnly | QIODevice::Text))
+	if (backend == Replay) {
+		struct stat st;
+		QByteArray path = replay_path.toLocal8Bit();
+		replay_dir = stat(path.constData(), &st) == 0 && S_ISDIR(st.st_mode);
+		replay = new SensorLogReader;
+		replay_start_ns = monotonic_ns();
+
+		QObject::connect(&timer, &QTimer::timeout,
+				this, &DataProvider::handleReplay);
+		timer.setTimerType(Qt::PreciseTimer);
+		timer.setSingleShot(true);
+		timer.start(0);
 		return;
-	if (!humidity_f.open(QIODevice::ReadOnly | QIODevice::Text))
+	}
+
+	if (backend == Auto)
+		startBuffers(interval_ms);
+
+	/* Whatever no buffer covers is polled from sysfs */
+	bool polled = false;
+	for (int i = 0; i < ChannelCount; i++) {
+		bool buffered = false;
+		for (int b = 0; b < ChannelCount && buffers[b]; b++) {
+			for (int c = 0; c < buffers[b]->channelCount(); c++)
+				buffered |= (columns[b][c] == i);
+		}
+		if (buffered)
+			continue;
+
+		char attr[64];
+		snprintf(attr, sizeof(attr), "in_%s_input", channels[i].name);
+		fds[i] = openChannel(attr);
+		if (fds[i] < 0)
+			qWarning() << "No IIO device provides" << attr;
+		polled = true;
+	}
+
+	if (polled) {
+		QObject::connect(&timer, &QTimer::timeout,
+				this, &DataProvider::handleTimer);
+		timer.setTimerType(Qt::PreciseTimer);
+		timer.setInterval(interval_ms);
+		timer.start();
+	}
+}
+
+DataProvider::~DataProvider()
+{
+	delete replay;
+	for (int i = 0; i < ChannelCount; i++) {
+		delete buffers[i];
+		if (fds[i] >= 0)
+			close(fds[i]);
+	}
+}
+
+/* Find the first IIO device exposing the attribute and keep it open */
+int DataProvider::openChannel(const char *attribute)
+{
+	DIR *dir = opendir(IIO_DEVICES);
+	if (!dir)
+		return -1;
+
+	int fd = -1;
+	struct dirent *entry;
+	while (fd < 0 && (entry = readdir(dir)) != NULL) {
+		if (strncmp(entry->d_name, "iio:device", 10) != 0)
+			continue;
+
+		char path[256];
+		snprintf(path, sizeof(path), IIO_DEVICES "/%s/%s", entry->d_name, attribute);
+		fd = open(path, O_RDONLY | O_CLOEXEC);
+	}
+
+	closedir(dir);
+	return fd;
+}
+
+/*
+ * One buffer per device that has scan elements for our channels. The
+ * sampling rate follows the polling interval, and frames are batched so
+ * the GUI thread wakes about ten times a second whatever the rate.
+ */
+void DataProvider::startBuffers(int interval_ms)
+{
+	DIR *dir = opendir(IIO_DEVICES);
+	if (!dir)
 		return;
 
-	float temp = QString(temp_f.readAll()).toDouble() / 1000;
-	float pressure = QString(pressure_f.readAll()).toDouble() * 10;
-	float humidity = QString(humidity_f.readAll()).toDouble() / 1000;
+	int frequency = interval_ms > 0 ? (1000 + interval_ms / 2) / interval_ms : 1;
+	if (frequency < 1)
+		frequency = 1;
+	int batch = frequency / 10;
+	if (batch < 1)
+		batch = 1;
+	if (batch > IioBuffer::MaxBatch)
+		batch = IioBuffer::MaxBatch;
 
-	qDebug() << "Temperature: " << temp << "Pressure: " << pressure << "Humidity: " << humidity;
+	bool claimed[ChannelCount] = { false };
+	int nbuffers = 0;
+	struct dirent *entry;
+	while (nbuffers < ChannelCount && (entry = readdir(dir)) != NULL) {
+		if (strncmp(entry->d_name, "iio:device", 10) != 0)
+			continue;
 
-	emit valueChanged(temp, pressure, humidity);
+		IioBuffer *buffer = new IioBuffer(QString(IIO_DEVICES "/") + entry->d_name);
+		for (int i = 0; i < ChannelCount; i++) {
+			if (claimed[i])
+				continue;
+			int column = buffer->addChannel(channels[i].name);
+			if (column >= 0)
+				columns[nbuffers][column] = i;
+		}
+
+		if (buffer->channelCount() == 0 || !buffer->start(batch, frequency)) {
+			delete buffer;
+			continue;
+		}
+
+		for (int c = 0; c < buffer->channelCount(); c++)
+			claimed[columns[nbuffers][c]] = true;
+
+		int index = nbuffers++;
+		buffers[index] = buffer;
+		QObject::connect(buffer, &IioBuffer::framesReady, this,
+				[this, index](const qint64 *timestamps, const float *values, int count) {
+					handleFrames(index, timestamps, values, count);
+				});
+	}
+
+	closedir(dir);
+}
+
+/*
+ * Read a sysfs decimal such as "23450" or "-101.325000" as an integer
+ * scaled by 10^frac_digits. pread at offset 0 re-runs the driver's show()
+ * on every call, so the fd stays open and nothing touches the heap.
+ */
+bool DataProvider::readFixed(int fd, int frac_digits, long long *value)
+{
+	char buf[32];
+	ssize_t len = pread(fd, buf, sizeof(buf), 0);
+	if (len <= 0)
+		return false;
+
+	const char *p = buf;
+	const char *end = buf + len;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+		negative = (*p++ == '-');
+	if (p == end || *p < '0' || *p > '9')
+		return false;
+
+	long long result = 0;
+	while (p < end && *p >= '0' && *p <= '9')
+		result = result * 10 + (*p++ - '0');
+
+	int digits = 0;
+	if (p < end && *p == '.') {
+		for (p++; p < end && *p >= '0' && *p <= '9' && digits < frac_digits; p++, digits++)
+			result = result * 10 + (*p - '0');
+	}
+	for (; digits < frac_digits; digits++)
+		result *= 10;
+
+	*value = negative ? -result : result;
+	return true;
 }
 
+void DataProvider::handleFrames(int buffer, const qint64 *timestamps, const float *values, int count)
+{
+	int stride = buffers[buffer]->channelCount();
+
+	for (int c = 0; c < stride; c++) {
+		int channel = columns[buffer][c];
+		for (int i = 0; i < count; i++) {
+			block[i].timestamp_ns = timestamps[i];
+			block[i].value = values[i * stride + c] * channels[channel].unit;
+		}
+		latest[channel] = block[count - 1].value;
+		emit samplesReady(channel, block, count);
+	}
+
+	publish();
+}
+
+void DataProvider::handleTimer()
+{
+	qint64 now = monotonic_ns();
+
+	for (int i = 0; i < ChannelCount; i++) {
+		if (fds[i] < 0)
+			continue;
+
+		long long raw;
+		if (!readFixed(fds[i], channels[i].frac_digits, &raw))
+			raw = 0;
+
+		block[0].timestamp_ns = now;
+		block[0].value = raw * channels[i].unit / pow10_table[channels[i].frac_digits];
+		latest[i] = block[0].value;
+		emit samplesReady(i, block, 1);
+	}
+
+	publish();
+}
+
+/* Open the segment after replay_segment, false when none is left */
+bool DataProvider::nextSegment()
+{
+	QByteArray path = replay_path.toLocal8Bit();
+
+	if (!replay_dir) {
+		if (replay_segment >= 0)
+			return false;
+		replay_segment = 0;
+		replay_record = 0;
+		if (!replay->open(path.constData())) {
+			qWarning() << "Sensor replay: not a sensor log:" << path.constData();
+			return false;
+		}
+		return true;
+	}
+
+	for (;;) {
+		DIR *d = opendir(path.constData());
+		if (!d)
+			return false;
+
+		qint64 next = -1;
+		struct dirent *entry;
+		while ((entry = readdir(d)) != NULL) {
+			unsigned int segment;
+			char tail[8];
+			if (sscanf(entry->d_name, "sensor-%6u.log%7s", &segment, tail) != 1)
+				continue;
+			if ((qint64)segment > replay_segment && (next < 0 || (qint64)segment < next))
+				next = segment;
+		}
+		closedir(d);
+		if (next < 0)
+			return false;
+
+		char name[32];
+		snprintf(name, sizeof(name), "/sensor-%06u.log", (unsigned int)next);
+		replay_segment = next;
+		replay_record = 0;
+		if (replay->open((path + name).constData()))
+			return true;
+		qWarning() << "Sensor replay: skipping" << name + 1;
+	}
+}
+
+/*
+ * Emit every record due on the replay clock, a block per run of one
+ * channel, then sleep until the next one. Without delays, ReplayChunk
+ * records go per call so the thread's event loop keeps turning.
+ */
+void DataProvider::handleReplay()
+{
+	const qint64 max_gap = ReplayGapMs * 1000000LL;
+	qint64 now = monotonic_ns();
+	qint64 wait_ns = -1;
+	int channel = -1;
+	int played = 0;
+	int n = 0;
+
+	while (replay_record < replay->count() || nextSegment()) {
+		if (replay_record >= replay->count())
+			continue;	/* empty segment */
+
+		const SensorLogRecord &record = replay->records()[replay_record];
+		qint64 timestamp = replay->timestamp(record);
+		/*
+		 * Buffered frames are logged a channel at a time, so time steps
+		 * back within a batch; a long step back is a later boot.
+		 */
+		qint64 gap = replay_last_ns >= 0 ? timestamp - replay_last_ns : 0;
+		if (gap > max_gap)
+			gap = max_gap;
+		else if (gap < -max_gap)
+			gap = 0;
+		qint64 offset = replay_offset_ns + gap;
+
+		qint64 due = replay_start_ns +
+			(replay_speed > 0.0f ? (qint64)(offset / replay_speed) : offset);
+		if (replay_speed > 0.0f ? due > now : played == ReplayChunk) {
+			wait_ns = replay_speed > 0.0f ? due - now : 0;
+			break;
+		}
+
+		int c = replay->channel(record);
+		if (n > 0 && (c != channel || n == IioBuffer::MaxBatch)) {
+			emit samplesReady(channel, block, n);
+			n = 0;
+		}
+		channel = c;
+		block[n].timestamp_ns = due;
+		block[n].value = replay->value(record);
+		latest[channel] = block[n++].value;
+
+		if (gap >= 0) {
+			replay_offset_ns = offset;
+			replay_last_ns = timestamp;
+		}
+		replay_record++;
+		played++;
+	}
+
+	if (n > 0)
+		emit samplesReady(channel, block, n);
+	if (played > 0)
+		publish();
+
+	if (wait_ns >= 0) {
+		timer.start((int)((wait_ns + 999999) / 1000000));
+	} else {
+		qDebug() << "Sensor replay finished after" << replay_offset_ns / 1000000 << "ms";
+		replay->close();
+	}
+}
+
+void DataProvider::publish()
+{
+	float temp = latest[Temp];
+	float pressure = latest[Pressure];
+	float humidity = latest[Humidity];
+
+	DP_DEBUG() << "Temperature: " << temp << "Pressure: " << pressure << "Humidity: " << humidity;
+
+	emit valueChanged(temp, pressure, humidity);
+}
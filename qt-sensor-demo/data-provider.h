@@ -2,22 +2,75 @@
 #define DATA_PROVIDER_H
 
 #include <QtCore/QTimer>
+#include "iio-buffer.h"
+
+class SensorLogReader;
+
+struct SensorSample {
+	qint64 timestamp_ns;	/* CLOCK_MONOTONIC, from the kernel when buffered */
+	float value;
+};
 
 class DataProvider: public QObject
 {
 	Q_OBJECT
 
 public:
-	DataProvider();
+	enum Channel { Temp, Pressure, Humidity, ChannelCount };
+	enum Backend {
+		Auto,		/* IIO buffers where the driver supports them, sysfs polling otherwise */
+		Polling,	/* sysfs attributes only */
+		Replay		/* a SensorLog recording instead of the hardware */
+	};
+	enum { ReplayGapMs = 2000, ReplayChunk = 1024 };
+
+	/*
+	 * Replay plays back replay_path, one segment or a SensorLog directory
+	 * in segment order, at replay_speed times the recorded pace (0 = no
+	 * delays). Samples are stamped with the time they are due, so
+	 * SensorHistory and the frontends work unchanged. Idle gaps longer
+	 * than ReplayGapMs, such as between runs, are cut to that. Record with
+	 * SENSOR_LOG_DIR, replay with SENSOR_REPLAY and SENSOR_REPLAY_SPEED.
+	 */
+	explicit DataProvider(int interval_ms = 1000, Backend backend = Auto,
+			const QString &replay_path = QString(), float replay_speed = 1.0f);
+	~DataProvider();
 
 private slots:
 	void handleTimer();
+	void handleReplay();
 
 signals:
 	void valueChanged(float temp, float pressure, float humidity);
+	/* Every sample in arrival order, a block per wakeup; the array is only valid during the call */
+	void samplesReady(int channel, const SensorSample *samples, int count);
 
 private:
+	static int openChannel(const char *attribute);
+	static bool readFixed(int fd, int frac_digits, long long *value);
+
+	void startBuffers(int interval_ms);
+	void handleFrames(int buffer, const qint64 *timestamps, const float *values, int count);
+	void publish();
+	bool nextSegment();
+
 	QTimer timer;
+	int fds[ChannelCount];
+	float latest[ChannelCount];
+
+	IioBuffer *buffers[ChannelCount];
+	int columns[ChannelCount][IioBuffer::MaxChannels];	/* buffer column -> channel */
+	SensorSample block[IioBuffer::MaxBatch];
+
+	SensorLogReader *replay;	/* NULL unless replaying */
+	QString replay_path;
+	bool replay_dir;		/* replay_path is a directory of segments */
+	qint64 replay_segment;		/* number of the open segment, -1 before the first */
+	int replay_record;		/* next record in the open segment */
+	float replay_speed;
+	qint64 replay_start_ns;		/* replay clock origin, CLOCK_MONOTONIC */
+	qint64 replay_last_ns;		/* latest recorded time so far, -1 before the first record */
+	qint64 replay_offset_ns;	/* its offset on the replay clock, gaps cut */
 };
 
 #endif /* DATA_PROVIDER_H */
@@ -0,0 +1,313 @@
+#include <QDebug>
+#include <QtCore/QSocketNotifier>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "iio-buffer.h"
+
+IioBuffer::IioBuffer(const QString &device_dir)
+	: dir(device_dir),
+	  dev_name(device_dir.section('/', -1)),
+	  nchannels(0),
+	  frame_size(0),
+	  dev_fd(-1),
+	  enabled(false),
+	  notifier(NULL),
+	  frames(NULL)
+{
+	memset(elements, 0, sizeof(elements));
+	memset(&timestamp, 0, sizeof(timestamp));
+}
+
+IioBuffer::~IioBuffer()
+{
+	stop();
+}
+
+bool IioBuffer::writeAttr(const char *attr, const char *value)
+{
+	QByteArray path = (dir + '/' + attr).toLocal8Bit();
+	int fd = open(path.constData(), O_WRONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	size_t len = strlen(value);
+	bool ok = write(fd, value, len) == (ssize_t)len;
+	close(fd);
+	return ok;
+}
+
+bool IioBuffer::readAttr(const char *attr, char *buf, int size)
+{
+	QByteArray path = (dir + '/' + attr).toLocal8Bit();
+	int fd = open(path.constData(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	ssize_t len = read(fd, buf, size - 1);
+	close(fd);
+	if (len <= 0)
+		return false;
+
+	while (len > 0 && (buf[len - 1] == '\n' || buf[len - 1] == ' '))
+		len--;
+	buf[len] = '\0';
+	return true;
+}
+
+/* Scan element layout from scan_elements/in_<name>_{index,type}, e.g. "le:s16/16>>0" */
+bool IioBuffer::parseElement(const char *name, Element *element)
+{
+	char attr[96], buf[64];
+	char endian, sign;
+	int storage;
+
+	snprintf(attr, sizeof(attr), "scan_elements/in_%s_index", name);
+	if (!readAttr(attr, buf, sizeof(buf)))
+		return false;
+	element->index = atoi(buf);
+
+	snprintf(attr, sizeof(attr), "scan_elements/in_%s_type", name);
+	if (!readAttr(attr, buf, sizeof(buf)) ||
+	    sscanf(buf, "%ce:%c%d/%d>>%d", &endian, &sign, &element->bits, &storage, &element->shift) != 5)
+		return false;
+	if (storage != 8 && storage != 16 && storage != 32 && storage != 64)
+		return false;
+
+	element->bytes = storage / 8;
+	element->is_signed = (sign == 's');
+	element->big_endian = (endian == 'b');
+
+	/* Shared attributes drop the channel index, e.g. in_temp_scale */
+	snprintf(attr, sizeof(attr), "in_%s_scale", name);
+	element->scale = readAttr(attr, buf, sizeof(buf)) ? strtof(buf, NULL) : 1.0f;
+	snprintf(attr, sizeof(attr), "in_%s_offset", name);
+	element->value_offset = readAttr(attr, buf, sizeof(buf)) ? strtof(buf, NULL) : 0.0f;
+	return true;
+}
+
+int IioBuffer::addChannel(const char *name)
+{
+	if (enabled || nchannels == MaxChannels)
+		return -1;
+
+	Element *element = &elements[nchannels];
+	if (!parseElement(name, element))
+		return -1;
+
+	snprintf(names[nchannels], sizeof(names[nchannels]), "%s", name);
+	return nchannels++;
+}
+
+/*
+ * Keep a trigger someone already chose, otherwise take the one the driver
+ * registered for this device ("<name>-trigger" or "<name>-dev<N>"). Drivers
+ * with a hardware FIFO need none, so failing here is not fatal.
+ */
+bool IioBuffer::setupTrigger()
+{
+	char current[64], name[64];
+	if (readAttr("trigger/current_trigger", current, sizeof(current)) && current[0])
+		return true;
+	if (!readAttr("name", name, sizeof(name)))
+		return false;
+
+	DIR *triggers = opendir("/sys/bus/iio/devices");
+	if (!triggers)
+		return false;
+
+	bool found = false;
+	struct dirent *entry;
+	while (!found && (entry = readdir(triggers)) != NULL) {
+		if (strncmp(entry->d_name, "trigger", 7) != 0)
+			continue;
+
+		char path[512], trigger[64];
+		snprintf(path, sizeof(path), "/sys/bus/iio/devices/%s/name", entry->d_name);
+		int fd = open(path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			continue;
+		ssize_t len = read(fd, trigger, sizeof(trigger) - 1);
+		close(fd);
+		if (len <= 0)
+			continue;
+		trigger[len] = '\0';
+		trigger[strcspn(trigger, "\n")] = '\0';
+
+		if (strncmp(trigger, name, strlen(name)) == 0)
+			found = writeAttr("trigger/current_trigger", trigger);
+	}
+
+	closedir(triggers);
+	return found;
+}
+
+bool IioBuffer::start(int batch, int frequency_hz)
+{
+	if (enabled)
+		return true;
+	if (nchannels == 0)
+		return false;
+	if (batch < 1)
+		batch = 1;
+	if (batch > MaxBatch)
+		batch = MaxBatch;
+
+	/* Layout changes are refused while the buffer runs */
+	writeAttr("buffer/enable", "0");
+
+	/* Only our elements may be in the frame, or the offsets below are wrong */
+	QByteArray scan_dir = (dir + "/scan_elements").toLocal8Bit();
+	DIR *scan = opendir(scan_dir.constData());
+	if (!scan)
+		return false;
+	struct dirent *entry;
+	while ((entry = readdir(scan)) != NULL) {
+		size_t len = strlen(entry->d_name);
+		if (len > 3 && strcmp(entry->d_name + len - 3, "_en") == 0)
+			writeAttr((QByteArray("scan_elements/") + entry->d_name).constData(), "0");
+	}
+	closedir(scan);
+
+	char attr[96];
+	for (int i = 0; i < nchannels; i++) {
+		snprintf(attr, sizeof(attr), "scan_elements/in_%s_en", names[i]);
+		if (!writeAttr(attr, "1"))
+			return false;
+	}
+	bool has_timestamp = parseElement("timestamp", &timestamp) &&
+			writeAttr("scan_elements/in_timestamp_en", "1");
+	if (!has_timestamp)
+		timestamp.bytes = 0;
+
+	/* Elements sit in index order, each aligned to its own size, the frame to the largest */
+	Element *order[MaxChannels + 1];
+	int count = 0;
+	for (int i = 0; i < nchannels; i++)
+		order[count++] = &elements[i];
+	if (has_timestamp)
+		order[count++] = &timestamp;
+	for (int i = 1; i < count; i++) {
+		for (int j = i; j > 0 && order[j]->index < order[j - 1]->index; j--) {
+			Element *tmp = order[j];
+			order[j] = order[j - 1];
+			order[j - 1] = tmp;
+		}
+	}
+
+	int offset = 0, align = 1;
+	for (int i = 0; i < count; i++) {
+		int bytes = order[i]->bytes;
+		offset = (offset + bytes - 1) / bytes * bytes;
+		order[i]->offset = offset;
+		offset += bytes;
+		if (bytes > align)
+			align = bytes;
+	}
+	frame_size = (offset + align - 1) / align * align;
+
+	setupTrigger();
+	writeAttr("current_timestamp_clock", "monotonic");
+	if (frequency_hz > 0) {
+		char value[16];
+		snprintf(value, sizeof(value), "%d", frequency_hz);
+		if (!writeAttr("sampling_frequency", value))
+			qWarning() << dev_name << "keeps its sampling frequency";
+	}
+
+	/* The watermark is what batches wakeups, older kernels wake per frame */
+	char value[16];
+	snprintf(value, sizeof(value), "%d", batch * 4 > 128 ? batch * 4 : 128);
+	writeAttr("buffer/length", value);
+	snprintf(value, sizeof(value), "%d", batch);
+	writeAttr("buffer/watermark", value);
+
+	if (!writeAttr("buffer/enable", "1"))
+		return false;
+	enabled = true;
+
+	QByteArray dev_path = ("/dev/" + dev_name).toLocal8Bit();
+	dev_fd = open(dev_path.constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+	if (dev_fd < 0) {
+		stop();
+		return false;
+	}
+
+	frames = new unsigned char[(size_t)frame_size * MaxBatch];
+	notifier = new QSocketNotifier(dev_fd, QSocketNotifier::Read, this);
+	QObject::connect(notifier, &QSocketNotifier::activated, this, &IioBuffer::readFrames);
+	return true;
+}
+
+void IioBuffer::stop()
+{
+	delete notifier;
+	notifier = NULL;
+	if (dev_fd >= 0) {
+		close(dev_fd);
+		dev_fd = -1;
+	}
+	if (enabled) {
+		writeAttr("buffer/enable", "0");
+		enabled = false;
+	}
+	delete[] frames;
+	frames = NULL;
+}
+
+qint64 IioBuffer::extract(const unsigned char *frame, const Element &element)
+{
+	const unsigned char *p = frame + element.offset;
+	quint64 raw = 0;
+
+	for (int i = 0; i < element.bytes; i++) {
+		int byte = element.big_endian ? i : element.bytes - 1 - i;
+		raw = (raw << 8) | p[byte];
+	}
+
+	raw >>= element.shift;
+	if (element.bits < 64) {
+		raw &= (1ULL << element.bits) - 1;
+		if (element.is_signed && (raw & (1ULL << (element.bits - 1))))
+			raw |= ~0ULL << element.bits;
+	}
+	return (qint64)raw;
+}
+
+/* Drain everything queued, MaxBatch frames per read(), one signal per read */
+void IioBuffer::readFrames()
+{
+	for (;;) {
+		ssize_t len = read(dev_fd, frames, (size_t)frame_size * MaxBatch);
+		if (len < 0 && errno == EINTR)
+			continue;
+		if (len < frame_size)
+			return;
+
+		int count = (int)(len / frame_size);
+		qint64 fallback = 0;
+		if (timestamp.bytes == 0) {
+			struct timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			fallback = (qint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+		}
+
+		for (int f = 0; f < count; f++) {
+			const unsigned char *frame = frames + (size_t)f * frame_size;
+			timestamps[f] = timestamp.bytes ? extract(frame, timestamp) : fallback;
+			for (int c = 0; c < nchannels; c++) {
+				const Element &element = elements[c];
+				values[f * nchannels + c] = (extract(frame, element) + element.value_offset) * element.scale;
+			}
+		}
+
+		emit framesReady(timestamps, values, count);
+		if (count < MaxBatch)
+			return;
+	}
+}
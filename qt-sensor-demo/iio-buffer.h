@@ -0,0 +1,74 @@
+#ifndef IIO_BUFFER_H
+#define IIO_BUFFER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+class QSocketNotifier;
+
+/*
+ * Streams one IIO device through its triggered buffer: enables the
+ * requested scan elements, reads binary scan frames from /dev/iio:deviceN
+ * in batches when the chardev becomes readable, and hands them out as
+ * processed values, (raw + offset) * scale, with the kernel timestamp.
+ */
+class IioBuffer: public QObject
+{
+	Q_OBJECT
+
+public:
+	enum { MaxChannels = 4, MaxBatch = 64 };
+
+	explicit IioBuffer(const QString &device_dir);
+	~IioBuffer();
+
+	/* Channel base name as in scan_elements, e.g. "temp"; returns its column or -1 */
+	int addChannel(const char *name);
+	bool start(int batch, int frequency_hz);
+	void stop();
+
+	int channelCount() const { return nchannels; }
+
+signals:
+	/* values holds count rows of channelCount() columns, timestamps in ns */
+	void framesReady(const qint64 *timestamps, const float *values, int count);
+
+private slots:
+	void readFrames();
+
+private:
+	struct Element {
+		int index;
+		int offset;		/* byte offset in the scan frame */
+		int bytes;		/* storage size */
+		int shift;
+		int bits;		/* real bits */
+		bool is_signed;
+		bool big_endian;
+		float scale;
+		float value_offset;
+	};
+
+	bool writeAttr(const char *attr, const char *value);
+	bool readAttr(const char *attr, char *buf, int size);
+	bool parseElement(const char *name, Element *element);
+	bool setupTrigger();
+	static qint64 extract(const unsigned char *frame, const Element &element);
+
+	QString dir;
+	QString dev_name;
+	int nchannels;
+	char names[MaxChannels][32];
+	Element elements[MaxChannels];
+	Element timestamp;
+	int frame_size;
+	int dev_fd;
+	bool enabled;
+	QSocketNotifier *notifier;
+
+	unsigned char *frames;
+	qint64 timestamps[MaxBatch];
+	float values[MaxBatch * MaxChannels];
+};
+
+#endif /* IIO_BUFFER_H */
@@ -1,15 +1,34 @@
 #include <QApplication>
 #include <QPushButton>
-#include "data-provider.h"
+#include <QtCore/QScopedPointer>
+#include "sensor-feed.h"
+#include "sensor-history.h"
 
 int main(int argc, char* argv[])
 {
 	QApplication app(argc, argv);
 	QPushButton hello("Hello world!!");
-	DataProvider dp;
-	
+	/* SENSOR_LOG_DIR=/path records all samples, see sensor-log.h */
+	/* SENSOR_REPLAY=/path plays a recording instead, see data-provider.h */
+	QString replay = QString::fromLocal8Bit(qgetenv("SENSOR_REPLAY"));
+	QByteArray speed = qgetenv("SENSOR_REPLAY_SPEED");
+	SensorFeed feed(1000, replay.isEmpty() ? DataProvider::Auto : DataProvider::Replay,
+			QString::fromLocal8Bit(qgetenv("SENSOR_LOG_DIR")),
+			replay, speed.isEmpty() ? 1.0f : speed.toFloat());
+	QScopedPointer<SensorHistory> history(new SensorHistory);
+
+	QObject::connect(&feed, &SensorFeed::samplesReady,
+			[&history](const SensorRecord *records, int count) {
+				history->add(records, count);
+			});
+
+	QObject::connect(&feed, &SensorFeed::valueChanged, &hello,
+			[&hello](float temp, float pressure, float humidity) {
+				hello.setText(QString::asprintf("%.1f C  %.0f hPa  %.0f %%",
+						temp, pressure, humidity));
+			});
+
 	hello.resize(100,30);
 	hello.show();
 	return app.exec();
 }
-
@@ -1,5 +1,19 @@
 QT += widgets
-SOURCES = main.cpp data-provider.cpp
-HEADERS = data-provider.h
+SOURCES = main.cpp data-provider.cpp iio-buffer.cpp sensor-feed.cpp sensor-history.cpp sensor-log.cpp
+HEADERS = data-provider.h iio-buffer.h sensor-feed.h sensor-history.h sensor-log.h
 INSTALLS += target
 target.path = /usr/bin
+# Per-sample qDebug output
+#DEFINES += DATA_PROVIDER_DEBUG
+
+# qmake CONFIG+=dashboard: QtCore-only kiosk frontend drawn by the HAL
+# (build ../hal first), also available as `make dashboard` in ../hal
+dashboard {
+	QT = core
+	TARGET = sensor-dashboard
+	SOURCES -= main.cpp
+	SOURCES += dashboard.cpp
+	INCLUDEPATH += ../hal/include
+	LIBS += -L$$PWD/../hal/build -lhal -lpthread -lm
+	PRE_TARGETDEPS += $$PWD/../hal/build/libhal.a
+}
@@ -0,0 +1,132 @@
+#include "sensor-feed.h"
+#include "sensor-log.h"
+
+SensorFeed::SensorFeed(int interval_ms, DataProvider::Backend backend,
+		const QString &log_dir, const QString &replay_path, float replay_speed,
+		QObject *parent)
+	: QObject(parent),
+	  provider(NULL),
+	  log(NULL),
+	  interval_ms(interval_ms),
+	  backend(backend),
+	  log_dir(log_dir),
+	  replay_path(replay_path),
+	  replay_speed(replay_speed),
+	  head(0),
+	  tail(0),
+	  dropped(0),
+	  wake_posted(0),
+	  frame_pending(false)
+{
+	for (int i = 0; i < DataProvider::ChannelCount; i++)
+		latest[i] = 0.0f;
+
+	frame_timer.setSingleShot(true);
+	frame_timer.setInterval(FrameMs);
+	QObject::connect(&frame_timer, &QTimer::timeout,
+			this, &SensorFeed::frameDone);
+
+	/*
+	 * The provider and the log are built and destroyed on the acquisition
+	 * thread, so their timers and socket notifiers belong to that thread's
+	 * event loop, and log syncs never stall the GUI. Both lambdas, push()
+	 * and SensorLog::append() run there as direct calls.
+	 */
+	QObject::connect(&thread, &QThread::started, [this]() {
+		provider = new DataProvider(this->interval_ms, this->backend,
+				this->replay_path, this->replay_speed);
+		QObject::connect(provider, &DataProvider::samplesReady,
+				[this](int channel, const SensorSample *samples, int count) {
+					push(channel, samples, count);
+				});
+
+		if (!this->log_dir.isEmpty()) {
+			log = new SensorLog(this->log_dir);
+			QObject::connect(provider, &DataProvider::samplesReady, log, &SensorLog::append);
+		}
+	});
+	QObject::connect(&thread, &QThread::finished, [this]() {
+		delete provider;
+		provider = NULL;
+		delete log;
+		log = NULL;
+	});
+
+	thread.setObjectName("sensor-acquisition");
+	thread.start();
+}
+
+SensorFeed::~SensorFeed()
+{
+	thread.quit();
+	thread.wait();
+}
+
+/* Acquisition thread: copy into the ring, post one wake if none is outstanding */
+void SensorFeed::push(int channel, const SensorSample *samples, int count)
+{
+	quint32 h = head.loadAcquire();
+	quint32 t = tail.loadAcquire();
+
+	int i = 0;
+	for (; i < count && h - t < RingSize; i++, h++) {
+		SensorRecord &record = ring[h % RingSize];
+		record.timestamp_ns = samples[i].timestamp_ns;
+		record.value = samples[i].value;
+		record.channel = channel;
+	}
+	if (i < count)
+		dropped.fetchAndAddRelaxed(count - i);
+
+	head.storeRelease(h);
+	if (wake_posted.testAndSetOrdered(0, 1))
+		QMetaObject::invokeMethod(this, "wake", Qt::QueuedConnection);
+}
+
+/* GUI thread: deliver now, or at the end of the current frame */
+void SensorFeed::wake()
+{
+	if (frame_timer.isActive()) {
+		frame_pending = true;
+		return;
+	}
+	drain();
+	frame_timer.start();
+}
+
+void SensorFeed::frameDone()
+{
+	if (!frame_pending)
+		return;
+	frame_pending = false;
+	drain();
+	frame_timer.start();
+}
+
+void SensorFeed::drain()
+{
+	/* Cleared first, so anything pushed from here on posts a fresh wake */
+	wake_posted.storeRelease(0);
+
+	quint32 h = head.loadAcquire();
+	quint32 t = tail.loadAcquire();
+	if (h == t)
+		return;
+
+	int count = (int)(h - t);
+	int first = (int)(t % RingSize);
+	int contiguous = count < RingSize - first ? count : RingSize - first;
+
+	for (quint32 i = t; i != h; i++) {
+		const SensorRecord &record = ring[i % RingSize];
+		latest[record.channel] = record.value;
+	}
+
+	emit samplesReady(ring + first, contiguous);
+	if (contiguous < count)
+		emit samplesReady(ring, count - contiguous);
+	tail.storeRelease(h);
+
+	emit valueChanged(latest[DataProvider::Temp], latest[DataProvider::Pressure],
+			latest[DataProvider::Humidity]);
+}
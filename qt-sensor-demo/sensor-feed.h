@@ -0,0 +1,83 @@
+#ifndef SENSOR_FEED_H
+#define SENSOR_FEED_H
+
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include "data-provider.h"
+
+class SensorLog;
+
+struct SensorRecord {
+	qint64 timestamp_ns;
+	float value;
+	int channel;		/* DataProvider::Channel */
+};
+
+/*
+ * Runs a DataProvider on its own thread so slow sysfs reads or I2C stalls
+ * never block the GUI. Samples go into a preallocated single-producer,
+ * single-consumer ring; the GUI is woken by at most one queued call at a
+ * time and drains the ring at most once per frame, so cross-thread
+ * traffic follows the frame rate rather than the sample rate.
+ */
+class SensorFeed: public QObject
+{
+	Q_OBJECT
+
+public:
+	enum { RingSize = 4096, FrameMs = 16 };
+
+	/*
+	 * A non-empty log_dir also records every sample there, see SensorLog.
+	 * replay_path and replay_speed are for DataProvider::Replay.
+	 */
+	explicit SensorFeed(int interval_ms = 1000,
+			DataProvider::Backend backend = DataProvider::Auto,
+			const QString &log_dir = QString(),
+			const QString &replay_path = QString(),
+			float replay_speed = 1.0f,
+			QObject *parent = NULL);
+	~SensorFeed();
+
+	/* Samples lost because the GUI fell a whole ring behind */
+	quint32 droppedSamples() const { return dropped.loadAcquire(); }
+
+signals:
+	/*
+	 * Everything that arrived since the last frame, oldest first, in at
+	 * most two calls when the ring wraps. Only valid during the call.
+	 */
+	void samplesReady(const SensorRecord *records, int count);
+	/* Latest value of each channel, once per frame */
+	void valueChanged(float temp, float pressure, float humidity);
+
+private slots:
+	void wake();
+	void frameDone();
+
+private:
+	void push(int channel, const SensorSample *samples, int count);
+	void drain();
+
+	QThread thread;
+	DataProvider *provider;		/* lives on, and is owned by, thread */
+	SensorLog *log;			/* likewise, NULL when not recording */
+	int interval_ms;
+	DataProvider::Backend backend;
+	QString log_dir;
+	QString replay_path;
+	float replay_speed;
+
+	SensorRecord ring[RingSize];
+	QAtomicInteger<quint32> head;	/* written by the acquisition thread */
+	QAtomicInteger<quint32> tail;	/* written by the GUI thread */
+	QAtomicInteger<quint32> dropped;
+	QAtomicInt wake_posted;
+
+	QTimer frame_timer;
+	bool frame_pending;
+	float latest[DataProvider::ChannelCount];
+};
+
+#endif /* SENSOR_FEED_H */
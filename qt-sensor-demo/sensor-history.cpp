@@ -0,0 +1,200 @@
+#include <string.h>
+#include "sensor-history.h"
+
+static const qint64 second_ns = 1000000000LL;
+static const qint64 bucket_ns[] = { 0, second_ns, 60 * second_ns, 3600 * second_ns };
+
+/* A level is picked only if the chart reads at most this many entries per point */
+#define MAX_MERGE 16
+
+SensorHistory::SensorHistory()
+{
+	clear();
+}
+
+void SensorHistory::clear()
+{
+	memset(channels, 0, sizeof(channels));
+}
+
+/*
+ * Fold an aggregate into the level's open bucket. When it belongs to a
+ * later bucket the open one is closed into the ring, returned through
+ * closed for the next level up, and the aggregate starts a new bucket.
+ */
+template<int N> bool SensorHistory::accumulate(Rollup<N> &level, qint64 bucket_ns,
+		Bucket in, Bucket *closed)
+{
+	qint64 start = in.start - in.start % bucket_ns;
+	Bucket &acc = level.acc;
+	bool flushed = false;
+
+	if (acc.count && acc.start != start) {
+		level.start[level.head] = acc.start;
+		level.min[level.head] = acc.min;
+		level.max[level.head] = acc.max;
+		level.mean[level.head] = (float)(acc.sum / acc.count);
+		level.head = (level.head + 1) % N;
+		if (level.count < N)
+			level.count++;
+
+		*closed = acc;
+		acc.count = 0;
+		flushed = true;
+	}
+
+	if (acc.count == 0) {
+		acc.start = start;
+		acc.min = in.min;
+		acc.max = in.max;
+		acc.sum = 0.0;
+	} else {
+		if (in.min < acc.min)
+			acc.min = in.min;
+		if (in.max > acc.max)
+			acc.max = in.max;
+	}
+	acc.sum += in.sum;
+	acc.count += in.count;
+	return flushed;
+}
+
+void SensorHistory::add(const SensorRecord *records, int count)
+{
+	for (int i = 0; i < count; i++) {
+		const SensorRecord &record = records[i];
+		if (record.channel < 0 || record.channel >= DataProvider::ChannelCount)
+			continue;
+		Channel &channel = channels[record.channel];
+
+		channel.raw_time[channel.raw_head] = record.timestamp_ns;
+		channel.raw_value[channel.raw_head] = record.value;
+		channel.raw_head = (channel.raw_head + 1) % RawCapacity;
+		if (channel.raw_count < RawCapacity)
+			channel.raw_count++;
+
+		/* A closed bucket cascades one level up */
+		Bucket sample = { record.timestamp_ns, record.value, record.value, record.value, 1 };
+		Bucket closed;
+		if (accumulate(channel.seconds, bucket_ns[Seconds], sample, &closed) &&
+		    accumulate(channel.minutes, bucket_ns[Minutes], closed, &closed))
+			accumulate(channel.hours, bucket_ns[Hours], closed, &closed);
+	}
+}
+
+template<int N> SensorHistory::View SensorHistory::view(const Rollup<N> &level)
+{
+	View v = { level.start, level.min, level.max, level.mean, N, level.head, level.count,
+		   level.acc.count ? &level.acc : NULL };
+	return v;
+}
+
+SensorHistory::View SensorHistory::view(const Channel &channel, int level) const
+{
+	switch (level) {
+	case Seconds:
+		return view(channel.seconds);
+	case Minutes:
+		return view(channel.minutes);
+	case Hours:
+		return view(channel.hours);
+	default: {
+		View v = { channel.raw_time, channel.raw_value, channel.raw_value, channel.raw_value,
+			   RawCapacity, channel.raw_head, channel.raw_count, NULL };
+		return v;
+	}
+	}
+}
+
+/* Ring position (0 = oldest) of the first entry at or after timestamp */
+int SensorHistory::lowerBound(const View &v, qint64 timestamp)
+{
+	int oldest = (int)((v.head + v.capacity - v.count) % v.capacity);
+	int lo = 0, hi = v.count;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (v.start[(oldest + mid) % v.capacity] < timestamp)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+int SensorHistory::size(int channel, Level level) const
+{
+	if (channel < 0 || channel >= DataProvider::ChannelCount)
+		return 0;
+	return view(channels[channel], level).count;
+}
+
+int SensorHistory::series(int channel, qint64 from_ns, qint64 to_ns, Point *out, int max_points) const
+{
+	if (channel < 0 || channel >= DataProvider::ChannelCount || max_points <= 0 || to_ns < from_ns)
+		return 0;
+
+	/* Finest level that reaches back far enough and stays cheap to read */
+	View v;
+	int first = 0, last = 0;
+	bool open = false;
+	for (int level = Raw; level < LevelCount; level++) {
+		v = view(channels[channel], level);
+		first = lowerBound(v, from_ns);
+		last = lowerBound(v, to_ns + 1);
+		open = v.open && v.open->start >= from_ns - bucket_ns[level] && v.open->start <= to_ns;
+
+		int oldest = (int)((v.head + v.capacity - v.count) % v.capacity);
+		bool covers = v.count < v.capacity || v.start[oldest] <= from_ns;
+		int n = last - first + open;
+		if (covers && n <= max_points * MAX_MERGE)
+			break;
+	}
+
+	int n = last - first + open;
+	if (n == 0)
+		return 0;
+	int merge = (n + max_points - 1) / max_points;
+
+	int oldest = (int)((v.head + v.capacity - v.count) % v.capacity);
+	int written = 0, grouped = 0;
+	double mean_sum = 0.0;
+	for (int i = 0; i < n; i++) {
+		qint64 start;
+		float min, max, mean;
+		if (first + i < last) {
+			int index = (oldest + first + i) % v.capacity;
+			start = v.start[index];
+			min = v.min[index];
+			max = v.max[index];
+			mean = v.mean[index];
+		} else {
+			start = v.open->start;
+			min = v.open->min;
+			max = v.open->max;
+			mean = (float)(v.open->sum / v.open->count);
+		}
+
+		Point &point = out[written];
+		if (grouped == 0) {
+			point.timestamp_ns = start;
+			point.min = min;
+			point.max = max;
+			mean_sum = 0.0;
+		} else {
+			if (min < point.min)
+				point.min = min;
+			if (max > point.max)
+				point.max = max;
+		}
+		mean_sum += mean;
+
+		/* Buckets of a level hold similar counts, so their means weigh equally */
+		if (++grouped == merge || i == n - 1) {
+			point.mean = (float)(mean_sum / grouped);
+			grouped = 0;
+			written++;
+		}
+	}
+	return written;
+}
@@ -0,0 +1,96 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include "sensor-feed.h"
+
+/*
+ * Bounded per-channel history: the newest raw samples plus min/max/mean
+ * rollups per second, minute and hour. Everything is a fixed-size ring
+ * with one array per field, so appends never allocate and a chart reads
+ * a few hundred precomputed buckets instead of rescanning raw samples.
+ * sizeof(SensorHistory) is the whole footprint (about 0.5 MB); create it
+ * once at startup and feed it from SensorFeed::samplesReady on the GUI
+ * thread.
+ */
+class SensorHistory
+{
+public:
+	enum Level { Raw, Seconds, Minutes, Hours, LevelCount };
+	enum {
+		RawCapacity = 4096,	/* 40 s at 100 Hz */
+		SecondCapacity = 3600,	/* 1 h */
+		MinuteCapacity = 1440,	/* 24 h */
+		HourCapacity = 720	/* 30 days */
+	};
+
+	struct Point {
+		qint64 timestamp_ns;	/* sample time, or bucket start */
+		float min, max, mean;
+	};
+
+	SensorHistory();
+
+	void add(const SensorRecord *records, int count);
+	void clear();
+
+	/*
+	 * Up to max_points points covering [from_ns, to_ns], oldest first.
+	 * Uses the finest level that still reaches back to from_ns, merging
+	 * neighbouring buckets so the result fits; the bucket still being
+	 * filled is included. Returns the number of points written.
+	 */
+	int series(int channel, qint64 from_ns, qint64 to_ns, Point *out, int max_points) const;
+
+	/* Stored entries per level, the open bucket not included */
+	int size(int channel, Level level) const;
+
+private:
+	struct Bucket {
+		qint64 start;
+		float min, max;
+		double sum;
+		qint64 count;	/* 0: empty */
+	};
+
+	/* One rollup level: closed buckets in the ring, the open one in acc */
+	template<int N> struct Rollup {
+		qint64 start[N];
+		float min[N];
+		float max[N];
+		float mean[N];
+		quint32 head;
+		int count;
+		Bucket acc;
+	};
+
+	struct Channel {
+		qint64 raw_time[RawCapacity];
+		float raw_value[RawCapacity];
+		quint32 raw_head;
+		int raw_count;
+
+		Rollup<SecondCapacity> seconds;
+		Rollup<MinuteCapacity> minutes;
+		Rollup<HourCapacity> hours;
+	};
+
+	/* Level-independent read access to one ring */
+	struct View {
+		const qint64 *start;
+		const float *min, *max, *mean;
+		int capacity;
+		quint32 head;
+		int count;
+		const Bucket *open;
+	};
+
+	template<int N> static bool accumulate(Rollup<N> &level, qint64 bucket_ns,
+			Bucket in, Bucket *closed);
+	template<int N> static View view(const Rollup<N> &level);
+	View view(const Channel &channel, int level) const;
+	static int lowerBound(const View &view, qint64 timestamp);
+
+	Channel channels[DataProvider::ChannelCount];
+};
+
+#endif /* SENSOR_HISTORY_H */
@@ -0,0 +1,330 @@
+#include <QDebug>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "sensor-log.h"
+
+#define SEGMENT_NAME "sensor-%06u.log"
+#define TICK_NS 100000
+
+/* Fixed-point steps: 0.01 degC, 0.1 hPa, 0.01 % */
+static const float channel_scale[DataProvider::ChannelCount] = { 100.0f, 10.0f, 100.0f };
+
+static quint8 recordCheck(const SensorLogRecord &record)
+{
+	const quint8 *bytes = (const quint8 *)&record;
+	quint8 sum = 0xA5;
+	for (size_t i = 0; i < sizeof(record); i++) {
+		if (&bytes[i] != &record.check)
+			sum = (quint8)(sum + bytes[i]);
+	}
+	return sum;
+}
+
+static qint64 clock_ns(clockid_t clock)
+{
+	struct timespec ts;
+	clock_gettime(clock, &ts);
+	return (qint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+SensorLog::SensorLog(const QString &dir, int max_segments, int sync_ms)
+	: dir(dir),
+	  max_segments(max_segments > 0 ? max_segments : 1),
+	  fd(-1),
+	  map(NULL),
+	  header(NULL),
+	  records(NULL),
+	  index(0),
+	  count(0),
+	  synced(0),
+	  open_failed(false)
+{
+	mkdir(dir.toLocal8Bit().constData(), 0755);
+	recover();
+
+	QObject::connect(&sync_timer, &QTimer::timeout, this, &SensorLog::sync);
+	sync_timer.start(sync_ms);
+}
+
+SensorLog::~SensorLog()
+{
+	closeSegment();
+}
+
+QByteArray SensorLog::segmentPath(quint32 segment, const char *suffix) const
+{
+	char name[32];
+	snprintf(name, sizeof(name), SEGMENT_NAME "%s", segment, suffix);
+	return (dir + '/' + name).toLocal8Bit();
+}
+
+quint32 SensorLogReader::validRecords(const SensorLogRecord *records, quint32 capacity, quint32 hint)
+{
+	quint32 n = hint <= capacity ? hint : 0;
+	while (n < capacity && records[n].channel != 0 &&
+	       records[n].channel <= DataProvider::ChannelCount &&
+	       records[n].check == recordCheck(records[n]))
+		n++;
+	return n;
+}
+
+/*
+ * Startup: drop half-created segments, and trim the newest one to its
+ * last valid record. It belongs to an earlier run (monotonic time has
+ * restarted), so it is sealed rather than resumed.
+ */
+void SensorLog::recover()
+{
+	QByteArray path = dir.toLocal8Bit();
+	DIR *d = opendir(path.constData());
+	if (!d)
+		return;
+
+	bool found = false;
+	quint32 newest = 0;
+	struct dirent *entry;
+	while ((entry = readdir(d)) != NULL) {
+		unsigned int segment;
+		char tail[8] = "";
+		if (sscanf(entry->d_name, "sensor-%6u.log%7s", &segment, tail) < 1)
+			continue;
+		if (strcmp(tail, ".tmp") == 0) {
+			unlink((path + '/' + entry->d_name).constData());
+		} else if (!tail[0] && (!found || segment > newest)) {
+			newest = segment;
+			found = true;
+		}
+	}
+	closedir(d);
+	if (!found)
+		return;
+	index = newest + 1;
+
+	int seg_fd = open(segmentPath(newest).constData(), O_RDWR | O_CLOEXEC);
+	if (seg_fd < 0)
+		return;
+
+	struct stat st;
+	if (fstat(seg_fd, &st) == 0 && st.st_size >= (off_t)sizeof(SensorLogHeader)) {
+		void *m = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, seg_fd, 0);
+		if (m != MAP_FAILED) {
+			const SensorLogHeader *h = (const SensorLogHeader *)m;
+			quint32 capacity = (st.st_size - sizeof(SensorLogHeader)) / sizeof(SensorLogRecord);
+			quint32 valid = 0;
+			if (memcmp(h->magic, "SENSLOG1", 8) == 0 && h->record_size == sizeof(SensorLogRecord))
+				valid = SensorLogReader::validRecords((const SensorLogRecord *)(h + 1), capacity, 0);
+			munmap(m, st.st_size);
+
+			off_t used = sizeof(SensorLogHeader) + (off_t)valid * sizeof(SensorLogRecord);
+			if (used < st.st_size && ftruncate(seg_fd, used) == 0)
+				fdatasync(seg_fd);
+		}
+	}
+	close(seg_fd);
+}
+
+/*
+ * Create the next segment under a temporary name, preallocate it, write
+ * and flush the header, then rename it into place. A crash at any point
+ * leaves either no segment or a complete, empty one.
+ */
+bool SensorLog::openSegment(qint64 first_ns)
+{
+	QByteArray tmp = segmentPath(index, ".tmp");
+	QByteArray path = segmentPath(index);
+
+	fd = open(tmp.constData(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		qWarning() << "Sensor log:" << tmp.constData() << strerror(errno);
+		return false;
+	}
+
+	int err = posix_fallocate(fd, 0, SegmentBytes);
+	if (err == EOPNOTSUPP || err == EINVAL)
+		err = ftruncate(fd, SegmentBytes) ? errno : 0;
+	if (err) {
+		qWarning() << "Sensor log: cannot reserve segment:" << strerror(err);
+		close(fd);
+		fd = -1;
+		unlink(tmp.constData());
+		return false;
+	}
+
+	void *m = mmap(NULL, SegmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (m == MAP_FAILED) {
+		close(fd);
+		fd = -1;
+		unlink(tmp.constData());
+		return false;
+	}
+
+	map = (unsigned char *)m;
+	header = (SensorLogHeader *)map;
+	records = (SensorLogRecord *)(header + 1);
+
+	memcpy(header->magic, "SENSLOG1", 8);
+	header->version = 1;
+	header->record_size = sizeof(SensorLogRecord);
+	header->base_ns = first_ns;
+	header->tick_ns = TICK_NS;
+	header->capacity = (SegmentBytes - sizeof(SensorLogHeader)) / sizeof(SensorLogRecord);
+	header->committed = 0;
+	header->reserved = 0;
+	for (int i = 0; i < 4; i++)
+		header->scale[i] = i < DataProvider::ChannelCount ? channel_scale[i] : 1.0f;
+	header->realtime_ns = clock_ns(CLOCK_REALTIME) - (clock_ns(CLOCK_MONOTONIC) - first_ns);
+
+	msync(map, sizeof(SensorLogHeader), MS_SYNC);
+	rename(tmp.constData(), path.constData());
+	int dir_fd = open(dir.toLocal8Bit().constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (dir_fd >= 0) {
+		fsync(dir_fd);
+		close(dir_fd);
+	}
+
+	index++;
+	count = 0;
+	synced = 0;
+	prune();
+	return true;
+}
+
+/* Flush, then trim the file to what was written so readers map only records */
+void SensorLog::closeSegment()
+{
+	if (!map)
+		return;
+
+	sync();
+	header->committed = count;
+	msync(map, sizeof(SensorLogHeader), MS_SYNC);
+	munmap(map, SegmentBytes);
+	map = NULL;
+	header = NULL;
+	records = NULL;
+
+	if (ftruncate(fd, sizeof(SensorLogHeader) + (off_t)count * sizeof(SensorLogRecord)) == 0)
+		fdatasync(fd);
+	close(fd);
+	fd = -1;
+}
+
+/* Keep the newest max_segments files, the one being written included */
+void SensorLog::prune()
+{
+	for (quint32 segment = index > (quint32)max_segments ? index - max_segments : 0; segment-- > 0;) {
+		if (unlink(segmentPath(segment).constData()) < 0 && errno == ENOENT)
+			break;
+	}
+}
+
+void SensorLog::append(int channel, const SensorSample *samples, int count_in)
+{
+	if (channel < 0 || channel >= DataProvider::ChannelCount || open_failed)
+		return;
+
+	for (int i = 0; i < count_in; i++) {
+		qint64 offset = map ? samples[i].timestamp_ns - header->base_ns : 0;
+		if (!map || count == header->capacity || offset / TICK_NS > 0xFFFFFFFFLL) {
+			closeSegment();
+			if (!openSegment(samples[i].timestamp_ns)) {
+				open_failed = true;
+				return;
+			}
+			offset = 0;
+		}
+
+		/* Samples of another device can be a batch older than the base */
+		float raw = roundf(samples[i].value * channel_scale[channel]);
+		SensorLogRecord record;
+		record.tick = offset > 0 ? (quint32)(offset / TICK_NS) : 0;
+		record.channel = (quint8)(channel + 1);
+		record.value = (qint16)(raw > 32767.0f ? 32767 : raw < -32768.0f ? -32768 : raw);
+		record.check = recordCheck(record);
+		records[count++] = record;
+	}
+}
+
+/* Write back the pages touched since the last call; runs on the log's thread */
+void SensorLog::sync()
+{
+	open_failed = false;
+	if (!map || synced == count)
+		return;
+
+	long page = sysconf(_SC_PAGESIZE);
+	size_t from = sizeof(SensorLogHeader) + (size_t)synced * sizeof(SensorLogRecord);
+	size_t to = sizeof(SensorLogHeader) + (size_t)count * sizeof(SensorLogRecord);
+	from &= ~(size_t)(page - 1);
+	msync(map + from, to - from, MS_SYNC);
+
+	synced = count;
+	header->committed = count;
+}
+
+SensorLogReader::SensorLogReader()
+	: map(NULL),
+	  size(0),
+	  hdr(NULL),
+	  data(NULL),
+	  nrecords(0)
+{
+}
+
+SensorLogReader::~SensorLogReader()
+{
+	close();
+}
+
+bool SensorLogReader::open(const char *path)
+{
+	close();
+
+	int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(SensorLogHeader)) {
+		::close(fd);
+		return false;
+	}
+
+	void *m = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (m == MAP_FAILED)
+		return false;
+
+	map = m;
+	size = st.st_size;
+	hdr = (const SensorLogHeader *)m;
+	if (memcmp(hdr->magic, "SENSLOG1", 8) != 0 || hdr->version != 1 ||
+	    hdr->record_size != sizeof(SensorLogRecord)) {
+		close();
+		return false;
+	}
+
+	data = (const SensorLogRecord *)(hdr + 1);
+	quint32 capacity = (size - sizeof(SensorLogHeader)) / sizeof(SensorLogRecord);
+	nrecords = (int)validRecords(data, capacity, hdr->committed);
+	return true;
+}
+
+void SensorLogReader::close()
+{
+	if (map)
+		munmap(map, size);
+	map = NULL;
+	size = 0;
+	hdr = NULL;
+	data = NULL;
+	nrecords = 0;
+}
@@ -0,0 +1,115 @@
+#ifndef SENSOR_LOG_H
+#define SENSOR_LOG_H
+
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include "data-provider.h"
+
+/*
+ * On-disk format. A segment is a preallocated file holding a 64-byte header
+ * followed by fixed 8-byte records. Unused space is zero, and a record
+ * whose check byte is wrong ends the segment, so writers never need to
+ * update a length field and a torn write after a crash is simply ignored.
+ */
+struct SensorLogHeader {
+	char magic[8];		/* "SENSLOG1" */
+	quint32 version;	/* 1 */
+	quint32 record_size;	/* sizeof(SensorLogRecord) */
+	qint64 base_ns;		/* CLOCK_MONOTONIC at tick 0 */
+	quint32 tick_ns;	/* record time unit */
+	quint32 capacity;	/* records that fit in the file */
+	quint32 committed;	/* records known to be on disk, a scan hint only */
+	quint32 reserved;
+	float scale[4];		/* value = raw / scale[channel] */
+	qint64 realtime_ns;	/* CLOCK_REALTIME at tick 0, monotonic time restarts at boot */
+};
+
+struct SensorLogRecord {
+	quint32 tick;		/* since base_ns */
+	quint8 channel;		/* DataProvider::Channel + 1, 0 marks free space */
+	quint8 check;
+	qint16 value;
+};
+
+/*
+ * Append-only recorder fed with samples on the acquisition thread. Records
+ * are stored straight into a shared mapping of the current segment, so the
+ * only syscalls are the periodic msync and the rotation. Segments are
+ * capped at SegmentBytes and at most max_segments are kept. All channels at
+ * 100 Hz fill a 16 MB segment in about 2 hours; at 1 Hz a segment closes
+ * when its 100 us tick counter runs out after 5 days, so the default 32
+ * segments keep months of data.
+ */
+class SensorLog: public QObject
+{
+	Q_OBJECT
+
+public:
+	enum { SegmentBytes = 16 << 20, DefaultSegments = 32, DefaultSyncMs = 10000 };
+
+	explicit SensorLog(const QString &dir, int max_segments = DefaultSegments,
+			int sync_ms = DefaultSyncMs);
+	~SensorLog();
+
+	void append(int channel, const SensorSample *samples, int count);
+
+public slots:
+	void sync();
+
+private:
+	bool openSegment(qint64 first_ns);
+	void closeSegment();
+	void recover();
+	void prune();
+	QByteArray segmentPath(quint32 segment, const char *suffix = "") const;
+
+	QString dir;
+	int max_segments;
+	QTimer sync_timer;
+
+	int fd;
+	unsigned char *map;
+	SensorLogHeader *header;
+	SensorLogRecord *records;
+	quint32 index;		/* of the next segment to create */
+	quint32 count;
+	quint32 synced;
+	bool open_failed;	/* skip appends until the next sync tick retries */
+};
+
+/* Zero-copy read access to one segment through a read-only mapping */
+class SensorLogReader
+{
+public:
+	SensorLogReader();
+	~SensorLogReader();
+
+	bool open(const char *path);
+	void close();
+
+	int count() const { return nrecords; }
+	const SensorLogRecord *records() const { return data; }
+	const SensorLogHeader *header() const { return hdr; }
+
+	int channel(const SensorLogRecord &record) const { return record.channel - 1; }
+	qint64 timestamp(const SensorLogRecord &record) const
+	{
+		return hdr->base_ns + (qint64)record.tick * hdr->tick_ns;
+	}
+	float value(const SensorLogRecord &record) const
+	{
+		return record.value / hdr->scale[record.channel - 1];
+	}
+
+	/* Number of leading valid records, used by the writer to resume a segment */
+	static quint32 validRecords(const SensorLogRecord *records, quint32 capacity, quint32 hint);
+
+private:
+	void *map;
+	size_t size;
+	const SensorLogHeader *hdr;
+	const SensorLogRecord *data;
+	int nrecords;
+};
+
+#endif /* SENSOR_LOG_H */